@@ -0,0 +1 @@
+# Dummy file
\ No newline at end of file
@@ -0,0 +1,34 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/Imath/ImathBVH.cpp" "src/Imath/CMakeFiles/Imath.dir/ImathBVH.cpp.o" "gcc" "src/Imath/CMakeFiles/Imath.dir/ImathBVH.cpp.o.d"
+  "/root/repo/src/Imath/ImathColorAlgo.cpp" "src/Imath/CMakeFiles/Imath.dir/ImathColorAlgo.cpp.o" "gcc" "src/Imath/CMakeFiles/Imath.dir/ImathColorAlgo.cpp.o.d"
+  "/root/repo/src/Imath/ImathColorAlgoBatch.cpp" "src/Imath/CMakeFiles/Imath.dir/ImathColorAlgoBatch.cpp.o" "gcc" "src/Imath/CMakeFiles/Imath.dir/ImathColorAlgoBatch.cpp.o.d"
+  "/root/repo/src/Imath/ImathFun.cpp" "src/Imath/CMakeFiles/Imath.dir/ImathFun.cpp.o" "gcc" "src/Imath/CMakeFiles/Imath.dir/ImathFun.cpp.o.d"
+  "/root/repo/src/Imath/ImathMatrixAlgo.cpp" "src/Imath/CMakeFiles/Imath.dir/ImathMatrixAlgo.cpp.o" "gcc" "src/Imath/CMakeFiles/Imath.dir/ImathMatrixAlgo.cpp.o.d"
+  "/root/repo/src/Imath/ImathMatrixAlgoBatch.cpp" "src/Imath/CMakeFiles/Imath.dir/ImathMatrixAlgoBatch.cpp.o" "gcc" "src/Imath/CMakeFiles/Imath.dir/ImathMatrixAlgoBatch.cpp.o.d"
+  "/root/repo/src/Imath/ImathRandom.cpp" "src/Imath/CMakeFiles/Imath.dir/ImathRandom.cpp.o" "gcc" "src/Imath/CMakeFiles/Imath.dir/ImathRandom.cpp.o.d"
+  "/root/repo/src/Imath/ImathVecArray.cpp" "src/Imath/CMakeFiles/Imath.dir/ImathVecArray.cpp.o" "gcc" "src/Imath/CMakeFiles/Imath.dir/ImathVecArray.cpp.o.d"
+  "/root/repo/src/Imath/half.cpp" "src/Imath/CMakeFiles/Imath.dir/half.cpp.o" "gcc" "src/Imath/CMakeFiles/Imath.dir/half.cpp.o.d"
+  )
+
+# Pairs of files generated by the same build rule.
+set(CMAKE_MULTIPLE_OUTPUT_PAIRS
+  "/root/repo/_native_build/src/Imath/libImath-3_2.so" "/root/repo/_native_build/src/Imath/libImath-3_2.so.29.0.0"
+  "/root/repo/_native_build/src/Imath/libImath-3_2.so.29" "/root/repo/_native_build/src/Imath/libImath-3_2.so.29.0.0"
+  )
+
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,29 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/Imath.dir/ImathBVH.cpp.o"
+  "CMakeFiles/Imath.dir/ImathBVH.cpp.o.d"
+  "CMakeFiles/Imath.dir/ImathColorAlgo.cpp.o"
+  "CMakeFiles/Imath.dir/ImathColorAlgo.cpp.o.d"
+  "CMakeFiles/Imath.dir/ImathColorAlgoBatch.cpp.o"
+  "CMakeFiles/Imath.dir/ImathColorAlgoBatch.cpp.o.d"
+  "CMakeFiles/Imath.dir/ImathFun.cpp.o"
+  "CMakeFiles/Imath.dir/ImathFun.cpp.o.d"
+  "CMakeFiles/Imath.dir/ImathMatrixAlgo.cpp.o"
+  "CMakeFiles/Imath.dir/ImathMatrixAlgo.cpp.o.d"
+  "CMakeFiles/Imath.dir/ImathMatrixAlgoBatch.cpp.o"
+  "CMakeFiles/Imath.dir/ImathMatrixAlgoBatch.cpp.o.d"
+  "CMakeFiles/Imath.dir/ImathRandom.cpp.o"
+  "CMakeFiles/Imath.dir/ImathRandom.cpp.o.d"
+  "CMakeFiles/Imath.dir/ImathVecArray.cpp.o"
+  "CMakeFiles/Imath.dir/ImathVecArray.cpp.o.d"
+  "CMakeFiles/Imath.dir/half.cpp.o"
+  "CMakeFiles/Imath.dir/half.cpp.o.d"
+  "libImath-3_2.pdb"
+  "libImath-3_2.so"
+  "libImath-3_2.so.29"
+  "libImath-3_2.so.29.0.0"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/Imath.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
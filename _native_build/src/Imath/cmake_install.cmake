@@ -0,0 +1,148 @@
+# Install script for directory: /root/repo/src/Imath
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/usr/local")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so.29.0.0"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so.29"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHECK
+           FILE "${file}"
+           RPATH "\$ORIGIN/../lib:/usr/local/lib")
+    endif()
+  endforeach()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES
+    "/root/repo/_native_build/src/Imath/libImath-3_2.so.29.0.0"
+    "/root/repo/_native_build/src/Imath/libImath-3_2.so.29"
+    )
+  foreach(file
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so.29.0.0"
+      "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so.29"
+      )
+    if(EXISTS "${file}" AND
+       NOT IS_SYMLINK "${file}")
+      file(RPATH_CHANGE
+           FILE "${file}"
+           OLD_RPATH "::::::::::::::::::::::::::::::"
+           NEW_RPATH "\$ORIGIN/../lib:/usr/local/lib")
+      if(CMAKE_INSTALL_DO_STRIP)
+        execute_process(COMMAND "/usr/bin/strip" "${file}")
+      endif()
+    endif()
+  endforeach()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so")
+    file(RPATH_CHECK
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so"
+         RPATH "\$ORIGIN/../lib:/usr/local/lib")
+  endif()
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE SHARED_LIBRARY FILES "/root/repo/_native_build/src/Imath/libImath-3_2.so")
+  if(EXISTS "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so" AND
+     NOT IS_SYMLINK "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so")
+    file(RPATH_CHANGE
+         FILE "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so"
+         OLD_RPATH "::::::::::::::::::::::::::::::"
+         NEW_RPATH "\$ORIGIN/../lib:/usr/local/lib")
+    if(CMAKE_INSTALL_DO_STRIP)
+      execute_process(COMMAND "/usr/bin/strip" "$ENV{DESTDIR}${CMAKE_INSTALL_PREFIX}/lib/libImath-3_2.so")
+    endif()
+  endif()
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/Imath" TYPE FILE FILES
+    "/root/repo/src/Imath/half.h"
+    "/root/repo/src/Imath/halfCurve.h"
+    "/root/repo/src/Imath/halfFunction.h"
+    "/root/repo/src/Imath/halfLimits.h"
+    "/root/repo/src/Imath/ImathBox.h"
+    "/root/repo/src/Imath/ImathBoxAlgo.h"
+    "/root/repo/src/Imath/ImathBVH.h"
+    "/root/repo/src/Imath/ImathColor.h"
+    "/root/repo/src/Imath/ImathColorAlgo.h"
+    "/root/repo/src/Imath/ImathDualQuat.h"
+    "/root/repo/src/Imath/ImathEuler.h"
+    "/root/repo/src/Imath/ImathExport.h"
+    "/root/repo/src/Imath/ImathForward.h"
+    "/root/repo/src/Imath/ImathFrame.h"
+    "/root/repo/src/Imath/ImathFrustum.h"
+    "/root/repo/src/Imath/ImathFrustumTest.h"
+    "/root/repo/src/Imath/ImathFun.h"
+    "/root/repo/src/Imath/ImathGL.h"
+    "/root/repo/src/Imath/ImathGLU.h"
+    "/root/repo/src/Imath/ImathInt64.h"
+    "/root/repo/src/Imath/ImathInterval.h"
+    "/root/repo/src/Imath/ImathLine.h"
+    "/root/repo/src/Imath/ImathLineAlgo.h"
+    "/root/repo/src/Imath/ImathMath.h"
+    "/root/repo/src/Imath/ImathMatrix.h"
+    "/root/repo/src/Imath/ImathMatrixAlgo.h"
+    "/root/repo/src/Imath/ImathNamespace.h"
+    "/root/repo/src/Imath/ImathPlane.h"
+    "/root/repo/src/Imath/ImathPlatform.h"
+    "/root/repo/src/Imath/ImathQuat.h"
+    "/root/repo/src/Imath/ImathRandom.h"
+    "/root/repo/src/Imath/ImathRoots.h"
+    "/root/repo/src/Imath/ImathShear.h"
+    "/root/repo/src/Imath/ImathSphere.h"
+    "/root/repo/src/Imath/ImathTypeTraits.h"
+    "/root/repo/src/Imath/ImathVec.h"
+    "/root/repo/src/Imath/ImathVecAlgo.h"
+    "/root/repo/src/Imath/ImathVecArray.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  execute_process(COMMAND /usr/bin/cmake -E chdir "$ENV{DESTDIR}/usr/local/lib" /usr/bin/cmake -E create_symlink libImath-3_2.so libImath.so)
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  message(STATUS "Creating symlink /usr/local/lib/libImath.so -> libImath-3_2.so")
+endif()
+
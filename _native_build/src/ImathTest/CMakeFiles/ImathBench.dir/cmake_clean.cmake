@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/ImathBench"
+  "../../bin/ImathBench.pdb"
+  "CMakeFiles/ImathBench.dir/bench.cpp.o"
+  "CMakeFiles/ImathBench.dir/bench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ImathBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,90 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/ImathTest
+# Build directory: /root/repo/_native_build/src/ImathTest
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(Imath.half_c_only "/root/repo/_native_build/bin/ImathHalfCTest")
+set_tests_properties(Imath.half_c_only PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;75;add_test;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testToFloat "/root/repo/_native_build/bin/ImathTest" "testToFloat")
+set_tests_properties(Imath.testToFloat PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testHalfArray "/root/repo/_native_build/bin/ImathTest" "testHalfArray")
+set_tests_properties(Imath.testHalfArray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testSize "/root/repo/_native_build/bin/ImathTest" "testSize")
+set_tests_properties(Imath.testSize PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testArithmetic "/root/repo/_native_build/bin/ImathTest" "testArithmetic")
+set_tests_properties(Imath.testArithmetic PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testNormalizedConversionError "/root/repo/_native_build/bin/ImathTest" "testNormalizedConversionError")
+set_tests_properties(Imath.testNormalizedConversionError PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testDenormalizedConversionError "/root/repo/_native_build/bin/ImathTest" "testDenormalizedConversionError")
+set_tests_properties(Imath.testDenormalizedConversionError PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testRoundingError "/root/repo/_native_build/bin/ImathTest" "testRoundingError")
+set_tests_properties(Imath.testRoundingError PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testBitPatterns "/root/repo/_native_build/bin/ImathTest" "testBitPatterns")
+set_tests_properties(Imath.testBitPatterns PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testClassification "/root/repo/_native_build/bin/ImathTest" "testClassification")
+set_tests_properties(Imath.testClassification PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testLimits "/root/repo/_native_build/bin/ImathTest" "testLimits")
+set_tests_properties(Imath.testLimits PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testHalfLimits "/root/repo/_native_build/bin/ImathTest" "testHalfLimits")
+set_tests_properties(Imath.testHalfLimits PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testFunction "/root/repo/_native_build/bin/ImathTest" "testFunction")
+set_tests_properties(Imath.testFunction PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testHalfCurve "/root/repo/_native_build/bin/ImathTest" "testHalfCurve")
+set_tests_properties(Imath.testHalfCurve PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testVec "/root/repo/_native_build/bin/ImathTest" "testVec")
+set_tests_properties(Imath.testVec PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testVecArray "/root/repo/_native_build/bin/ImathTest" "testVecArray")
+set_tests_properties(Imath.testVecArray PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testColor "/root/repo/_native_build/bin/ImathTest" "testColor")
+set_tests_properties(Imath.testColor PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testShear "/root/repo/_native_build/bin/ImathTest" "testShear")
+set_tests_properties(Imath.testShear PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testMatrix "/root/repo/_native_build/bin/ImathTest" "testMatrix")
+set_tests_properties(Imath.testMatrix PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testMiscMatrixAlgo "/root/repo/_native_build/bin/ImathTest" "testMiscMatrixAlgo")
+set_tests_properties(Imath.testMiscMatrixAlgo PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testRoots "/root/repo/_native_build/bin/ImathTest" "testRoots")
+set_tests_properties(Imath.testRoots PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testFun "/root/repo/_native_build/bin/ImathTest" "testFun")
+set_tests_properties(Imath.testFun PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testTrig "/root/repo/_native_build/bin/ImathTest" "testTrig")
+set_tests_properties(Imath.testTrig PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testInvert "/root/repo/_native_build/bin/ImathTest" "testInvert")
+set_tests_properties(Imath.testInvert PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testInterval "/root/repo/_native_build/bin/ImathTest" "testInterval")
+set_tests_properties(Imath.testInterval PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testFrustum "/root/repo/_native_build/bin/ImathTest" "testFrustum")
+set_tests_properties(Imath.testFrustum PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testRandom "/root/repo/_native_build/bin/ImathTest" "testRandom")
+set_tests_properties(Imath.testRandom PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testExtractEuler "/root/repo/_native_build/bin/ImathTest" "testExtractEuler")
+set_tests_properties(Imath.testExtractEuler PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testExtractSHRT "/root/repo/_native_build/bin/ImathTest" "testExtractSHRT")
+set_tests_properties(Imath.testExtractSHRT PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testQuat "/root/repo/_native_build/bin/ImathTest" "testQuat")
+set_tests_properties(Imath.testQuat PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testQuatSetRotation "/root/repo/_native_build/bin/ImathTest" "testQuatSetRotation")
+set_tests_properties(Imath.testQuatSetRotation PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testQuatSlerp "/root/repo/_native_build/bin/ImathTest" "testQuatSlerp")
+set_tests_properties(Imath.testQuatSlerp PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testDualQuat "/root/repo/_native_build/bin/ImathTest" "testDualQuat")
+set_tests_properties(Imath.testDualQuat PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testLineAlgo "/root/repo/_native_build/bin/ImathTest" "testLineAlgo")
+set_tests_properties(Imath.testLineAlgo PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testBoxAlgo "/root/repo/_native_build/bin/ImathTest" "testBoxAlgo")
+set_tests_properties(Imath.testBoxAlgo PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testBox "/root/repo/_native_build/bin/ImathTest" "testBox")
+set_tests_properties(Imath.testBox PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testBVH "/root/repo/_native_build/bin/ImathTest" "testBVH")
+set_tests_properties(Imath.testBVH PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testProcrustes "/root/repo/_native_build/bin/ImathTest" "testProcrustes")
+set_tests_properties(Imath.testProcrustes PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testTinySVD "/root/repo/_native_build/bin/ImathTest" "testTinySVD")
+set_tests_properties(Imath.testTinySVD PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testJacobiEigenSolver "/root/repo/_native_build/bin/ImathTest" "testJacobiEigenSolver")
+set_tests_properties(Imath.testJacobiEigenSolver PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testFrustumTest "/root/repo/_native_build/bin/ImathTest" "testFrustumTest")
+set_tests_properties(Imath.testFrustumTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
+add_test(Imath.testInterop "/root/repo/_native_build/bin/ImathTest" "testInterop")
+set_tests_properties(Imath.testInterop PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/ImathTest/CMakeLists.txt;93;add_test;/root/repo/src/ImathTest/CMakeLists.txt;97;define_imath_tests;/root/repo/src/ImathTest/CMakeLists.txt;0;")
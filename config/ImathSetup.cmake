@@ -17,6 +17,15 @@ option(IMATH_USE_DEFAULT_VISIBILITY "Makes the compile use default visibility (b
 # object (if you enable this) that contains a LUT of the function
 option(IMATH_ENABLE_LARGE_STACK "Enables code to take advantage of large stack support"     OFF)
 
+# Use hand-written SSE2/AVX or NEON code for Matrix44 multiplication.
+# This is baked into ImathConfig.h, so it applies to every program
+# compiled against this installation.
+option(IMATH_ENABLE_SIMD "Use SIMD intrinsics for Matrix44 multiplication" OFF)
+
+# Use the polynomial sine, cosine and arctangent approximations in the
+# array rotation functions. Also baked into ImathConfig.h.
+option(IMATH_USE_APPROX_TRIG "Use approximate trig functions in array rotation functions" OFF)
+
 # Option to make it possible to build without the noexcept specifier
 option(IMATH_USE_NOEXCEPT "Compile with noexcept specifier" ON)
 
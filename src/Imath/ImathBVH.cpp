@@ -0,0 +1,734 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+//
+// Implementation of the bounding volume hierarchy in ImathBVH.h
+//
+
+#include "ImathBVH.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_ENTER
+
+namespace
+{
+
+//
+// The number of bins per axis for the surface area heuristic.
+//
+
+const int bvhBins = 16;
+
+//
+// Below this depth, nodes are split at the median instead of by the
+// surface area heuristic. This bounds the depth of the tree by
+// bvhMaxSahDepth + 32, and so the size of the traversal stacks.
+//
+
+const int bvhMaxSahDepth = 64;
+const int bvhStackSize   = 128;
+
+//
+// Marks a node whose subtree is built by a separate task.
+//
+
+const uint32_t bvhPlaceholder = ~uint32_t (0);
+
+template <class T>
+T
+halfArea (const Vec3<T>& lo, const Vec3<T>& hi)
+{
+    Vec3<T> d = hi - lo;
+    return d.x * d.y + d.y * d.z + d.z * d.x;
+}
+
+template <class T>
+void
+extend (Vec3<T>& lo, Vec3<T>& hi, const Vec3<T>& bmin, const Vec3<T>& bmax)
+{
+    for (int i = 0; i < 3; ++i)
+    {
+        lo[i] = bmin[i] < lo[i] ? bmin[i] : lo[i];
+        hi[i] = bmax[i] > hi[i] ? bmax[i] : hi[i];
+    }
+}
+
+template <class T>
+T
+distance2 (const Box<Vec3<T>>& b, const Vec3<T>& p)
+{
+    T d2 = 0;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        T d = b.min[i] - p[i];
+        d   = p[i] - b.max[i] > d ? p[i] - b.max[i] : d;
+        d2 += d > 0 ? d * d : T (0);
+    }
+
+    return d2;
+}
+
+//
+// Slab test of the ray from `o` with reciprocal direction `invDir`
+// against `b`, restricted to distances in [0, tMax]. A ray that lies in
+// one of the box's bounding planes gives a NaN for that slab, which the
+// comparisons below ignore.
+//
+
+template <class T>
+bool
+slab (
+    const Box<Vec3<T>>& b,
+    const Vec3<T>&      o,
+    const Vec3<T>&      invDir,
+    T                   tMax,
+    T&                  tEntry)
+{
+    T t0 = 0;
+    T t1 = tMax;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        T tNear = (b.min[i] - o[i]) * invDir[i];
+        T tFar  = (b.max[i] - o[i]) * invDir[i];
+
+        if (tNear > tFar) std::swap (tNear, tFar);
+
+        t0 = tNear > t0 ? tNear : t0;
+        t1 = tFar < t1 ? tFar : t1;
+    }
+
+    tEntry = t0;
+    return t0 <= t1;
+}
+
+//
+// The builder works on copies of the primitives' boxes and centroids,
+// which it reorders along with the indices, so that every pass over a
+// node's primitives reads memory sequentially.
+//
+
+template <class T> struct BVHPrimitive
+{
+    Box<Vec3<T>> box;
+    Vec3<T>      centroid;
+    uint32_t     index;
+};
+
+template <class T> class BVHBuilder
+{
+public:
+    typedef typename BVH<T>::Node Node;
+    typedef BVHPrimitive<T>       Primitive;
+
+    struct Task
+    {
+        uint32_t          begin;
+        uint32_t          end;
+        int               depth;
+        std::vector<Node> nodes;
+    };
+
+    BVHBuilder (Primitive* prims, uint32_t maxLeafSize)
+        : _prims (prims), _maxLeafSize (maxLeafSize)
+    {}
+
+    //
+    // Build the subtree over _prims[begin, end) and append its nodes
+    // to `nodes`. If `tasks` is not null, subtrees over no more than
+    // `taskSize` primitives are not built, but replaced by placeholder
+    // nodes that refer to new entries in `tasks`.
+    //
+
+    void build (
+        uint32_t           begin,
+        uint32_t           end,
+        int                depth,
+        std::vector<Node>& nodes,
+        size_t             taskSize,
+        std::vector<Task>* tasks) const
+    {
+        size_t self = nodes.size ();
+        nodes.push_back (Node ());
+
+        Box<Vec3<T>> bounds;
+        Box<Vec3<T>> centroidBounds;
+
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            bounds.extendBy (_prims[i].box);
+            centroidBounds.extendBy (_prims[i].centroid);
+        }
+
+        nodes[self].bounds = bounds;
+
+        if (tasks && end - begin <= taskSize)
+        {
+            nodes[self].index = uint32_t (tasks->size ());
+            nodes[self].count = bvhPlaceholder;
+            tasks->push_back (Task ());
+            tasks->back ().begin = begin;
+            tasks->back ().end   = end;
+            tasks->back ().depth = depth;
+            return;
+        }
+
+        uint32_t mid = split (begin, end, depth, bounds, centroidBounds);
+
+        if (mid == begin)
+        {
+            nodes[self].index = begin;
+            nodes[self].count = end - begin;
+            return;
+        }
+
+        nodes[self].count = 0;
+        build (begin, mid, depth + 1, nodes, taskSize, tasks);
+        nodes[self].index = uint32_t (nodes.size ());
+        build (mid, end, depth + 1, nodes, taskSize, tasks);
+    }
+
+private:
+    //
+    // Partition _prims[begin, end) and return the start of the second
+    // half, or `begin` if the node should be a leaf.
+    //
+
+    uint32_t split (
+        uint32_t            begin,
+        uint32_t            end,
+        int                 depth,
+        const Box<Vec3<T>>& bounds,
+        const Box<Vec3<T>>& centroidBounds) const
+    {
+        uint32_t count = end - begin;
+
+        if (count <= 1) return begin;
+
+        Vec3<T> extent = centroidBounds.size ();
+        int     axis   = centroidBounds.majorAxis ();
+
+        if (!(extent[axis] > 0))
+        {
+            //
+            // All centroids coincide, so no plane separates them.
+            //
+
+            return count <= _maxLeafSize ? begin : begin + count / 2;
+        }
+
+        if (depth >= bvhMaxSahDepth) return median (begin, end, axis);
+
+        //
+        // Bin the centroids along all three axes in one pass, then
+        // sweep the bins from both ends to find the cheapest split.
+        // Small nodes use fewer bins, which keeps the fixed cost per
+        // node in proportion to its size.
+        //
+
+        const int numBins = count < uint32_t (bvhBins) ? int (count) : bvhBins;
+
+        Vec3<T>  scale;
+        Vec3<T>  binMin[3][bvhBins];
+        Vec3<T>  binMax[3][bvhBins];
+        uint32_t binCount[3][bvhBins];
+
+        for (int a = 0; a < 3; ++a)
+        {
+            scale[a] = extent[a] > 0 ? numBins / extent[a] : T (0);
+
+            for (int b = 0; b < numBins; ++b)
+            {
+                binMin[a][b]   = Vec3<T> (std::numeric_limits<T>::max ());
+                binMax[a][b]   = Vec3<T> (std::numeric_limits<T>::lowest ());
+                binCount[a][b] = 0;
+            }
+        }
+
+        for (uint32_t i = begin; i < end; ++i)
+        {
+            const Vec3<T>&      c   = _prims[i].centroid;
+            const Box<Vec3<T>>& box = _prims[i].box;
+
+            for (int a = 0; a < 3; ++a)
+            {
+                int b = bin (c[a], centroidBounds.min[a], scale[a], numBins);
+                binCount[a][b] += 1;
+                extend (binMin[a][b], binMax[a][b], box.min, box.max);
+            }
+        }
+
+        T   bestCost = std::numeric_limits<T>::max ();
+        int bestAxis = -1;
+        int bestBin  = 0;
+
+        for (int a = 0; a < 3; ++a)
+        {
+            if (!(extent[a] > 0)) continue;
+
+            T        rightCost[bvhBins];
+            Vec3<T>  lo (std::numeric_limits<T>::max ());
+            Vec3<T>  hi (std::numeric_limits<T>::lowest ());
+            uint32_t n = 0;
+
+            for (int b = numBins - 1; b > 0; --b)
+            {
+                extend (lo, hi, binMin[a][b], binMax[a][b]);
+                n += binCount[a][b];
+                rightCost[b] = n ? n * halfArea (lo, hi) : T (0);
+            }
+
+            lo = Vec3<T> (std::numeric_limits<T>::max ());
+            hi = Vec3<T> (std::numeric_limits<T>::lowest ());
+            n  = 0;
+
+            for (int b = 1; b < numBins; ++b)
+            {
+                extend (lo, hi, binMin[a][b - 1], binMax[a][b - 1]);
+                n += binCount[a][b - 1];
+
+                if (n == 0 || n == count) continue;
+
+                T cost = n * halfArea (lo, hi) + rightCost[b];
+
+                if (cost < bestCost)
+                {
+                    bestCost = cost;
+                    bestAxis = a;
+                    bestBin  = b;
+                }
+            }
+        }
+
+        if (bestAxis < 0) return median (begin, end, axis);
+
+        //
+        // With unit costs for a traversal step and a primitive test,
+        // a split pays off if 1 + cost / area(bounds) < count.
+        //
+
+        T area = halfArea (bounds.min, bounds.max);
+
+        if (count <= _maxLeafSize && !(area + bestCost < count * area))
+            return begin;
+
+        const T lo = centroidBounds.min[bestAxis];
+        const T s  = scale[bestAxis];
+
+        Primitive* mid = std::partition (
+            _prims + begin, _prims + end, [&] (const Primitive& p) {
+                return bin (p.centroid[bestAxis], lo, s, numBins) < bestBin;
+            });
+
+        return uint32_t (mid - _prims);
+    }
+
+    uint32_t median (uint32_t begin, uint32_t end, int axis) const
+    {
+        uint32_t mid = begin + (end - begin) / 2;
+
+        std::nth_element (
+            _prims + begin,
+            _prims + mid,
+            _prims + end,
+            [&] (const Primitive& a, const Primitive& b) {
+                return a.centroid[axis] < b.centroid[axis];
+            });
+
+        return mid;
+    }
+
+    static int bin (T c, T lo, T scale, int numBins)
+    {
+        // Written so that a NaN lands in bin 0 rather than in an
+        // undefined conversion.
+        T f = (c - lo) * scale;
+        return f >= numBins ? numBins - 1 : (f > 0 ? int (f) : 0);
+    }
+
+    Primitive* _prims;
+    uint32_t   _maxLeafSize;
+};
+
+//
+// Copy the tree below top[i] to `out` in depth-first order, replacing
+// the placeholders by the subtrees the tasks built.
+//
+
+template <class T>
+void
+splice (
+    const std::vector<typename BVH<T>::Node>&        top,
+    uint32_t                                         i,
+    const std::vector<typename BVHBuilder<T>::Task>& tasks,
+    std::vector<typename BVH<T>::Node>&              out)
+{
+    typedef typename BVH<T>::Node Node;
+
+    const Node& node = top[i];
+
+    if (node.count == bvhPlaceholder)
+    {
+        uint32_t base = uint32_t (out.size ());
+
+        for (Node n: tasks[node.index].nodes)
+        {
+            if (!n.isLeaf ()) n.index += base;
+            out.push_back (n);
+        }
+
+        return;
+    }
+
+    size_t self = out.size ();
+    out.push_back (node);
+
+    if (!node.isLeaf ())
+    {
+        splice<T> (top, i + 1, tasks, out);
+        out[self].index = uint32_t (out.size ());
+        splice<T> (top, node.index, tasks, out);
+    }
+}
+
+} // namespace
+
+template <class T>
+void
+BVH<T>::build (
+    const Box<Vec3<T>>* boxes,
+    size_t              numBoxes,
+    int                 maxLeafSize,
+    const Executor&     executor)
+{
+    if (numBoxes > size_t (std::numeric_limits<uint32_t>::max () - 1))
+        throw std::invalid_argument ("Too many boxes for a BVH.");
+
+    clear ();
+    _numPrimitives = numBoxes;
+
+    std::vector<BVHPrimitive<T>> prims;
+
+    for (size_t i = 0; i < numBoxes; ++i)
+    {
+        if (boxes[i].isEmpty ()) continue;
+
+        BVHPrimitive<T> p;
+        p.box      = boxes[i];
+        p.centroid = (boxes[i].min + boxes[i].max) / 2;
+        p.index    = uint32_t (i);
+        prims.push_back (p);
+    }
+
+    if (prims.empty ()) return;
+
+    uint32_t leafSize = maxLeafSize > 1 ? uint32_t (maxLeafSize) : 1;
+    uint32_t numPrims = uint32_t (prims.size ());
+
+    BVHBuilder<T> builder (prims.data (), leafSize);
+
+    if (!executor)
+    {
+        _nodes.reserve (2 * numPrims / leafSize + 1);
+        builder.build (0, numPrims, 0, _nodes, 0, nullptr);
+    }
+    else
+    {
+        //
+        // Build the top of the tree here, down to subtrees of about
+        // 1/128th of the primitives, then build those in parallel.
+        // The subtrees cover disjoint ranges of the primitives.
+        //
+
+        std::vector<Node>                         top;
+        std::vector<typename BVHBuilder<T>::Task> tasks;
+
+        size_t taskSize = std::max (size_t (numPrims / 128), size_t (4096));
+        builder.build (0, numPrims, 0, top, taskSize, &tasks);
+
+        executor (tasks.size (), [&] (size_t i) {
+            typename BVHBuilder<T>::Task& task = tasks[i];
+            builder.build (
+                task.begin, task.end, task.depth, task.nodes, 0, nullptr);
+        });
+
+        _nodes.reserve (2 * numPrims / leafSize + 1);
+        splice<T> (top, 0, tasks, _nodes);
+    }
+
+    _indices.resize (numPrims);
+    _boxes.resize (numPrims);
+
+    for (uint32_t i = 0; i < numPrims; ++i)
+    {
+        _indices[i] = prims[i].index;
+        _boxes[i]   = prims[i].box;
+    }
+}
+
+template <class T>
+void
+BVH<T>::clear () IMATH_NOEXCEPT
+{
+    _nodes.clear ();
+    _indices.clear ();
+    _boxes.clear ();
+    _numPrimitives = 0;
+}
+
+template <class T>
+size_t
+BVH<T>::intersect (const Line3<T>& ray, T& t, T tMax) const
+{
+    if (_nodes.empty ()) return npos;
+
+    const Vec3<T> invDir (
+        T (1) / ray.dir.x, T (1) / ray.dir.y, T (1) / ray.dir.z);
+
+    size_t   best  = npos;
+    T        bestT = tMax;
+    uint32_t stack[bvhStackSize];
+    T        stackT[bvhStackSize];
+    int      top = 0;
+
+    if (!slab (_nodes[0].bounds, ray.pos, invDir, bestT, stackT[0]))
+        return npos;
+
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        --top;
+
+        //
+        // The entry distance may exceed the best hit found since the
+        // node was pushed.
+        //
+
+        if (stackT[top] > bestT) continue;
+
+        uint32_t    n    = stack[top];
+        const Node& node = _nodes[n];
+
+        if (node.isLeaf ())
+        {
+            for (uint32_t k = node.index; k < node.index + node.count; ++k)
+            {
+                T tk;
+
+                if (!slab (_boxes[k], ray.pos, invDir, bestT, tk)) continue;
+
+                size_t i = _indices[k];
+
+                if (tk < bestT || (tk == bestT && i < best))
+                {
+                    best  = i;
+                    bestT = tk;
+                }
+            }
+
+            continue;
+        }
+
+        uint32_t c0 = n + 1;
+        uint32_t c1 = node.index;
+        T        t0, t1;
+        bool hit0 = slab (_nodes[c0].bounds, ray.pos, invDir, bestT, t0);
+        bool hit1 = slab (_nodes[c1].bounds, ray.pos, invDir, bestT, t1);
+
+        // Push the farther child first, so that the nearer one is
+        // visited first.
+
+        if (hit0 && hit1 && t1 < t0)
+        {
+            std::swap (c0, c1);
+            std::swap (t0, t1);
+        }
+
+        if (hit1)
+        {
+            stack[top]  = c1;
+            stackT[top] = t1;
+            ++top;
+        }
+
+        if (hit0)
+        {
+            stack[top]  = c0;
+            stackT[top] = t0;
+            ++top;
+        }
+    }
+
+    if (best != npos) t = bestT;
+
+    return best;
+}
+
+template <class T>
+size_t
+BVH<T>::intersectAll (
+    const Line3<T>& ray, std::vector<size_t>& hits, T tMax) const
+{
+    if (_nodes.empty ()) return 0;
+
+    const Vec3<T> invDir (
+        T (1) / ray.dir.x, T (1) / ray.dir.y, T (1) / ray.dir.z);
+
+    size_t   numHits = 0;
+    uint32_t stack[bvhStackSize];
+    int      top = 0;
+    T        t;
+
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        uint32_t    n    = stack[--top];
+        const Node& node = _nodes[n];
+
+        if (!slab (node.bounds, ray.pos, invDir, tMax, t)) continue;
+
+        if (node.isLeaf ())
+        {
+            for (uint32_t k = node.index; k < node.index + node.count; ++k)
+            {
+                if (slab (_boxes[k], ray.pos, invDir, tMax, t))
+                {
+                    hits.push_back (_indices[k]);
+                    ++numHits;
+                }
+            }
+        }
+        else
+        {
+            stack[top++] = node.index;
+            stack[top++] = n + 1;
+        }
+    }
+
+    return numHits;
+}
+
+template <class T>
+size_t
+BVH<T>::overlapping (
+    const Box<Vec3<T>>& box, std::vector<size_t>& result) const
+{
+    if (_nodes.empty ()) return 0;
+
+    size_t   numFound = 0;
+    uint32_t stack[bvhStackSize];
+    int      top = 0;
+
+    stack[top++] = 0;
+
+    while (top > 0)
+    {
+        uint32_t    n    = stack[--top];
+        const Node& node = _nodes[n];
+
+        if (!node.bounds.intersects (box)) continue;
+
+        if (node.isLeaf ())
+        {
+            for (uint32_t k = node.index; k < node.index + node.count; ++k)
+            {
+                if (_boxes[k].intersects (box))
+                {
+                    result.push_back (_indices[k]);
+                    ++numFound;
+                }
+            }
+        }
+        else
+        {
+            stack[top++] = node.index;
+            stack[top++] = n + 1;
+        }
+    }
+
+    return numFound;
+}
+
+template <class T>
+size_t
+BVH<T>::nearest (const Vec3<T>& p, T& distance) const
+{
+    if (_nodes.empty ()) return npos;
+
+    size_t   best   = npos;
+    T        bestD2 = std::numeric_limits<T>::infinity ();
+    uint32_t stack[bvhStackSize];
+    T        stackD2[bvhStackSize];
+    int      top = 0;
+
+    stack[top]   = 0;
+    stackD2[top] = distance2 (_nodes[0].bounds, p);
+    ++top;
+
+    while (top > 0)
+    {
+        --top;
+
+        if (stackD2[top] > bestD2) continue;
+
+        uint32_t    n    = stack[top];
+        const Node& node = _nodes[n];
+
+        if (node.isLeaf ())
+        {
+            for (uint32_t k = node.index; k < node.index + node.count; ++k)
+            {
+                T      d2 = distance2 (_boxes[k], p);
+                size_t i  = _indices[k];
+
+                if (d2 < bestD2 || (d2 == bestD2 && i < best))
+                {
+                    best   = i;
+                    bestD2 = d2;
+                }
+            }
+
+            continue;
+        }
+
+        uint32_t c0  = n + 1;
+        uint32_t c1  = node.index;
+        T        d20 = distance2 (_nodes[c0].bounds, p);
+        T        d21 = distance2 (_nodes[c1].bounds, p);
+
+        if (d21 < d20)
+        {
+            std::swap (c0, c1);
+            std::swap (d20, d21);
+        }
+
+        if (d21 <= bestD2)
+        {
+            stack[top]   = c1;
+            stackD2[top] = d21;
+            ++top;
+        }
+
+        if (d20 <= bestD2)
+        {
+            stack[top]   = c0;
+            stackD2[top] = d20;
+            ++top;
+        }
+    }
+
+    distance = std::sqrt (bestD2);
+    return best;
+}
+
+template class BVH<float>;
+template class BVH<double>;
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_EXIT
@@ -0,0 +1,218 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+//
+// A bounding volume hierarchy over axis-aligned boxes
+//
+
+#ifndef INCLUDED_IMATHBVH_H
+#define INCLUDED_IMATHBVH_H
+
+#include "ImathExport.h"
+#include "ImathNamespace.h"
+
+#include "ImathBox.h"
+#include "ImathLine.h"
+#include "ImathVec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
+
+///
+/// template class BVH<T>
+///
+/// A bounding volume hierarchy that accelerates ray, box-overlap and
+/// nearest-point queries against a large, static set of
+/// `Box<Vec3<T>>` primitives, for T = float or double.
+///
+/// The hierarchy is built top-down with the surface area heuristic
+/// (SAH), evaluated over a fixed number of bins along each axis. The
+/// nodes are stored in a single array in depth-first order, so that
+/// the first child of an interior node immediately follows it. A
+/// leaf refers to a contiguous range of primitives, whose boxes are
+/// copied into leaf order so that a leaf is tested without chasing
+/// pointers.
+///
+/// Primitives are identified by their index in the array passed to
+/// build(). Empty boxes are accepted, but are never reported by any
+/// query. Queries are const and may run concurrently.
+///
+/// The queries only test the primitives' boxes. To intersect the
+/// objects the boxes enclose, use intersectAll() or overlapping() to
+/// gather candidates and test those.
+///
+
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE BVH
+{
+public:
+    /// A node of the flattened hierarchy.
+    struct Node
+    {
+        /// The bounds of all primitives below this node.
+        Box<Vec3<T>> bounds;
+
+        /// For a leaf, the position of its first primitive in
+        /// primitiveIndices(). For an interior node, the index of its
+        /// second child; the first child is the next node.
+        uint32_t index;
+
+        /// The number of primitives in a leaf, or 0 for an interior
+        /// node.
+        uint32_t count;
+
+        /// Return true if the node is a leaf.
+        bool isLeaf () const IMATH_NOEXCEPT { return count != 0; }
+    };
+
+    /// A function that calls `task(i)` for every `i` in [0, n), in any
+    /// order and possibly concurrently, and returns once all calls
+    /// have completed. Use it to run the build on the caller's own
+    /// thread pool.
+    typedef std::function<void (
+        size_t n, const std::function<void (size_t i)>& task)>
+        Executor;
+
+    /// The value returned by queries that find no primitive.
+    static const size_t npos = ~size_t (0);
+
+    /// @{
+    /// @name Constructors
+
+    /// Initialize to an empty hierarchy.
+    BVH () : _numPrimitives (0) {}
+
+    /// Build the hierarchy over `numBoxes` boxes. See build().
+    BVH (
+        const Box<Vec3<T>>* boxes,
+        size_t              numBoxes,
+        int                 maxLeafSize = 4,
+        const Executor&     executor    = Executor ())
+        : _numPrimitives (0)
+    {
+        build (boxes, numBoxes, maxLeafSize, executor);
+    }
+
+    /// @}
+
+    /// @{
+    /// @name Building
+
+    /// Build the hierarchy over `numBoxes` boxes, replacing any
+    /// previous contents. The boxes are copied, so the array need not
+    /// outlive the call.
+    ///
+    /// Leaves hold at most `maxLeafSize` primitives. If an `executor`
+    /// is given, the upper levels of the tree are built on the calling
+    /// thread and the subtrees below them are handed to the executor.
+    /// The resulting hierarchy is the same with or without one.
+    ///
+    /// @throw std::invalid_argument If `numBoxes` does not fit in 32
+    /// bits.
+    IMATH_EXPORT void build (
+        const Box<Vec3<T>>* boxes,
+        size_t              numBoxes,
+        int                 maxLeafSize = 4,
+        const Executor&     executor    = Executor ());
+
+    /// Remove all primitives.
+    IMATH_EXPORT void clear () IMATH_NOEXCEPT;
+
+    /// @}
+
+    /// @{
+    /// @name Query
+
+    /// Find the primitive whose box the ray enters first. The ray
+    /// starts at `ray.pos` and extends along `ray.dir`; a box that
+    /// contains the start is entered at distance 0. Only boxes
+    /// entered at a distance no greater than `tMax` count as hits.
+    /// Ties go to the lowest index.
+    /// @param ray The ray, with a unit-length direction
+    /// @param[out] t The distance along the ray to the entry point,
+    /// if a primitive is hit
+    /// @param tMax The maximum distance
+    /// @return The index of the primitive hit, or `npos`
+    IMATH_EXPORT size_t intersect (
+        const Line3<T>& ray,
+        T&              t,
+        T               tMax = std::numeric_limits<T>::max ()) const;
+
+    /// Append the indices of all primitives whose boxes the ray
+    /// enters within distance `tMax` to `hits`, in no particular
+    /// order.
+    /// @return The number of indices appended
+    IMATH_EXPORT size_t intersectAll (
+        const Line3<T>&      ray,
+        std::vector<size_t>& hits,
+        T                    tMax = std::numeric_limits<T>::max ()) const;
+
+    /// Append the indices of all primitives whose boxes overlap `box`
+    /// to `result`, in no particular order. Boxes that only touch
+    /// count as overlapping, as in Box::intersects().
+    /// @return The number of indices appended
+    IMATH_EXPORT size_t
+    overlapping (const Box<Vec3<T>>& box, std::vector<size_t>& result) const;
+
+    /// Find the primitive whose box is closest to `p`. A box that
+    /// contains `p` is at distance 0. Ties go to the lowest index.
+    /// @param p The query point
+    /// @param[out] distance The distance from `p` to the box, if the
+    /// hierarchy is not empty
+    /// @return The index of the closest primitive, or `npos` if there
+    /// are none
+    IMATH_EXPORT size_t nearest (const Vec3<T>& p, T& distance) const;
+
+    /// @}
+
+    /// @{
+    /// @name Inspection
+
+    /// Return the number of boxes passed to build(), including empty
+    /// ones.
+    size_t numPrimitives () const IMATH_NOEXCEPT { return _numPrimitives; }
+
+    /// Return the number of nodes; 0 if there are no non-empty boxes.
+    size_t numNodes () const IMATH_NOEXCEPT { return _nodes.size (); }
+
+    /// Return the nodes. The root, if any, is the first.
+    const Node* nodes () const IMATH_NOEXCEPT { return _nodes.data (); }
+
+    /// Return the primitive indices referred to by the leaves.
+    const uint32_t* primitiveIndices () const IMATH_NOEXCEPT
+    {
+        return _indices.data ();
+    }
+
+    /// Return the bounds of all non-empty primitives.
+    Box<Vec3<T>> bounds () const IMATH_NOEXCEPT
+    {
+        return _nodes.empty () ? Box<Vec3<T>> () : _nodes[0].bounds;
+    }
+
+    /// @}
+
+private:
+    std::vector<Node>         _nodes;
+    std::vector<uint32_t>     _indices;
+    std::vector<Box<Vec3<T>>> _boxes; // primitive boxes, in leaf order
+    size_t                    _numPrimitives;
+};
+
+template <class T> const size_t BVH<T>::npos;
+
+/// BVH of type float
+typedef BVH<float> BVHf;
+
+/// BVH of type double
+typedef BVH<double> BVHd;
+
+IMATH_INTERNAL_NAMESPACE_HEADER_EXIT
+
+#endif // INCLUDED_IMATHBVH_H
@@ -16,6 +16,11 @@
 #include "ImathLineAlgo.h"
 #include "ImathMatrix.h"
 #include "ImathPlane.h"
+#include "ImathPlatform.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 
 IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
 
@@ -353,6 +358,346 @@ affineTransform (
     }
 }
 
+/// @cond Doxygen_Suppress
+
+//
+// One axis of Arvo's method: the range of output coordinate i over
+// the box [x0, x1] x [y0, y1] x [z0, z1]. The minimum and maximum of
+// each product are formed before any sums so that GCC can turn the
+// selects into vector min/max instead of branches.
+//
+
+template <class S, class T>
+IMATH_HOSTDEVICE inline void
+arvoAxis (
+    const Matrix44<T>& m,
+    int                i,
+    S                  x0,
+    S                  y0,
+    S                  z0,
+    S                  x1,
+    S                  y1,
+    S                  z1,
+    S&                 lo,
+    S&                 hi) IMATH_NOEXCEPT
+{
+    S a0 = (S) m[0][i] * x0, b0 = (S) m[0][i] * x1;
+    S a1 = (S) m[1][i] * y0, b1 = (S) m[1][i] * y1;
+    S a2 = (S) m[2][i] * z0, b2 = (S) m[2][i] * z1;
+
+    S lo0 = a0 < b0 ? a0 : b0, hi0 = a0 < b0 ? b0 : a0;
+    S lo1 = a1 < b1 ? a1 : b1, hi1 = a1 < b1 ? b1 : a1;
+    S lo2 = a2 < b2 ? a2 : b2, hi2 = a2 < b2 ? b2 : a2;
+
+    lo = (S) m[3][i] + lo0 + lo1 + lo2;
+    hi = (S) m[3][i] + hi0 + hi1 + hi2;
+}
+
+//
+// The array versions of transform() and affineTransform() work on
+// blocks of boxes copied into structure-of-arrays form, so that the
+// Arvo arithmetic vectorizes across boxes. The sums are formed in the
+// same order as in the single-box versions, so the results are
+// identical. Boxes that are empty or infinite, or whose matrix is
+// projective, are flagged and redone afterwards with the single-box
+// transform(). With `Broadcast`, every box uses m[0]; otherwise box
+// k uses m[k].
+//
+
+template <bool Broadcast, class S, class T>
+IMATH_HOSTDEVICE void
+transformBoxBlock (
+    const Box<Vec3<S>>* boxes,
+    const Matrix44<T>*  m,
+    Box<Vec3<S>>*       result,
+    int                 n,
+    bool                checkAffine) IMATH_NOEXCEPT
+{
+    const int B      = 32;
+    const S   lowest = std::numeric_limits<S>::lowest ();
+    const S   max    = std::numeric_limits<S>::max ();
+
+    S minX[B], minY[B], minZ[B], maxX[B], maxY[B], maxZ[B];
+    S special[B];
+
+    for (int k = 0; k < n; ++k)
+    {
+        minX[k] = boxes[k].min.x;
+        minY[k] = boxes[k].min.y;
+        minZ[k] = boxes[k].min.z;
+        maxX[k] = boxes[k].max.x;
+        maxY[k] = boxes[k].max.y;
+        maxZ[k] = boxes[k].max.z;
+    }
+
+    for (int k = 0; k < n; ++k)
+    {
+        const Matrix44<T>& mk = m[Broadcast ? 0 : k];
+
+        int64_t empty = 0;
+        empty |= maxX[k] < minX[k];
+        empty |= maxY[k] < minY[k];
+        empty |= maxZ[k] < minZ[k];
+
+        int64_t infinite = 1;
+        infinite &= minX[k] == lowest;
+        infinite &= minY[k] == lowest;
+        infinite &= minZ[k] == lowest;
+        infinite &= maxX[k] == max;
+        infinite &= maxY[k] == max;
+        infinite &= maxZ[k] == max;
+
+        int64_t projective = 0;
+        projective |= mk[0][3] != 0;
+        projective |= mk[1][3] != 0;
+        projective |= mk[2][3] != 0;
+        projective |= mk[3][3] != 1;
+
+        special[k] = (empty | infinite | (projective & checkAffine)) != 0
+                         ? S (1)
+                         : S (0);
+
+        S x0 = minX[k], y0 = minY[k], z0 = minZ[k];
+        S x1 = maxX[k], y1 = maxY[k], z1 = maxZ[k];
+
+        arvoAxis (mk, 0, x0, y0, z0, x1, y1, z1, minX[k], maxX[k]);
+        arvoAxis (mk, 1, x0, y0, z0, x1, y1, z1, minY[k], maxY[k]);
+        arvoAxis (mk, 2, x0, y0, z0, x1, y1, z1, minZ[k], maxZ[k]);
+    }
+
+    for (int k = 0; k < n; ++k)
+    {
+        if (special[k] != 0)
+        {
+            result[k] = transform (boxes[k], m[Broadcast ? 0 : k]);
+            continue;
+        }
+
+        result[k].min = Vec3<S> (minX[k], minY[k], minZ[k]);
+        result[k].max = Vec3<S> (maxX[k], maxY[k], maxZ[k]);
+    }
+}
+
+/// @endcond
+
+///
+/// Transform each of the `n` boxes in `boxes` by the corresponding
+/// matrix in `m`, and store in `result` the box that tightly encloses
+/// it, as transform() does for a single box. The results are
+/// identical to those of the single-box function, but the common case
+/// of a finite box and an affine matrix is computed several boxes at a
+/// time.
+///
+/// @param boxes The input boxes
+/// @param m The matrices, one per box
+/// @param[out] result The transformed boxes; may be the same array as
+/// `boxes`
+/// @param n The number of boxes
+///
+
+template <class S, class T>
+IMATH_HOSTDEVICE void
+transform (
+    const Box<Vec3<S>>* boxes,
+    const Matrix44<T>*  m,
+    Box<Vec3<S>>*       result,
+    size_t              n) IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; i += 32)
+    {
+        int count = int (n - i < 32 ? n - i : 32);
+        transformBoxBlock<false> (boxes + i, m + i, result + i, count, true);
+    }
+}
+
+///
+/// Transform each of the `n` boxes in `boxes` by the matrix `m`, and
+/// store in `result` the box that tightly encloses it, as transform()
+/// does for a single box. The test for an affine matrix is done once
+/// for the whole array.
+///
+/// @param boxes The input boxes
+/// @param m The matrix
+/// @param[out] result The transformed boxes; may be the same array as
+/// `boxes`
+/// @param n The number of boxes
+///
+
+template <class S, class T>
+IMATH_HOSTDEVICE void
+transform (
+    const Box<Vec3<S>>* boxes,
+    const Matrix44<T>&  m,
+    Box<Vec3<S>>*       result,
+    size_t              n) IMATH_NOEXCEPT
+{
+    if (m[0][3] != 0 || m[1][3] != 0 || m[2][3] != 0 || m[3][3] != 1)
+    {
+        for (size_t i = 0; i < n; ++i)
+            result[i] = transform (boxes[i], m);
+
+        return;
+    }
+
+    for (size_t i = 0; i < n; i += 32)
+    {
+        int count = int (n - i < 32 ? n - i : 32);
+        transformBoxBlock<true> (boxes + i, &m, result + i, count, false);
+    }
+}
+
+///
+/// Transform each of the `n` boxes in `boxes` by the corresponding
+/// matrix in `m`, as affineTransform() does for a single box. Every
+/// matrix must have `(0 0 0 1)` as its rightmost column. Empty and
+/// infinite boxes are copied unchanged.
+///
+/// @param boxes The input boxes
+/// @param m The matrices, one per box
+/// @param[out] result The transformed boxes; may be the same array as
+/// `boxes`
+/// @param n The number of boxes
+///
+
+template <class S, class T>
+IMATH_HOSTDEVICE void
+affineTransform (
+    const Box<Vec3<S>>* boxes,
+    const Matrix44<T>*  m,
+    Box<Vec3<S>>*       result,
+    size_t              n) IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; i += 32)
+    {
+        int count = int (n - i < 32 ? n - i : 32);
+        transformBoxBlock<false> (boxes + i, m + i, result + i, count, false);
+    }
+}
+
+///
+/// Transform each of the `n` boxes in `boxes` by the matrix `m`, as
+/// affineTransform() does for a single box. The rightmost column of
+/// `m` must be `(0 0 0 1)`. Empty and infinite boxes are copied
+/// unchanged.
+///
+/// @param boxes The input boxes
+/// @param m The matrix
+/// @param[out] result The transformed boxes; may be the same array as
+/// `boxes`
+/// @param n The number of boxes
+///
+
+template <class S, class T>
+IMATH_HOSTDEVICE void
+affineTransform (
+    const Box<Vec3<S>>* boxes,
+    const Matrix44<T>&  m,
+    Box<Vec3<S>>*       result,
+    size_t              n) IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; i += 32)
+    {
+        int count = int (n - i < 32 ? n - i : 32);
+        transformBoxBlock<true> (boxes + i, &m, result + i, count, false);
+    }
+}
+
+///
+/// @{
+/// @name Parallel Array Transforms
+///
+/// Versions of the array transform() and affineTransform() functions
+/// that split the work into tasks of a few thousand boxes and hand
+/// them to `executor`, which is called as `executor(numTasks, task)`
+/// and must call `task(i)` for every `i` in [0, numTasks), in any
+/// order and possibly concurrently, before returning; the same
+/// convention as BVH::Executor. Use it to run the transform on the
+/// caller's own thread pool. The results are the same as without an
+/// executor.
+///
+
+/// Transform `boxes[i]` by `m[i]`, using `executor` to run the tasks.
+template <class S, class T, class Executor>
+void
+transform (
+    const Box<Vec3<S>>* boxes,
+    const Matrix44<T>*  m,
+    Box<Vec3<S>>*       result,
+    size_t              n,
+    const Executor&     executor)
+{
+    const size_t grain = 4096;
+
+    executor ((n + grain - 1) / grain, [=] (size_t task) {
+        size_t begin = task * grain;
+        size_t count = n - begin < grain ? n - begin : grain;
+        transform (boxes + begin, m + begin, result + begin, count);
+    });
+}
+
+/// Transform `boxes[i]` by `m`, using `executor` to run the tasks.
+template <class S, class T, class Executor>
+void
+transform (
+    const Box<Vec3<S>>* boxes,
+    const Matrix44<T>&  m,
+    Box<Vec3<S>>*       result,
+    size_t              n,
+    const Executor&     executor)
+{
+    const size_t       grain = 4096;
+    const Matrix44<T>* mp    = &m;
+
+    executor ((n + grain - 1) / grain, [=] (size_t task) {
+        size_t begin = task * grain;
+        size_t count = n - begin < grain ? n - begin : grain;
+        transform (boxes + begin, *mp, result + begin, count);
+    });
+}
+
+/// Transform `boxes[i]` by the affine matrix `m[i]`, using `executor`
+/// to run the tasks.
+template <class S, class T, class Executor>
+void
+affineTransform (
+    const Box<Vec3<S>>* boxes,
+    const Matrix44<T>*  m,
+    Box<Vec3<S>>*       result,
+    size_t              n,
+    const Executor&     executor)
+{
+    const size_t grain = 4096;
+
+    executor ((n + grain - 1) / grain, [=] (size_t task) {
+        size_t begin = task * grain;
+        size_t count = n - begin < grain ? n - begin : grain;
+        affineTransform (boxes + begin, m + begin, result + begin, count);
+    });
+}
+
+/// Transform `boxes[i]` by the affine matrix `m`, using `executor` to
+/// run the tasks.
+template <class S, class T, class Executor>
+void
+affineTransform (
+    const Box<Vec3<S>>* boxes,
+    const Matrix44<T>&  m,
+    Box<Vec3<S>>*       result,
+    size_t              n,
+    const Executor&     executor)
+{
+    const size_t       grain = 4096;
+    const Matrix44<T>* mp    = &m;
+
+    executor ((n + grain - 1) / grain, [=] (size_t task) {
+        size_t begin = task * grain;
+        size_t count = n - begin < grain ? n - begin : grain;
+        affineTransform (boxes + begin, *mp, result + begin, count);
+    });
+}
+
+/// @}
+
 ///
 /// Compute the points where a ray, `r`, enters and exits a 3D box, `b`:
 ///
@@ -896,6 +1241,251 @@ intersects (const Box<Vec3<T>>& box, const Line3<T>& ray) IMATH_NOEXCEPT
     return intersects (box, ray, ignored);
 }
 
+///
+/// A packet of `N` rays, stored as structure-of-arrays with the
+/// reciprocals of the ray directions precomputed, for testing several
+/// rays against one box at once with `intersects()`. `N` may be at most
+/// 32; 4, 8 and 16 match common SIMD register widths.
+///
+
+template <class T, int N> struct RayPacket
+{
+    /// @{
+    /// @name The ray origins
+    T posX[N];
+    T posY[N];
+    T posZ[N];
+    /// @}
+
+    /// @{
+    /// @name The reciprocals of the ray directions
+    T invDirX[N];
+    T invDirY[N];
+    T invDirZ[N];
+    /// @}
+
+    /// Store `ray` in lane `i`.
+    IMATH_HOSTDEVICE void set (int i, const Line3<T>& ray) IMATH_NOEXCEPT
+    {
+        posX[i]    = ray.pos.x;
+        posY[i]    = ray.pos.y;
+        posZ[i]    = ray.pos.z;
+        invDirX[i] = T (1) / ray.dir.x;
+        invDirY[i] = T (1) / ray.dir.y;
+        invDirZ[i] = T (1) / ray.dir.z;
+    }
+};
+
+///
+/// A packet of `N` boxes, stored as structure-of-arrays, for testing one
+/// ray against several boxes at once with `intersects()`. `N` may be at
+/// most 32.
+///
+
+template <class T, int N> struct BoxPacket
+{
+    /// @{
+    /// @name The minimum corners
+    T minX[N];
+    T minY[N];
+    T minZ[N];
+    /// @}
+
+    /// @{
+    /// @name The maximum corners
+    T maxX[N];
+    T maxY[N];
+    T maxZ[N];
+    /// @}
+
+    /// Store `box` in lane `i`.
+    IMATH_HOSTDEVICE void set (int i, const Box<Vec3<T>>& box) IMATH_NOEXCEPT
+    {
+        minX[i] = box.min.x;
+        minY[i] = box.min.y;
+        minZ[i] = box.min.z;
+        maxX[i] = box.max.x;
+        maxY[i] = box.max.y;
+        maxZ[i] = box.max.z;
+    }
+};
+
+/// Packet of 4 rays of type float
+typedef RayPacket<float, 4> RayPacket4f;
+/// Packet of 8 rays of type float
+typedef RayPacket<float, 8> RayPacket8f;
+/// Packet of 16 rays of type float
+typedef RayPacket<float, 16> RayPacket16f;
+/// Packet of 4 rays of type double
+typedef RayPacket<double, 4> RayPacket4d;
+
+/// Packet of 4 boxes of type float
+typedef BoxPacket<float, 4> BoxPacket4f;
+/// Packet of 8 boxes of type float
+typedef BoxPacket<float, 8> BoxPacket8f;
+/// Packet of 4 boxes of type double
+typedef BoxPacket<double, 4> BoxPacket4d;
+
+/// @cond Doxygen_Suppress
+
+//
+// One axis of the slab test for N lanes, narrowing each lane's
+// [t0, t1] to the part of the ray between the slab's two planes. A
+// ray that lies in one of the planes gives a NaN, which the selects
+// ignore, so that it counts as inside the slab. Either the box bounds
+// or the ray origins are per lane; the other stride is 0.
+//
+
+template <class T, int N>
+IMATH_HOSTDEVICE inline void
+slabLanes (
+    const T* lo,
+    const T* hi,
+    int      boxStride,
+    const T* pos,
+    const T* invDir,
+    int      rayStride,
+    T*       t0,
+    T*       t1) IMATH_NOEXCEPT
+{
+    IMATH_NO_UNROLL
+    for (int i = 0; i < N; ++i)
+    {
+        T p    = pos[i * rayStride];
+        T inv  = invDir[i * rayStride];
+        T near = (lo[i * boxStride] - p) * inv;
+        T far  = (hi[i * boxStride] - p) * inv;
+        T a    = near > far ? far : near;
+        T b    = near > far ? near : far;
+        t0[i]  = a > t0[i] ? a : t0[i];
+        t1[i]  = b < t1[i] ? b : t1[i];
+    }
+}
+
+template <class T, int N>
+IMATH_HOSTDEVICE inline uint32_t
+slabMask (const T* t0, const T* t1, T* tEntry) IMATH_NOEXCEPT
+{
+    IMATH_NO_UNROLL
+    for (int i = 0; i < N; ++i)
+        tEntry[i] =
+            t0[i] <= t1[i] ? t0[i] : std::numeric_limits<T>::infinity ();
+
+    uint32_t mask = 0;
+
+    for (int i = 0; i < N; ++i)
+        mask |= uint32_t (t0[i] <= t1[i]) << i;
+
+    return mask;
+}
+
+/// @endcond
+
+///
+/// Intersect the rays in the packet `rays` with the 3D box `box`.
+///
+/// Each ray starts at its origin and extends to distance `tMax` along
+/// its direction, measured in units of the direction vector's length,
+/// which is 1 for rays stored from a `Line3`.
+///
+/// @param box The box
+/// @param rays The rays
+/// @param[out] tEntry For each ray that hits the box, the distance
+/// along it to the point where it enters the box, or 0 if it starts
+/// inside. For the other rays, infinity.
+/// @param tMax The length of the rays
+/// @return A mask with bit `i` set if ray `i` hits the box. The result
+/// is the same as `intersects(box, ray)` for each ray, except that
+/// rays which only graze an edge or face of the box may differ.
+///
+
+template <class T, int N>
+IMATH_HOSTDEVICE inline uint32_t
+intersects (
+    const Box<Vec3<T>>&    box,
+    const RayPacket<T, N>& rays,
+    T                      tEntry[N],
+    T tMax = std::numeric_limits<T>::max ()) IMATH_NOEXCEPT
+{
+    static_assert (N >= 1 && N <= 32, "RayPacket must hold 1 to 32 rays");
+
+    // Starting every lane with t0 > t1 makes an empty box miss.
+    T start = box.isEmpty () ? std::numeric_limits<T>::infinity () : T (0);
+    T t0[N], t1[N];
+
+    IMATH_NO_UNROLL
+    for (int i = 0; i < N; ++i)
+    {
+        t0[i] = start;
+        t1[i] = tMax;
+    }
+
+    slabLanes<T, N> (
+        &box.min.x, &box.max.x, 0, rays.posX, rays.invDirX, 1, t0, t1);
+    slabLanes<T, N> (
+        &box.min.y, &box.max.y, 0, rays.posY, rays.invDirY, 1, t0, t1);
+    slabLanes<T, N> (
+        &box.min.z, &box.max.z, 0, rays.posZ, rays.invDirZ, 1, t0, t1);
+
+    return slabMask<T, N> (t0, t1, tEntry);
+}
+
+///
+/// Intersect the ray `ray` with the boxes in the packet `boxes`.
+///
+/// The ray starts at `ray.pos` and extends to distance `tMax` along
+/// `ray.dir`.
+///
+/// @param boxes The boxes
+/// @param ray The ray
+/// @param[out] tEntry For each box that the ray hits, the distance
+/// along the ray to the point where it enters the box, or 0 if it
+/// starts inside. For the other boxes, infinity.
+/// @param tMax The length of the ray
+/// @return A mask with bit `i` set if the ray hits box `i`. Empty boxes
+/// are never hit. The result is the same as `intersects(box, ray)` for
+/// each box, except that a ray which only grazes an edge or face of a
+/// box may differ.
+///
+
+template <class T, int N>
+IMATH_HOSTDEVICE inline uint32_t
+intersects (
+    const BoxPacket<T, N>& boxes,
+    const Line3<T>&        ray,
+    T                      tEntry[N],
+    T tMax = std::numeric_limits<T>::max ()) IMATH_NOEXCEPT
+{
+    static_assert (N >= 1 && N <= 32, "BoxPacket must hold 1 to 32 boxes");
+
+    const T pos[3]    = {ray.pos.x, ray.pos.y, ray.pos.z};
+    const T invDir[3] = {
+        T (1) / ray.dir.x, T (1) / ray.dir.y, T (1) / ray.dir.z};
+
+    T t0[N], t1[N];
+
+    IMATH_NO_UNROLL
+    for (int i = 0; i < N; ++i)
+    {
+        // An empty box has max < min along some axis; starting such a
+        // lane with t0 > t1 makes it miss.
+        bool empty = (boxes.maxX[i] < boxes.minX[i]) |
+                     (boxes.maxY[i] < boxes.minY[i]) |
+                     (boxes.maxZ[i] < boxes.minZ[i]);
+        t0[i] = empty ? std::numeric_limits<T>::infinity () : T (0);
+        t1[i] = tMax;
+    }
+
+    slabLanes<T, N> (
+        boxes.minX, boxes.maxX, 1, &pos[0], &invDir[0], 0, t0, t1);
+    slabLanes<T, N> (
+        boxes.minY, boxes.maxY, 1, &pos[1], &invDir[1], 0, t0, t1);
+    slabLanes<T, N> (
+        boxes.minZ, boxes.maxZ, 1, &pos[2], &invDir[2], 0, t0, t1);
+
+    return slabMask<T, N> (t0, t1, tEntry);
+}
+
 IMATH_INTERNAL_NAMESPACE_HEADER_EXIT
 
 #endif // INCLUDED_IMATHBOXALGO_H
@@ -16,6 +16,8 @@
 #include "ImathColor.h"
 #include "ImathMath.h"
 
+#include <cstddef>
+
 IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
 
 //
@@ -157,6 +159,88 @@ IMATH_HOSTDEVICE IMATH_CONSTEXPR14 Color4<T>
     }
 }
 
+///
+/// @{
+/// @name Batch HSV Conversion
+///
+/// Convert the `n` colors of `src` between hsv and rgb, storing the
+/// results in `dst`, which may be the same array as `src`. Alpha is
+/// copied unchanged.
+///
+/// Unlike the functions above, these compute in float and without
+/// branches, so that the compiler can vectorize them; the results
+/// agree with those of hsv2rgb() and rgb2hsv() to within float
+/// rounding. Hue is expected to be in [0, 1].
+///
+
+/// Convert `n` hsv colors to rgb.
+IMATH_EXPORT void
+hsv2rgb (const C3f* src, C3f* dst, size_t n) IMATH_NOEXCEPT;
+
+/// Convert `n` hsv colors to rgb, with alpha.
+IMATH_EXPORT void
+hsv2rgb (const C4f* src, C4f* dst, size_t n) IMATH_NOEXCEPT;
+
+/// Convert `n` half hsv colors to rgb, with alpha.
+IMATH_EXPORT void
+hsv2rgb (const C4h* src, C4h* dst, size_t n) IMATH_NOEXCEPT;
+
+/// Convert `n` rgb colors to hsv.
+IMATH_EXPORT void
+rgb2hsv (const C3f* src, C3f* dst, size_t n) IMATH_NOEXCEPT;
+
+/// Convert `n` rgb colors to hsv, with alpha.
+IMATH_EXPORT void
+rgb2hsv (const C4f* src, C4f* dst, size_t n) IMATH_NOEXCEPT;
+
+/// Convert `n` half rgb colors to hsv, with alpha.
+IMATH_EXPORT void
+rgb2hsv (const C4h* src, C4h* dst, size_t n) IMATH_NOEXCEPT;
+
+/// @}
+
+///
+/// @{
+/// @name Parallel Batch HSV Conversion
+///
+/// Versions of the batch conversions above that split the work into
+/// tasks of 16384 colors and hand them to `executor`, which is called
+/// as `executor(numTasks, task)` and must call `task(i)` for every `i`
+/// in [0, numTasks), in any order and possibly concurrently, before
+/// returning; the same convention as BVH::Executor. The results are
+/// the same as without an executor.
+///
+
+/// Convert `n` hsv colors to rgb, using `executor` to run the tasks.
+template <class C, class Executor>
+void
+hsv2rgb (const C* src, C* dst, size_t n, const Executor& executor)
+{
+    const size_t grain = 16384;
+
+    executor ((n + grain - 1) / grain, [=] (size_t task) {
+        size_t begin = task * grain;
+        size_t count = n - begin < grain ? n - begin : grain;
+        hsv2rgb (src + begin, dst + begin, count);
+    });
+}
+
+/// Convert `n` rgb colors to hsv, using `executor` to run the tasks.
+template <class C, class Executor>
+void
+rgb2hsv (const C* src, C* dst, size_t n, const Executor& executor)
+{
+    const size_t grain = 16384;
+
+    executor ((n + grain - 1) / grain, [=] (size_t task) {
+        size_t begin = task * grain;
+        size_t count = n - begin < grain ? n - begin : grain;
+        rgb2hsv (src + begin, dst + begin, count);
+    });
+}
+
+/// @}
+
 ///
 /// Convert 3-channel rgb to PackedColor
 ///
@@ -261,6 +345,69 @@ packed2rgb (PackedColor packed, Color4<T>& out) IMATH_NOEXCEPT
     }
 }
 
+///
+/// Options for the batch rgb2packed() and packed2rgb() functions,
+/// combined with `|`.
+///
+
+enum IMATH_EXPORT_ENUM PackedColorFlags
+{
+    PACKED_RGBA   = 0, ///< Red in the low byte, as for rgb2packed()
+    PACKED_BGRA   = 1, ///< Blue in the low byte and red in the third
+    PACKED_SRGB   = 2, ///< Apply the sRGB transfer function to rgb
+    PACKED_DITHER = 4  ///< Quantize rgb with a 4x4 ordered dither
+};
+
+///
+/// @{
+/// @name Batch Packed Color Conversion
+///
+/// Convert between arrays of colors and 8-bit packed colors, such as
+/// framebuffer scanlines.
+///
+/// Unlike the single-color functions above, these clamp to [0, 1] and
+/// round to nearest, unless `PACKED_DITHER` is given. With
+/// `PACKED_SRGB`, rgb is linear and encoded with the sRGB transfer
+/// function when packing, and decoded when unpacking. Alpha is always
+/// linear and rounded.
+///
+
+/// Pack `n` colors. `x` and `y` are the image coordinates of `src[0]`,
+/// which select the dither thresholds; the colors are taken to be
+/// consecutive pixels of one scanline.
+IMATH_EXPORT void rgb2packed (
+    const C4f*   src,
+    PackedColor* dst,
+    size_t       n,
+    int          flags = PACKED_RGBA,
+    int          x     = 0,
+    int          y     = 0) IMATH_NOEXCEPT;
+
+/// Pack `n` half colors. See above.
+IMATH_EXPORT void rgb2packed (
+    const C4h*   src,
+    PackedColor* dst,
+    size_t       n,
+    int          flags = PACKED_RGBA,
+    int          x     = 0,
+    int          y     = 0) IMATH_NOEXCEPT;
+
+/// Unpack `n` colors. `PACKED_DITHER` is ignored.
+IMATH_EXPORT void packed2rgb (
+    const PackedColor* src,
+    C4f*               dst,
+    size_t             n,
+    int                flags = PACKED_RGBA) IMATH_NOEXCEPT;
+
+/// Unpack `n` colors to half. `PACKED_DITHER` is ignored.
+IMATH_EXPORT void packed2rgb (
+    const PackedColor* src,
+    C4h*               dst,
+    size_t             n,
+    int                flags = PACKED_RGBA) IMATH_NOEXCEPT;
+
+/// @}
+
 IMATH_INTERNAL_NAMESPACE_HEADER_EXIT
 
 #endif // INCLUDED_IMATHCOLORALGO_H
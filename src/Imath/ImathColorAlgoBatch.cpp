@@ -0,0 +1,521 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+///
+/// @file  ImathColorAlgoBatch.cpp
+///
+/// @brief The batch color conversions declared in ImathColorAlgo.h
+///
+
+#include "ImathColorAlgo.h"
+#include <algorithm>
+
+//
+// SSE2 is part of every x86-64 target, so the packed color kernels use
+// it whenever the compiler does, like the half conversions in half.cpp.
+//
+
+#if defined(__SSE2__) || defined(_M_X64) ||                                    \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <emmintrin.h>
+#    define IMATH_COLOR_SSE2
+#endif
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_ENTER
+
+namespace
+{
+
+//
+// The batch conversions copy blocks of colors into separate arrays of
+// channels, convert those in loops without branches that the compiler
+// can vectorize, and copy the results back.
+//
+
+const size_t block = 64;
+
+inline size_t
+blockSize (size_t n, size_t i)
+{
+    return n - i < block ? n - i : block;
+}
+
+//
+// The weight of the hsv chroma in one rgb channel, given the hue in
+// sextants, offset by 5, 3 or 1 for red, green and blue. Equivalent
+// to the switch in hsv2rgb_d() for hues in [0, 1].
+//
+
+inline float
+hsvWeight (float k)
+{
+    k       = k >= 6 ? k - 6 : k;
+    float w = std::min (k, 4 - k);
+    return w < 0 ? 0 : (w > 1 ? 1 : w);
+}
+
+void
+hsv2rgbBlock (float* x, float* y, float* z, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        float hue = x[i] * 6;
+        float val = z[i];
+        float c   = val * y[i];
+
+        x[i] = val - c * hsvWeight (hue + 5);
+        y[i] = val - c * hsvWeight (hue + 3);
+        z[i] = val - c * hsvWeight (hue + 1);
+    }
+}
+
+void
+rgb2hsvBlock (float* x, float* y, float* z, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        float r = x[i];
+        float g = y[i];
+        float b = z[i];
+
+        float max   = std::max (std::max (r, g), b);
+        float min   = std::min (std::min (r, g), b);
+        float range = max - min;
+        float sat   = max != 0 ? range / max : 0;
+
+        //
+        // The hue measured from the sextant of the largest channel,
+        // as in rgb2hsv_d(). The quotients in lanes whose saturation
+        // is zero are discarded.
+        //
+
+        float d   = r == max ? g - b : (g == max ? b - r : r - g);
+        float h   = r == max ? 0 : (g == max ? 2 : 4);
+        float hue = (h + d / range) * (1.0f / 6);
+
+        hue = hue < 0 ? hue + 1 : hue;
+
+        x[i] = sat != 0 ? hue : 0;
+        y[i] = sat;
+        z[i] = max;
+    }
+}
+
+typedef void (*BlockFunction) (float*, float*, float*, size_t);
+
+inline void
+copyAlpha (const C3f&, C3f&)
+{}
+
+inline void
+copyAlpha (const C4f& src, C4f& dst)
+{
+    dst.a = src.a;
+}
+
+template <class C>
+void
+convert (const C* src, C* dst, size_t n, BlockFunction f)
+{
+    float c[3][block];
+
+    for (size_t i = 0; i < n; i += block)
+    {
+        size_t m = blockSize (n, i);
+
+        for (size_t j = 0; j < m; ++j)
+        {
+            c[0][j] = src[i + j][0];
+            c[1][j] = src[i + j][1];
+            c[2][j] = src[i + j][2];
+        }
+
+        f (c[0], c[1], c[2], m);
+
+        for (size_t j = 0; j < m; ++j)
+        {
+            copyAlpha (src[i + j], dst[i + j]);
+            dst[i + j][0] = c[0][j];
+            dst[i + j][1] = c[1][j];
+            dst[i + j][2] = c[2][j];
+        }
+    }
+}
+
+//
+// Half colors are converted to float a block at a time with the bulk
+// half conversion functions.
+//
+
+void
+convert (const C4h* src, C4h* dst, size_t n, BlockFunction f)
+{
+    float              rgba[4 * block];
+    float              c[3][block];
+    imath_half_bits_t* out = reinterpret_cast<imath_half_bits_t*> (dst);
+
+    for (size_t i = 0; i < n; i += block)
+    {
+        size_t m = blockSize (n, i);
+
+        imath_half_to_float_array (
+            reinterpret_cast<const imath_half_bits_t*> (src + i),
+            rgba,
+            4 * m);
+
+        for (size_t j = 0; j < m; ++j)
+        {
+            c[0][j] = rgba[4 * j];
+            c[1][j] = rgba[4 * j + 1];
+            c[2][j] = rgba[4 * j + 2];
+        }
+
+        f (c[0], c[1], c[2], m);
+
+        for (size_t j = 0; j < m; ++j)
+        {
+            rgba[4 * j]     = c[0][j];
+            rgba[4 * j + 1] = c[1][j];
+            rgba[4 * j + 2] = c[2][j];
+        }
+
+        imath_float_to_half_array (rgba, out + 4 * i, 4 * m);
+    }
+}
+
+//
+// The sRGB transfer functions. Encoding is tabulated at 1024
+// intervals as the value at the start of each interval and the slope
+// across it, and interpolated linearly, which is within 0.1 of a
+// quantization step of the exact curve; the extra interval holds 1.
+// Decoding of 8-bit values is tabulated exactly.
+//
+
+struct SrgbTables
+{
+    static const int size = 1024;
+
+    struct Segment
+    {
+        float value;
+        float slope;
+    };
+
+    Segment encode[size + 1];
+    float   decode[256];
+
+    SrgbTables ()
+    {
+        for (int i = 0; i <= size; ++i)
+        {
+            encode[i].value = float (srgb (double (i) / size));
+            encode[i].slope = i < size ? float (srgb (double (i + 1) / size)) -
+                                             encode[i].value
+                                       : 0;
+        }
+
+        for (int i = 0; i < 256; ++i)
+        {
+            double c  = i / 255.0;
+            decode[i] = float (
+                c <= 0.04045 ? c / 12.92
+                             : std::pow ((c + 0.055) / 1.055, 2.4));
+        }
+    }
+
+    static double srgb (double c)
+    {
+        return c <= 0.0031308 ? 12.92 * c
+                              : 1.055 * std::pow (c, 1 / 2.4) - 0.055;
+    }
+};
+
+const SrgbTables&
+srgbTables ()
+{
+    static const SrgbTables tables;
+    return tables;
+}
+
+inline float
+clamp01 (float c)
+{
+    return c > 0 ? (c < 1 ? c : 1) : 0;
+}
+
+//
+// Encode the rgb of `m` rgba colors with the sRGB transfer function.
+//
+
+void
+encodeSrgb (const float* src, float* dst, size_t m)
+{
+    const SrgbTables::Segment* table = srgbTables ().encode;
+
+    for (size_t j = 0; j < m; ++j)
+    {
+        for (int k = 0; k < 3; ++k)
+        {
+            float t = clamp01 (src[4 * j + k]) * SrgbTables::size;
+            int   i = int (t);
+
+            dst[4 * j + k] = table[i].value + (t - i) * table[i].slope;
+        }
+
+        dst[4 * j + 3] = src[4 * j + 3];
+    }
+}
+
+//
+// The thresholds of a 4x4 ordered dither, in units of the
+// quantization step; 0.5 everywhere rounds to nearest.
+//
+
+const float bayer[4][4] = {
+    {0.5f / 16, 8.5f / 16, 2.5f / 16, 10.5f / 16},
+    {12.5f / 16, 4.5f / 16, 14.5f / 16, 6.5f / 16},
+    {3.5f / 16, 11.5f / 16, 1.5f / 16, 9.5f / 16},
+    {15.5f / 16, 7.5f / 16, 13.5f / 16, 5.5f / 16}};
+
+inline PackedColor
+quantize (float c, float threshold)
+{
+    return PackedColor (int (clamp01 (c) * 255 + threshold));
+}
+
+//
+// Pack `m` rgba colors, with the rgb thresholds in `d`. The SSE2
+// kernel converts one color per register and saturates four at a time
+// to bytes; its clamp also maps NaN to 0, like clamp01().
+//
+
+void
+packBlock (
+    const float* rgba, PackedColor* dst, size_t m, const float* d, int flags)
+{
+    size_t j = 0;
+
+#ifdef IMATH_COLOR_SSE2
+    const __m128 zero  = _mm_setzero_ps ();
+    const __m128 one   = _mm_set1_ps (1);
+    const __m128 scale = _mm_set1_ps (255);
+    __m128       t[4];
+
+    for (int k = 0; k < 4; ++k)
+        t[k] = _mm_setr_ps (d[k], d[k], d[k], 0.5f);
+
+    for (; j + 4 <= m; j += 4)
+    {
+        __m128i q[4];
+
+        for (int k = 0; k < 4; ++k)
+        {
+            __m128 c = _mm_loadu_ps (rgba + 4 * (j + k));
+
+            if (flags & PACKED_BGRA)
+                c = _mm_shuffle_ps (c, c, _MM_SHUFFLE (3, 0, 1, 2));
+
+            c    = _mm_min_ps (_mm_max_ps (c, zero), one);
+            q[k] = _mm_cvttps_epi32 (_mm_add_ps (_mm_mul_ps (c, scale), t[k]));
+        }
+
+        _mm_storeu_si128 (
+            reinterpret_cast<__m128i*> (dst + j),
+            _mm_packus_epi16 (
+                _mm_packs_epi32 (q[0], q[1]), _mm_packs_epi32 (q[2], q[3])));
+    }
+#endif
+
+    int rs = (flags & PACKED_BGRA) ? 16 : 0;
+    int bs = 16 - rs;
+
+    for (; j < m; ++j)
+    {
+        dst[j] = (quantize (rgba[4 * j], d[j]) << rs) |
+                 (quantize (rgba[4 * j + 1], d[j]) << 8) |
+                 (quantize (rgba[4 * j + 2], d[j]) << bs) |
+                 (quantize (rgba[4 * j + 3], 0.5f) << 24);
+    }
+}
+
+//
+// Pack `n` colors, each block of which `load` copies to rgba floats, or
+// returns a pointer to if they are already floats.
+//
+
+template <class Load>
+void
+pack (PackedColor* dst, size_t n, int flags, int x, int y, Load load)
+{
+    float rgba[4 * block];
+    float srgb[4 * block];
+    float d[block];
+
+    for (size_t j = 0; j < block; ++j)
+        d[j] = (flags & PACKED_DITHER) ? bayer[y & 3][(x + j) & 3] : 0.5f;
+
+    for (size_t i = 0; i < n; i += block)
+    {
+        size_t       m = blockSize (n, i);
+        const float* c = load (i, m, rgba);
+
+        if (flags & PACKED_SRGB)
+        {
+            encodeSrgb (c, srgb, m);
+            c = srgb;
+        }
+
+        packBlock (c, dst + i, m, d, flags);
+    }
+}
+
+//
+// Unpack `m` colors to rgba floats.
+//
+
+void
+unpackBlock (const PackedColor* src, float* rgba, size_t m, int flags)
+{
+    int         rs = (flags & PACKED_BGRA) ? 16 : 0;
+    int         bs = 16 - rs;
+    const float f  = 1.0f / 255.0f;
+
+    if (flags & PACKED_SRGB)
+    {
+        const float* table = srgbTables ().decode;
+
+        for (size_t j = 0; j < m; ++j)
+        {
+            rgba[4 * j]     = table[(src[j] >> rs) & 0xFF];
+            rgba[4 * j + 1] = table[(src[j] >> 8) & 0xFF];
+            rgba[4 * j + 2] = table[(src[j] >> bs) & 0xFF];
+            rgba[4 * j + 3] = (src[j] >> 24) * f;
+        }
+
+        return;
+    }
+
+    size_t j = 0;
+
+#ifdef IMATH_COLOR_SSE2
+    const __m128i zero  = _mm_setzero_si128 ();
+    const __m128  scale = _mm_set1_ps (f);
+
+    for (; j + 4 <= m; j += 4)
+    {
+        __m128i p =
+            _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + j));
+        __m128i h[2] = {
+            _mm_unpacklo_epi8 (p, zero), _mm_unpackhi_epi8 (p, zero)};
+
+        for (int k = 0; k < 4; ++k)
+        {
+            __m128i q = (k & 1) ? _mm_unpackhi_epi16 (h[k / 2], zero)
+                                : _mm_unpacklo_epi16 (h[k / 2], zero);
+            __m128  c = _mm_mul_ps (_mm_cvtepi32_ps (q), scale);
+
+            if (flags & PACKED_BGRA)
+                c = _mm_shuffle_ps (c, c, _MM_SHUFFLE (3, 0, 1, 2));
+
+            _mm_storeu_ps (rgba + 4 * (j + k), c);
+        }
+    }
+#endif
+
+    for (; j < m; ++j)
+    {
+        rgba[4 * j]     = ((src[j] >> rs) & 0xFF) * f;
+        rgba[4 * j + 1] = ((src[j] >> 8) & 0xFF) * f;
+        rgba[4 * j + 2] = ((src[j] >> bs) & 0xFF) * f;
+        rgba[4 * j + 3] = (src[j] >> 24) * f;
+    }
+}
+
+} // namespace
+
+void
+hsv2rgb (const C3f* src, C3f* dst, size_t n) IMATH_NOEXCEPT
+{
+    convert (src, dst, n, hsv2rgbBlock);
+}
+
+void
+hsv2rgb (const C4f* src, C4f* dst, size_t n) IMATH_NOEXCEPT
+{
+    convert (src, dst, n, hsv2rgbBlock);
+}
+
+void
+hsv2rgb (const C4h* src, C4h* dst, size_t n) IMATH_NOEXCEPT
+{
+    convert (src, dst, n, hsv2rgbBlock);
+}
+
+void
+rgb2hsv (const C3f* src, C3f* dst, size_t n) IMATH_NOEXCEPT
+{
+    convert (src, dst, n, rgb2hsvBlock);
+}
+
+void
+rgb2hsv (const C4f* src, C4f* dst, size_t n) IMATH_NOEXCEPT
+{
+    convert (src, dst, n, rgb2hsvBlock);
+}
+
+void
+rgb2hsv (const C4h* src, C4h* dst, size_t n) IMATH_NOEXCEPT
+{
+    convert (src, dst, n, rgb2hsvBlock);
+}
+
+void
+rgb2packed (
+    const C4f* src, PackedColor* dst, size_t n, int flags, int x, int y)
+    IMATH_NOEXCEPT
+{
+    pack (dst, n, flags, x, y, [src] (size_t i, size_t, float*) {
+        return &src[i].r;
+    });
+}
+
+void
+rgb2packed (
+    const C4h* src, PackedColor* dst, size_t n, int flags, int x, int y)
+    IMATH_NOEXCEPT
+{
+    pack (dst, n, flags, x, y, [src] (size_t i, size_t m, float* rgba) {
+        imath_half_to_float_array (
+            reinterpret_cast<const imath_half_bits_t*> (src + i),
+            rgba,
+            4 * m);
+        return static_cast<const float*> (rgba);
+    });
+}
+
+void
+packed2rgb (const PackedColor* src, C4f* dst, size_t n, int flags)
+    IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; i += block)
+        unpackBlock (src + i, &dst[i].r, blockSize (n, i), flags);
+}
+
+void
+packed2rgb (const PackedColor* src, C4h* dst, size_t n, int flags)
+    IMATH_NOEXCEPT
+{
+    float              rgba[4 * block];
+    imath_half_bits_t* out = reinterpret_cast<imath_half_bits_t*> (dst);
+
+    for (size_t i = 0; i < n; i += block)
+    {
+        size_t m = blockSize (n, i);
+        unpackBlock (src + i, rgba, m, flags);
+        imath_float_to_half_array (rgba, out + 4 * i, 4 * m);
+    }
+}
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_EXIT
@@ -0,0 +1,596 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+//
+// A dual quaternion, for rigid transforms and skinning
+//
+
+#ifndef INCLUDED_IMATHDUALQUAT_H
+#define INCLUDED_IMATHDUALQUAT_H
+
+#include "ImathExport.h"
+#include "ImathNamespace.h"
+
+#include "ImathMatrixAlgo.h"
+#include "ImathQuat.h"
+#include "ImathVec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
+
+///
+/// The DualQuat class represents a rigid transform, a rotation followed
+/// by a translation, as a dual quaternion `r + e d`. The real part `r`
+/// is the unit rotation quaternion, and the dual part `d` is
+/// `0.5 * t * r`, `t` being the translation as a pure quaternion.
+///
+/// A point `p` is transformed to `r.rotateVector(p) + t`, which is
+/// `p * m` for the matrix `m = r.toMatrix44()` with `t` as its
+/// translation row. Like Quat, the product `b * a` applies `a` first,
+/// so it corresponds to the matrix product `ma * mb`.
+///
+/// A DualQuat takes half the memory of a Matrix44, and a weighted
+/// sum of dual quaternions blends rigid transforms without the
+/// shrinking of blended matrices, which makes it the usual choice for
+/// skinning. See skin() and blend().
+///
+
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE DualQuat
+{
+public:
+    /// @{
+    /// @name Direct access to elements
+
+    /// The real part, the rotation
+    Quat<T> r;
+
+    /// The dual part, half the translation times the rotation
+    Quat<T> d;
+
+    /// @}
+
+    /// @{
+    ///	@name Constructors
+
+    /// Default constructor is the identity transform
+    IMATH_HOSTDEVICE constexpr DualQuat () IMATH_NOEXCEPT;
+
+    /// Construct from a quaternion of another base type
+    template <class S>
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14
+    DualQuat (const DualQuat<S>& dq) IMATH_NOEXCEPT;
+
+    /// Initialize with real part `real` and dual part `dual`
+    IMATH_HOSTDEVICE constexpr DualQuat (
+        const Quat<T>& real, const Quat<T>& dual) IMATH_NOEXCEPT;
+
+    /// Initialize to the rotation `rotation`, which must be normalized,
+    /// followed by the translation `translation`.
+    IMATH_HOSTDEVICE constexpr DualQuat (
+        const Quat<T>& rotation, const Vec3<T>& translation) IMATH_NOEXCEPT;
+
+    /// The identity transform
+    IMATH_HOSTDEVICE constexpr static DualQuat<T> identity () IMATH_NOEXCEPT;
+
+    /// @}
+
+    /// @{
+    /// @name Basic Algebra
+    ///
+    /// Note that the operator return values are *NOT* normalized
+    //
+
+    /// Dual quaternion multiplication
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 const DualQuat<T>&
+    operator*= (const DualQuat<T>& dq) IMATH_NOEXCEPT;
+
+    /// Scalar multiplication: multiply both parts by the given scalar.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 const DualQuat<T>&
+    operator*= (T t) IMATH_NOEXCEPT;
+
+    /// Dual quaternion addition
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 const DualQuat<T>&
+    operator+= (const DualQuat<T>& dq) IMATH_NOEXCEPT;
+
+    /// Equality
+    template <class S>
+    IMATH_HOSTDEVICE constexpr bool
+    operator== (const DualQuat<S>& dq) const IMATH_NOEXCEPT;
+
+    /// Inequality
+    template <class S>
+    IMATH_HOSTDEVICE constexpr bool
+    operator!= (const DualQuat<S>& dq) const IMATH_NOEXCEPT;
+
+    /// @}
+
+    /// @{
+    /// @name Query
+
+    /// Return the rotation, the real part.
+    IMATH_HOSTDEVICE constexpr Quat<T> rotation () const IMATH_NOEXCEPT;
+
+    /// Return the translation. Assumes the dual quaternion is
+    /// normalized.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 Vec3<T>
+    translation () const IMATH_NOEXCEPT;
+
+    /// Return the 4x4 matrix of the transform, a rotation matrix with
+    /// the translation in its last row. Assumes the dual quaternion is
+    /// normalized.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 Matrix44<T>
+    toMatrix44 () const IMATH_NOEXCEPT;
+
+    /// @}
+
+    /// @{
+    /// @name Utility Methods
+
+    /// Normalize in place, dividing both parts by the length of the
+    /// real part.
+    /// @return const reference to this.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 DualQuat<T>& normalize () IMATH_NOEXCEPT;
+
+    /// Return a normalized dual quaternion, leaving this unmodified.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 DualQuat<T>
+    normalized () const IMATH_NOEXCEPT;
+
+    /// Invert in place. Assumes the dual quaternion is normalized.
+    /// @return const reference to this.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 DualQuat<T>& invert () IMATH_NOEXCEPT;
+
+    /// Return the inverse transform, leaving this unchanged. Assumes
+    /// the dual quaternion is normalized.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 DualQuat<T>
+    inverse () const IMATH_NOEXCEPT;
+
+    /// Transform the point `p`: rotate it, then translate it. The dual
+    /// quaternion need not be normalized.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 Vec3<T>
+    transformPoint (const Vec3<T>& p) const IMATH_NOEXCEPT;
+
+    /// Rotate the direction `v`, ignoring the translation. The dual
+    /// quaternion need not be normalized.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 Vec3<T>
+    transformDirection (const Vec3<T>& v) const IMATH_NOEXCEPT;
+
+    /// @}
+
+    /// The base type: In templates that accept a parameter `V`, you
+    /// can refer to `T` as `V::BaseType`
+    typedef T BaseType;
+};
+
+/// Dual quaternion multiplication: `dq1 * dq2` applies `dq2` first.
+template <class T>
+IMATH_HOSTDEVICE constexpr DualQuat<T>
+operator* (const DualQuat<T>& dq1, const DualQuat<T>& dq2) IMATH_NOEXCEPT;
+
+template <class T>
+IMATH_HOSTDEVICE constexpr DualQuat<T>
+operator* (const DualQuat<T>& dq, T t) IMATH_NOEXCEPT;
+
+template <class T>
+IMATH_HOSTDEVICE constexpr DualQuat<T>
+operator* (T t, const DualQuat<T>& dq) IMATH_NOEXCEPT;
+
+template <class T>
+IMATH_HOSTDEVICE constexpr DualQuat<T>
+operator+ (const DualQuat<T>& dq1, const DualQuat<T>& dq2) IMATH_NOEXCEPT;
+
+template <class T>
+IMATH_HOSTDEVICE constexpr DualQuat<T>
+operator- (const DualQuat<T>& dq) IMATH_NOEXCEPT;
+
+template <class T>
+std::ostream& operator<< (std::ostream& o, const DualQuat<T>& dq);
+
+/// Return the dual quaternion of the rotation and translation of the
+/// matrix `mat`. Any scaling and shear are removed first, as by
+/// extractSHRT(), and any projection is ignored.
+template <class T>
+DualQuat<T> extractDualQuat (const Matrix44<T>& mat) IMATH_NOEXCEPT;
+
+/// Return the normalized weighted sum of `n` dual quaternions, each
+/// negated if needed to lie in the same hemisphere as the first.
+/// This is dual quaternion linear blending. The weights need not sum
+/// to 1, but must not cancel out.
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 DualQuat<T> blend (
+    const DualQuat<T>* dqs, const T* weights, size_t n) IMATH_NOEXCEPT;
+
+/// Skin `n` vertices by dual quaternion linear blending.
+///
+/// Vertex `i` is influenced by the `influences` bones
+/// `bones[boneIndices[i * influences + k]]`, with weights
+/// `weights[i * influences + k]`, for `k` in [0, influences). Unused
+/// influences should have weight 0. The blended transform is applied
+/// to `positions[i]`, and its rotation to `normals[i]`, without
+/// normalizing either the blend or the result. If `influences` is 0,
+/// the vertices are copied unchanged.
+///
+/// @param bones The bone transforms, as normalized dual quaternions
+/// @param boneIndices `n * influences` indices into `bones`
+/// @param weights `n * influences` weights
+/// @param influences The number of bones per vertex, or 0
+/// @param positions The rest positions
+/// @param[out] skinnedPositions The skinned positions; may be the same
+/// array as `positions`
+/// @param n The number of vertices
+template <class T>
+IMATH_HOSTDEVICE void skin (
+    const DualQuat<T>* bones,
+    const uint32_t*    boneIndices,
+    const T*           weights,
+    int                influences,
+    const Vec3<T>*     positions,
+    Vec3<T>*           skinnedPositions,
+    size_t             n) IMATH_NOEXCEPT;
+
+/// Skin `n` vertices and their normals, as above. The skinned normals
+/// are not renormalized.
+template <class T>
+IMATH_HOSTDEVICE void skin (
+    const DualQuat<T>* bones,
+    const uint32_t*    boneIndices,
+    const T*           weights,
+    int                influences,
+    const Vec3<T>*     positions,
+    const Vec3<T>*     normals,
+    Vec3<T>*           skinnedPositions,
+    Vec3<T>*           skinnedNormals,
+    size_t             n) IMATH_NOEXCEPT;
+
+/// Dual quaternion of type float
+typedef DualQuat<float> DualQuatf;
+
+/// Dual quaternion of type double
+typedef DualQuat<double> DualQuatd;
+
+//---------------
+// Implementation
+//---------------
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline DualQuat<T>::DualQuat () IMATH_NOEXCEPT
+    : r (),
+      d (0, 0, 0, 0)
+{
+    // empty
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline DualQuat<T>::DualQuat (
+    const DualQuat<S>& dq) IMATH_NOEXCEPT : r (dq.r),
+                                            d (dq.d)
+{
+    // empty
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline DualQuat<T>::DualQuat (
+    const Quat<T>& real, const Quat<T>& dual) IMATH_NOEXCEPT : r (real),
+                                                               d (dual)
+{
+    // empty
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline DualQuat<T>::DualQuat (
+    const Quat<T>& rotation, const Vec3<T>& translation) IMATH_NOEXCEPT
+    : r (rotation),
+      d (Quat<T> (0, translation * T (0.5)) * rotation)
+{
+    // empty
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline DualQuat<T>
+DualQuat<T>::identity () IMATH_NOEXCEPT
+{
+    return DualQuat<T> ();
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const DualQuat<T>&
+DualQuat<T>::operator*= (const DualQuat<T>& dq) IMATH_NOEXCEPT
+{
+    *this = *this * dq;
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const DualQuat<T>&
+DualQuat<T>::operator*= (T t) IMATH_NOEXCEPT
+{
+    r *= t;
+    d *= t;
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const DualQuat<T>&
+DualQuat<T>::operator+= (const DualQuat<T>& dq) IMATH_NOEXCEPT
+{
+    r += dq.r;
+    d += dq.d;
+    return *this;
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE constexpr inline bool
+DualQuat<T>::operator== (const DualQuat<S>& dq) const IMATH_NOEXCEPT
+{
+    return r == dq.r && d == dq.d;
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE constexpr inline bool
+DualQuat<T>::operator!= (const DualQuat<S>& dq) const IMATH_NOEXCEPT
+{
+    return r != dq.r || d != dq.d;
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Quat<T>
+DualQuat<T>::rotation () const IMATH_NOEXCEPT
+{
+    return r;
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Vec3<T>
+DualQuat<T>::translation () const IMATH_NOEXCEPT
+{
+    //
+    // t = 2 d r*
+    //
+
+    return T (2) * (r.r * d.v - d.r * r.v + (r.v % d.v));
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Matrix44<T>
+DualQuat<T>::toMatrix44 () const IMATH_NOEXCEPT
+{
+    Matrix44<T> m = r.toMatrix44 ();
+    Vec3<T>     t = translation ();
+
+    m[3][0] = t.x;
+    m[3][1] = t.y;
+    m[3][2] = t.z;
+    return m;
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline DualQuat<T>&
+DualQuat<T>::normalize () IMATH_NOEXCEPT
+{
+    if (T l = r.length ())
+    {
+        r /= l;
+        d /= l;
+    }
+    else
+    {
+        r = Quat<T> ();
+        d = Quat<T> (0, 0, 0, 0);
+    }
+
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline DualQuat<T>
+DualQuat<T>::normalized () const IMATH_NOEXCEPT
+{
+    return DualQuat<T> (*this).normalize ();
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline DualQuat<T>&
+DualQuat<T>::invert () IMATH_NOEXCEPT
+{
+    r = ~r;
+    d = ~d;
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline DualQuat<T>
+DualQuat<T>::inverse () const IMATH_NOEXCEPT
+{
+    return DualQuat<T> (~r, ~d);
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Vec3<T>
+DualQuat<T>::transformPoint (const Vec3<T>& p) const IMATH_NOEXCEPT
+{
+    //
+    // The rotation r p r* and the translation 2 d r* are both
+    // quadratic in (r, d), so dividing them by |r|^2 gives the
+    // transform of the normalized dual quaternion, without a sqrt.
+    //
+
+    T       s = T (2) / r.euclideanInnerProduct (r);
+    Vec3<T> a = r.v % p + r.r * p;
+    Vec3<T> t = r.r * d.v - d.r * r.v + (r.v % d.v);
+    return p + s * ((r.v % a) + t);
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Vec3<T>
+DualQuat<T>::transformDirection (const Vec3<T>& v) const IMATH_NOEXCEPT
+{
+    T       s = T (2) / r.euclideanInnerProduct (r);
+    Vec3<T> a = r.v % v + r.r * v;
+    return v + s * (r.v % a);
+}
+
+/// Dual quaternion multiplication
+/// @return dq1 * dq2, which applies dq2 first
+template <class T>
+IMATH_HOSTDEVICE constexpr inline DualQuat<T>
+operator* (const DualQuat<T>& dq1, const DualQuat<T>& dq2) IMATH_NOEXCEPT
+{
+    return DualQuat<T> (dq1.r * dq2.r, dq1.r * dq2.d + dq1.d * dq2.r);
+}
+
+/// Dual quaternion*scalar multiplication
+/// @return dq * t
+template <class T>
+IMATH_HOSTDEVICE constexpr inline DualQuat<T>
+operator* (const DualQuat<T>& dq, T t) IMATH_NOEXCEPT
+{
+    return DualQuat<T> (dq.r * t, dq.d * t);
+}
+
+/// Dual quaternion*scalar multiplication
+/// @return t * dq
+template <class T>
+IMATH_HOSTDEVICE constexpr inline DualQuat<T>
+operator* (T t, const DualQuat<T>& dq) IMATH_NOEXCEPT
+{
+    return DualQuat<T> (dq.r * t, dq.d * t);
+}
+
+/// Dual quaternion addition
+template <class T>
+IMATH_HOSTDEVICE constexpr inline DualQuat<T>
+operator+ (const DualQuat<T>& dq1, const DualQuat<T>& dq2) IMATH_NOEXCEPT
+{
+    return DualQuat<T> (dq1.r + dq2.r, dq1.d + dq2.d);
+}
+
+/// Negate the dual quaternion, which leaves the transform unchanged
+template <class T>
+IMATH_HOSTDEVICE constexpr inline DualQuat<T>
+operator- (const DualQuat<T>& dq) IMATH_NOEXCEPT
+{
+    return DualQuat<T> (-dq.r, -dq.d);
+}
+
+/// Stream output as "((r x y z) (r x y z))"
+template <class T>
+std::ostream&
+operator<< (std::ostream& o, const DualQuat<T>& dq)
+{
+    return o << "(" << dq.r << " " << dq.d << ")";
+}
+
+template <class T>
+inline DualQuat<T>
+extractDualQuat (const Matrix44<T>& mat) IMATH_NOEXCEPT
+{
+    Quat<T> q = extractQuat (sansScalingAndShear (mat, false));
+    return DualQuat<T> (q, Vec3<T> (mat[3][0], mat[3][1], mat[3][2]));
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline DualQuat<T>
+blend (const DualQuat<T>* dqs, const T* weights, size_t n) IMATH_NOEXCEPT
+{
+    DualQuat<T> b (Quat<T> (0, 0, 0, 0), Quat<T> (0, 0, 0, 0));
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        T w = weights[i];
+        if (dqs[i].r.euclideanInnerProduct (dqs[0].r) < 0) w = -w;
+
+        b.r += dqs[i].r * w;
+        b.d += dqs[i].d * w;
+    }
+
+    return b.normalize ();
+}
+
+/// @cond Doxygen_Suppress
+
+//
+// The weighted sum of the bones of vertex i, each negated if needed to
+// lie in the same hemisphere as the first. The sum is left unnormalized,
+// since DualQuat::transformPoint() and transformDirection() divide by
+// its squared length anyway. Without influences, it is the identity.
+//
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline DualQuat<T>
+skinBlend (
+    const DualQuat<T>* bones,
+    const uint32_t*    boneIndices,
+    const T*           weights,
+    int                influences,
+    size_t             i) IMATH_NOEXCEPT
+{
+    if (influences < 1) return DualQuat<T> ();
+
+    const uint32_t*    b     = boneIndices + i * influences;
+    const T*           w     = weights + i * influences;
+    const DualQuat<T>& first = bones[b[0]];
+    DualQuat<T>        dq    = first * w[0];
+
+    for (int k = 1; k < influences; ++k)
+    {
+        const DualQuat<T>& bone = bones[b[k]];
+        T                  dot  = bone.r.euclideanInnerProduct (first.r);
+        T                  wk   = dot < 0 ? -w[k] : w[k];
+        dq.r += bone.r * wk;
+        dq.d += bone.d * wk;
+    }
+
+    return dq;
+}
+
+/// @endcond
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+skin (
+    const DualQuat<T>* bones,
+    const uint32_t*    boneIndices,
+    const T*           weights,
+    int                influences,
+    const Vec3<T>*     positions,
+    Vec3<T>*           skinnedPositions,
+    size_t             n) IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        DualQuat<T> dq = skinBlend (bones, boneIndices, weights, influences, i);
+        skinnedPositions[i] = dq.transformPoint (positions[i]);
+    }
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+skin (
+    const DualQuat<T>* bones,
+    const uint32_t*    boneIndices,
+    const T*           weights,
+    int                influences,
+    const Vec3<T>*     positions,
+    const Vec3<T>*     normals,
+    Vec3<T>*           skinnedPositions,
+    Vec3<T>*           skinnedNormals,
+    size_t             n) IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        DualQuat<T> dq = skinBlend (bones, boneIndices, weights, influences, i);
+        skinnedPositions[i] = dq.transformPoint (positions[i]);
+        skinnedNormals[i]   = dq.transformDirection (normals[i]);
+    }
+}
+
+IMATH_INTERNAL_NAMESPACE_HEADER_EXIT
+
+#endif // INCLUDED_IMATHDUALQUAT_H
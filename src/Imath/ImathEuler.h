@@ -18,6 +18,7 @@
 #include "ImathQuat.h"
 #include "ImathVec.h"
 
+#include <cstddef>
 #include <iostream>
 
 IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
@@ -396,6 +397,51 @@ typedef Euler<float> Eulerf;
 /// Euler of type double
 typedef Euler<double> Eulerd;
 
+///
+/// @{
+/// @name Array conversions
+///
+/// Convert `n` Euler angles to rotation matrices, or `n` rotation
+/// matrices to Euler angles, as Euler::toMatrix33(),
+/// Euler::toMatrix44() and Euler::extract() do, to within rounding. The
+/// rotation order of each element is decoded once per run of
+/// consecutive elements with the same order, rather than once per
+/// element, and each run is converted by code specialized for its
+/// order; arrays that use a single order, such as animation channels,
+/// are a single run.
+///
+/// extractEuler() writes only the angles of `eulers[i]`, which must
+/// already hold the desired rotation orders.
+///
+/// If `Approx` is true, the conversions use sincosApprox() and
+/// atan2Approx(), and the results agree with those of Euler only to
+/// within a few ulp. It defaults to true if IMATH_USE_APPROX_TRIG is
+/// defined, and can also be given explicitly, as in
+/// `toMatrix44<float, true> (eulers, mats, n)`.
+///
+
+/// Set `mats[i]` to `eulers[i].toMatrix33()` for `i` in [0, n).
+template <class T, bool Approx = IMATH_APPROX_TRIG_DEFAULT>
+IMATH_HOSTDEVICE void
+toMatrix33 (const Euler<T>* eulers, Matrix33<T>* mats, size_t n) IMATH_NOEXCEPT;
+
+/// Set `mats[i]` to `eulers[i].toMatrix44()` for `i` in [0, n).
+template <class T, bool Approx = IMATH_APPROX_TRIG_DEFAULT>
+IMATH_HOSTDEVICE void
+toMatrix44 (const Euler<T>* eulers, Matrix44<T>* mats, size_t n) IMATH_NOEXCEPT;
+
+/// Call `eulers[i].extract (mats[i])` for `i` in [0, n).
+template <class T, bool Approx = IMATH_APPROX_TRIG_DEFAULT>
+IMATH_HOSTDEVICE void extractEuler (
+    const Matrix33<T>* mats, Euler<T>* eulers, size_t n) IMATH_NOEXCEPT;
+
+/// Call `eulers[i].extract (mats[i])` for `i` in [0, n).
+template <class T, bool Approx = IMATH_APPROX_TRIG_DEFAULT>
+IMATH_HOSTDEVICE void extractEuler (
+    const Matrix44<T>* mats, Euler<T>* eulers, size_t n) IMATH_NOEXCEPT;
+
+/// @}
+
 //
 // Implementation
 //
@@ -1036,8 +1082,395 @@ Euler<T>::makeNear (const Euler<T>& target) IMATH_NOEXCEPT
     setXYZVector (xyzRot);
 }
 
+//
+// The conversions of Euler<T> for a single order, O. The axes and the
+// flags that Euler decodes on every call are constants here, so that
+// the array conversions run without branches on the order. The
+// arithmetic is the same as Euler's, except that the array conversions
+// may use the approximations of the trig functions.
+//
+// The conversions are split into the steps before and after each call
+// of a trig function, so that the array conversions can make the
+// calls in loops of their own, which the compiler vectorizes when the
+// functions are the approximations.
+//
+
+template <class T, int O> struct EulerOrderKernel
+{
+    static const bool frameStatic     = (O & 0x0001) != 0;
+    static const bool initialRepeated = (O & 0x0010) != 0;
+    static const bool parityEven      = (O & 0x0100) != 0;
+
+    enum
+    {
+        i = (O >> 12) & 3,
+        j = parityEven ? (i + 1) % 3 : (i > 0 ? i - 1 : 2),
+        k = parityEven ? (i > 0 ? i - 1 : 2) : (i + 1) % 3
+    };
+
+    // The angles of the three rotations of toMatrix()
+    IMATH_HOSTDEVICE static Vec3<T>
+    angles (const Euler<T>& e) IMATH_NOEXCEPT
+    {
+        Vec3<T> angles = frameStatic ? Vec3<T> (e) : Vec3<T> (e.z, e.y, e.x);
+
+        if (!parityEven) angles *= -1.0;
+
+        return angles;
+    }
+
+    // The matrix of the angles, from their sines and cosines
+    template <class M>
+    IMATH_HOSTDEVICE static void
+    toMatrix (T si, T sj, T sh, T ci, T cj, T ch, M& M_) IMATH_NOEXCEPT
+    {
+        T cc = ci * ch;
+        T cs = ci * sh;
+        T sc = si * ch;
+        T ss = si * sh;
+
+        if (initialRepeated)
+        {
+            M_[i][i] = cj;
+            M_[j][i] = sj * si;
+            M_[k][i] = sj * ci;
+            M_[i][j] = sj * sh;
+            M_[j][j] = -cj * ss + cc;
+            M_[k][j] = -cj * cs - sc;
+            M_[i][k] = -sj * ch;
+            M_[j][k] = cj * sc + cs;
+            M_[k][k] = cj * cc - ss;
+        }
+        else
+        {
+            M_[i][i] = cj * ch;
+            M_[j][i] = sj * sc - cs;
+            M_[k][i] = sj * cc + ss;
+            M_[i][j] = cj * sh;
+            M_[j][j] = sj * ss + cc;
+            M_[k][j] = sj * cs - sc;
+            M_[i][k] = -sj;
+            M_[j][k] = cj * si;
+            M_[k][k] = cj * ci;
+        }
+    }
+
+    //
+    // Euler::extract() finds the first angle, x, as the arctangent of
+    // yx / xx. It then multiplies M by a Matrix44 rotation about axis
+    // i by x to give N. Only rows j and k of that rotation differ from
+    // the identity, and only the entries of N used for the other two
+    // angles, the arctangents of yy / xy and yz / xz, are computed.
+    //
+
+    template <class M>
+    IMATH_HOSTDEVICE static void
+    extractX (const M& M_, T& yx, T& xx) IMATH_NOEXCEPT
+    {
+        if (initialRepeated)
+        {
+            yx = M_[j][i];
+            xx = M_[k][i];
+        }
+        else
+        {
+            yx = M_[j][k];
+            xx = M_[k][k];
+        }
+    }
+
+    template <class M>
+    IMATH_HOSTDEVICE static void
+    extractYZ (const M& M_, T s, T c, T& yy, T& xy, T& yz, T& xz)
+        IMATH_NOEXCEPT
+    {
+        T nji = c * M_[j][i] - s * M_[k][i];
+        T njj = c * M_[j][j] - s * M_[k][j];
+
+        if (initialRepeated)
+        {
+            T nki = s * M_[j][i] + c * M_[k][i];
+            T njk = c * M_[j][k] - s * M_[k][k];
+
+            yy = std::sqrt (nji * nji + nki * nki);
+            xy = M_[i][i];
+            yz = njk;
+            xz = njj;
+        }
+        else
+        {
+            yy = -M_[i][k];
+            xy = std::sqrt (M_[i][i] * M_[i][i] + M_[i][j] * M_[i][j]);
+            yz = -nji;
+            xz = njj;
+        }
+    }
+
+    IMATH_HOSTDEVICE static void
+    setAngles (T x, T y, T z, Euler<T>& e) IMATH_NOEXCEPT
+    {
+        if (!parityEven)
+        {
+            x = -x;
+            y = -y;
+            z = -z;
+        }
+
+        e.x = frameStatic ? x : z;
+        e.y = y;
+        e.z = frameStatic ? z : x;
+    }
+};
+
+//
+// Call op.template apply<O>() for the order O of an Euler. order() only
+// returns the 24 legal orders, but should it return anything else,
+// op.scalar() converts with the member functions of Euler.
+//
+
+template <class T, class Op>
+IMATH_HOSTDEVICE inline void
+eulerOrderDispatch (typename Euler<T>::Order order, const Op& op) IMATH_NOEXCEPT
+{
+    typedef Euler<T> E;
+
+    switch (order)
+    {
+        case E::XYZ: op.template apply<E::XYZ> (); break;
+        case E::XZY: op.template apply<E::XZY> (); break;
+        case E::YZX: op.template apply<E::YZX> (); break;
+        case E::YXZ: op.template apply<E::YXZ> (); break;
+        case E::ZXY: op.template apply<E::ZXY> (); break;
+        case E::ZYX: op.template apply<E::ZYX> (); break;
+        case E::XZX: op.template apply<E::XZX> (); break;
+        case E::XYX: op.template apply<E::XYX> (); break;
+        case E::YXY: op.template apply<E::YXY> (); break;
+        case E::YZY: op.template apply<E::YZY> (); break;
+        case E::ZYZ: op.template apply<E::ZYZ> (); break;
+        case E::ZXZ: op.template apply<E::ZXZ> (); break;
+        case E::XYZr: op.template apply<E::XYZr> (); break;
+        case E::XZYr: op.template apply<E::XZYr> (); break;
+        case E::YZXr: op.template apply<E::YZXr> (); break;
+        case E::YXZr: op.template apply<E::YXZr> (); break;
+        case E::ZXYr: op.template apply<E::ZXYr> (); break;
+        case E::ZYXr: op.template apply<E::ZYXr> (); break;
+        case E::XZXr: op.template apply<E::XZXr> (); break;
+        case E::XYXr: op.template apply<E::XYXr> (); break;
+        case E::YXYr: op.template apply<E::YXYr> (); break;
+        case E::YZYr: op.template apply<E::YZYr> (); break;
+        case E::ZYZr: op.template apply<E::ZYZr> (); break;
+        case E::ZXZr: op.template apply<E::ZXZr> (); break;
+        default: op.scalar (); break;
+    }
+}
+
+//
+// Find the runs of elements with the same order, and call
+// op.template apply<O>() for each, after setting op.first and op.n to
+// the run.
+//
+
+template <class T, class Op>
+IMATH_HOSTDEVICE inline void
+eulerOrderRuns (const Euler<T>* eulers, size_t n, Op& op) IMATH_NOEXCEPT
+{
+    for (size_t first = 0; first < n;)
+    {
+        typename Euler<T>::Order order = eulers[first].order ();
+
+        size_t last = first + 1;
+        while (last < n && eulers[last].order () == order)
+            ++last;
+
+        op.first = first;
+        op.n     = last - first;
+        eulerOrderDispatch<T> (order, op);
+
+        first = last;
+    }
+}
+
+//
+// The array conversions work on blocks of eulerLanes elements, whose
+// angles, sines and cosines are kept in one array each.
+//
+
+const int eulerLanes = 16;
+
+//
+// The trig functions of the array conversions: the std:: functions, or
+// the approximations if Approx is true.
+//
+
+template <class T, bool Approx> struct EulerTrig
+{
+    IMATH_HOSTDEVICE static void
+    sincos (const T* x, T* s, T* c, size_t n) IMATH_NOEXCEPT
+    {
+        arraySincos (x, s, c, n);
+    }
+
+    IMATH_HOSTDEVICE static void
+    atan2 (const T* y, const T* x, T* a, size_t n) IMATH_NOEXCEPT
+    {
+        arrayAtan2 (y, x, a, n);
+    }
+};
+
+template <class T> struct EulerTrig<T, true>
+{
+    IMATH_HOSTDEVICE static void
+    sincos (const T* x, T* s, T* c, size_t n) IMATH_NOEXCEPT
+    {
+        arraySincosApprox (x, s, c, n);
+    }
+
+    IMATH_HOSTDEVICE static void
+    atan2 (const T* y, const T* x, T* a, size_t n) IMATH_NOEXCEPT
+    {
+        arrayAtan2Approx (y, x, a, n);
+    }
+};
+
+template <class T, class M, bool Approx> struct EulerToMatrixOp
+{
+    const Euler<T>* eulers;
+    M*              mats;
+    size_t          first, n;
+
+    template <int O> IMATH_HOSTDEVICE void apply () const IMATH_NOEXCEPT
+    {
+        typedef EulerOrderKernel<T, O> K;
+        typedef EulerTrig<T, Approx>   Trig;
+
+        T a[3][eulerLanes], s[3][eulerLanes], c[3][eulerLanes];
+
+        for (size_t b = first; b < first + n; b += eulerLanes)
+        {
+            int count = int (first + n - b);
+            if (count > eulerLanes) count = eulerLanes;
+
+            for (int m = 0; m < count; ++m)
+            {
+                Vec3<T> angles = K::angles (eulers[b + m]);
+                a[0][m]        = angles.x;
+                a[1][m]        = angles.y;
+                a[2][m]        = angles.z;
+            }
+
+            for (int r = 0; r < 3; ++r)
+                Trig::sincos (a[r], s[r], c[r], count);
+
+            for (int m = 0; m < count; ++m)
+            {
+                M mat;
+                K::toMatrix (
+                    s[0][m], s[1][m], s[2][m], c[0][m], c[1][m], c[2][m], mat);
+                mats[b + m] = mat;
+            }
+        }
+    }
+
+    IMATH_HOSTDEVICE void scalar () const IMATH_NOEXCEPT
+    {
+        for (size_t m = first; m < first + n; ++m)
+            toMatrix (eulers[m], mats[m]);
+    }
+
+    IMATH_HOSTDEVICE static void
+    toMatrix (const Euler<T>& e, Matrix33<T>& mat) IMATH_NOEXCEPT
+    {
+        mat = e.toMatrix33 ();
+    }
+
+    IMATH_HOSTDEVICE static void
+    toMatrix (const Euler<T>& e, Matrix44<T>& mat) IMATH_NOEXCEPT
+    {
+        mat = e.toMatrix44 ();
+    }
+};
+
+template <class T, class M, bool Approx> struct ExtractEulerOp
+{
+    const M*  mats;
+    Euler<T>* eulers;
+    size_t    first, n;
+
+    template <int O> IMATH_HOSTDEVICE void apply () const IMATH_NOEXCEPT
+    {
+        typedef EulerOrderKernel<T, O> K;
+        typedef EulerTrig<T, Approx>   Trig;
+
+        T y[3][eulerLanes], x[3][eulerLanes], a[3][eulerLanes];
+        T s[eulerLanes], c[eulerLanes];
+
+        for (size_t b = first; b < first + n; b += eulerLanes)
+        {
+            int count = int (first + n - b);
+            if (count > eulerLanes) count = eulerLanes;
+
+            for (int m = 0; m < count; ++m)
+                K::extractX (mats[b + m], y[0][m], x[0][m]);
+
+            Trig::atan2 (y[0], x[0], a[0], count);
+            Trig::sincos (a[0], s, c, count);
+
+            for (int m = 0; m < count; ++m)
+                K::extractYZ (
+                    mats[b + m], s[m], c[m], y[1][m], x[1][m], y[2][m],
+                    x[2][m]);
+
+            Trig::atan2 (y[1], x[1], a[1], count);
+            Trig::atan2 (y[2], x[2], a[2], count);
+
+            for (int m = 0; m < count; ++m)
+                K::setAngles (a[0][m], a[1][m], a[2][m], eulers[b + m]);
+        }
+    }
+
+    IMATH_HOSTDEVICE void scalar () const IMATH_NOEXCEPT
+    {
+        for (size_t m = first; m < first + n; ++m)
+            eulers[m].extract (mats[m]);
+    }
+};
+
 /// @endcond
 
+template <class T, bool Approx>
+IMATH_HOSTDEVICE inline void
+toMatrix33 (const Euler<T>* eulers, Matrix33<T>* mats, size_t n) IMATH_NOEXCEPT
+{
+    EulerToMatrixOp<T, Matrix33<T>, Approx> op = {eulers, mats, 0, 0};
+    eulerOrderRuns (eulers, n, op);
+}
+
+template <class T, bool Approx>
+IMATH_HOSTDEVICE inline void
+toMatrix44 (const Euler<T>* eulers, Matrix44<T>* mats, size_t n) IMATH_NOEXCEPT
+{
+    EulerToMatrixOp<T, Matrix44<T>, Approx> op = {eulers, mats, 0, 0};
+    eulerOrderRuns (eulers, n, op);
+}
+
+template <class T, bool Approx>
+IMATH_HOSTDEVICE inline void
+extractEuler (
+    const Matrix33<T>* mats, Euler<T>* eulers, size_t n) IMATH_NOEXCEPT
+{
+    ExtractEulerOp<T, Matrix33<T>, Approx> op = {mats, eulers, 0, 0};
+    eulerOrderRuns (eulers, n, op);
+}
+
+template <class T, bool Approx>
+IMATH_HOSTDEVICE inline void
+extractEuler (
+    const Matrix44<T>* mats, Euler<T>* eulers, size_t n) IMATH_NOEXCEPT
+{
+    ExtractEulerOp<T, Matrix44<T>, Approx> op = {mats, eulers, 0, 0};
+    eulerOrderRuns (eulers, n, op);
+}
+
 /// Stream ouput, as "(x y z i j k)"
 template <class T>
 std::ostream&
@@ -27,10 +27,16 @@ IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
 #ifndef INCLUDED_IMATHBOX_H
 template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Box;
 #endif
+#ifndef INCLUDED_IMATHBVH_H
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE BVH;
+#endif
 #ifndef INCLUDED_IMATHCOLOR_H
 template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Color3;
 template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Color4;
 #endif
+#ifndef INCLUDED_IMATHDUALQUAT_H
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE DualQuat;
+#endif
 #ifndef INCLUDED_IMATHEULER_H
 template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Euler;
 #endif
@@ -66,6 +72,12 @@ template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Sphere3;
 template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec2;
 template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec3;
 template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec4;
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec3A;
+#endif
+#ifndef INCLUDED_IMATHVECARRAY_H
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec2Array;
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec3Array;
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec4Array;
 #endif
 
 #ifndef INCLUDED_IMATHRANDOM_H
@@ -24,6 +24,9 @@
 #include "ImathSphere.h"
 #include "ImathVec.h"
 
+#include <cstddef>
+#include <cstdint>
+
 IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
 
 ///
@@ -55,6 +58,12 @@ IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
 ///    myFrustumTest.completelyContains(myBox)
 ///    myFrustumTest.completelyContains(mySphere)
 ///
+/// To cull whole arrays of objects at once, call:
+///    myFrustumTest.isVisible(myBoxes, numBoxes, myMask)
+///    myFrustumTest.isVisible(mySpheres, numSpheres, myMask)
+///    myFrustumTest.visibleIndices(myBoxes, numBoxes, myIndices)
+///    myFrustumTest.visibleIndices(mySpheres, numSpheres, myIndices)
+///
 /// Explanation of how it works
 ///
 /// We store six world-space Frustum planes (nx, ny, nz, offset)
@@ -81,6 +90,10 @@ IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
 ///     In order to do this, the plane equations are stored in "transpose"
 ///     form, with the X components grouped into an X vector, etc.
 ///
+///     The array versions of isVisible() go one step further and test
+///     blocks of eight primitives against one plane at a time, so that
+///     the compiler can map the eight lanes onto SIMD registers.
+///
 
 template <class T> class IMATH_EXPORT_TEMPLATE_TYPE FrustumTest
 {
@@ -139,6 +152,36 @@ public:
     /// The result MAY return close false-negatives, but not false-positives.
     bool completelyContains (const Box<Vec3<T>>& box) const IMATH_NOEXCEPT;
 
+    /// Test `n` spheres for visibility, setting `mask[i]` to 1 if
+    /// `spheres[i]` is visible and to 0 otherwise. Each mask entry
+    /// matches the result of the single-sphere isVisible().
+    /// @return The number of visible spheres.
+    size_t isVisible (const Sphere3<T>* spheres, size_t n, uint8_t* mask) const
+        IMATH_NOEXCEPT;
+
+    /// Test `n` boxes for visibility, setting `mask[i]` to 1 if
+    /// `boxes[i]` is visible and to 0 otherwise. Each mask entry
+    /// matches the result of the single-box isVisible().
+    /// @return The number of visible boxes.
+    size_t isVisible (const Box<Vec3<T>>* boxes, size_t n, uint8_t* mask) const
+        IMATH_NOEXCEPT;
+
+    /// Test `n` spheres for visibility and write the indices of the
+    /// visible ones, in increasing order, to `indices`, which must
+    /// have room for `n` entries.
+    /// @return The number of visible spheres.
+    size_t visibleIndices (
+        const Sphere3<T>* spheres, size_t n, size_t* indices) const
+        IMATH_NOEXCEPT;
+
+    /// Test `n` boxes for visibility and write the indices of the
+    /// visible ones, in increasing order, to `indices`, which must
+    /// have room for `n` entries.
+    /// @return The number of visible boxes.
+    size_t visibleIndices (
+        const Box<Vec3<T>>* boxes, size_t n, size_t* indices) const
+        IMATH_NOEXCEPT;
+
     /// Return the camera matrix (primarily for debugging)
     IMATH_INTERNAL_NAMESPACE::Matrix44<T> cameraMat () const IMATH_NOEXCEPT
     {
@@ -174,6 +217,9 @@ protected:
     Frustum<T>  currFrustum;
     Matrix44<T> cameraMatrix;
 
+    void planeLanes (T (&nx)[8], T (&ny)[8], T (&nz)[8], T (&o)[8]) const
+        IMATH_NOEXCEPT;
+
     /// @endcond
 };
 
@@ -342,6 +388,203 @@ FrustumTest<T>::isVisible (const Vec3<T>& vec) const IMATH_NOEXCEPT
     return true;
 }
 
+//
+// The array versions evaluate all six plane distances of a primitive
+// with no early exit, and fold the comparisons together with `|`, so
+// that the loops are free of branches and the compiler can test
+// several primitives per SIMD register. The planes are padded to
+// eight by repeating the last one. Results are staged in small
+// per-chunk arrays of T before being narrowed to the byte mask, which
+// keeps the element sizes in the hot loop uniform. A primitive is
+// culled when any plane distance is >= 0, exactly as in the
+// single-primitive tests, including when a distance is NaN.
+//
+
+/// @cond Doxygen_Suppress
+
+template <typename T>
+void
+FrustumTest<T>::planeLanes (
+    T (&nx)[8], T (&ny)[8], T (&nz)[8], T (&o)[8]) const IMATH_NOEXCEPT
+{
+    for (int p = 0; p < 8; ++p)
+    {
+        int i = p < 6 ? p : 5;
+        nx[p] = planeNormX[i / 3][i % 3];
+        ny[p] = planeNormY[i / 3][i % 3];
+        nz[p] = planeNormZ[i / 3][i % 3];
+        o[p]  = planeOffsetVec[i / 3][i % 3];
+    }
+}
+
+/// @endcond
+
+template <typename T>
+size_t
+FrustumTest<T>::isVisible (
+    const Sphere3<T>* spheres, size_t n, uint8_t* mask) const IMATH_NOEXCEPT
+{
+    T nx[8], ny[8], nz[8], o[8];
+    planeLanes (nx, ny, nz, o);
+
+    const size_t chunk = 64;
+    T            visible[chunk];
+    size_t       count = 0;
+
+    for (size_t first = 0; first < n; first += chunk)
+    {
+        const size_t m = n - first < chunk ? n - first : chunk;
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            const Vec3<T>& c = spheres[first + i].center;
+            const T        r = spheres[first + i].radius;
+
+            int64_t out = 0;
+
+            for (int p = 0; p < 8; ++p)
+            {
+                T d = nx[p] * c.x + ny[p] * c.y + nz[p] * c.z - r - o[p];
+                out |= d >= 0;
+            }
+
+            visible[i] = out == 0 ? T (1) : T (0);
+        }
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            mask[first + i] = visible[i] != 0;
+            count += visible[i] != 0;
+        }
+    }
+
+    return count;
+}
+
+template <typename T>
+size_t
+FrustumTest<T>::isVisible (
+    const Box<Vec3<T>>* boxes, size_t n, uint8_t* mask) const IMATH_NOEXCEPT
+{
+    T nx[8], ny[8], nz[8], o[8];
+    planeLanes (nx, ny, nz, o);
+
+    T ax[8], ay[8], az[8];
+    for (int p = 0; p < 8; ++p)
+    {
+        ax[p] = std::abs (nx[p]);
+        ay[p] = std::abs (ny[p]);
+        az[p] = std::abs (nz[p]);
+    }
+
+    //
+    // Boxes are converted to center and extent in chunks, laid out
+    // component by component, so that the plane tests run over
+    // contiguous arrays.
+    //
+
+    const size_t chunk = 64;
+    T            cx[chunk], cy[chunk], cz[chunk];
+    T            ex[chunk], ey[chunk], ez[chunk];
+    T            empty[chunk], visible[chunk];
+    size_t       count = 0;
+
+    for (size_t first = 0; first < n; first += chunk)
+    {
+        const size_t m = n - first < chunk ? n - first : chunk;
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            const Box<Vec3<T>>& b = boxes[first + i];
+
+            cx[i]    = (b.min.x + b.max.x) / 2;
+            cy[i]    = (b.min.y + b.max.y) / 2;
+            cz[i]    = (b.min.z + b.max.z) / 2;
+            ex[i]    = b.max.x - cx[i];
+            ey[i]    = b.max.y - cy[i];
+            ez[i]    = b.max.z - cz[i];
+            empty[i] = (b.max.x < b.min.x) | (b.max.y < b.min.y) |
+                               (b.max.z < b.min.z)
+                           ? T (1)
+                           : T (0);
+        }
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            int64_t out = empty[i] != 0;
+
+            for (int p = 0; p < 8; ++p)
+            {
+                T d = nx[p] * cx[i] + ny[p] * cy[i] + nz[p] * cz[i] -
+                      ax[p] * ex[i] - ay[p] * ey[i] - az[p] * ez[i] - o[p];
+                out |= d >= 0;
+            }
+
+            visible[i] = out == 0 ? T (1) : T (0);
+        }
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            mask[first + i] = visible[i] != 0;
+            count += visible[i] != 0;
+        }
+    }
+
+    return count;
+}
+
+template <typename T>
+size_t
+FrustumTest<T>::visibleIndices (
+    const Sphere3<T>* spheres, size_t n, size_t* indices) const IMATH_NOEXCEPT
+{
+    const size_t chunk = 256;
+    uint8_t      mask[chunk];
+    size_t       count = 0;
+
+    for (size_t first = 0; first < n; first += chunk)
+    {
+        const size_t m = n - first < chunk ? n - first : chunk;
+
+        isVisible (spheres + first, m, mask);
+
+        // Branch-free compaction: always store, only advance on a hit.
+        for (size_t i = 0; i < m; ++i)
+        {
+            indices[count] = first + i;
+            count += mask[i];
+        }
+    }
+
+    return count;
+}
+
+template <typename T>
+size_t
+FrustumTest<T>::visibleIndices (
+    const Box<Vec3<T>>* boxes, size_t n, size_t* indices) const IMATH_NOEXCEPT
+{
+    const size_t chunk = 256;
+    uint8_t      mask[chunk];
+    size_t       count = 0;
+
+    for (size_t first = 0; first < n; first += chunk)
+    {
+        const size_t m = n - first < chunk ? n - first : chunk;
+
+        isVisible (boxes + first, m, mask);
+
+        // Branch-free compaction: always store, only advance on a hit.
+        for (size_t i = 0; i < m; ++i)
+        {
+            indices[count] = first + i;
+            count += mask[i];
+        }
+    }
+
+    return count;
+}
+
 /// FrustymTest of type float
 typedef FrustumTest<float> FrustumTestf;
 
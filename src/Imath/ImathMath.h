@@ -5,7 +5,8 @@
 
 //
 // Obsolete functions provided for compatibility, deprecated in favor
-// of std:: functions.
+// of std:: functions, and sine, cosine and arctangent functions for
+// rotations.
 //
 
 #ifndef INCLUDED_IMATHMATH_H
@@ -14,6 +15,9 @@
 #include "ImathNamespace.h"
 #include "ImathPlatform.h"
 #include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <limits>
 
 IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
@@ -140,6 +144,292 @@ sinx_over_x (T x)
         return std::sin (x) / x;
 }
 
+/// Set `s` and `c` to the sine and cosine of `x`. This is std::sin()
+/// and std::cos(), which the compiler combines into a single call
+/// where the math library provides one.
+template <class T>
+IMATH_HOSTDEVICE inline void
+sincos (T x, T& s, T& c) IMATH_NOEXCEPT
+{
+    s = std::sin (x);
+    c = std::cos (x);
+}
+
+/// @cond Doxygen_Suppress
+//
+// The pieces of sincosApprox() and atan2Approx() for float and
+// double. The polynomials are those of the Cephes library: sinf(),
+// cosf(), atanf(), and sin(), cos() and atan(). The branches of
+// Cephes are replaced with arithmetic on 0 or 1, and comparisons with
+// integer comparisons of the bit patterns of non-negative numbers, so
+// that a loop over an array vectorizes whatever the floating point
+// flags.
+//
+
+template <class T> struct TrigApprox;
+
+template <> struct TrigApprox<float>
+{
+    // pi/2 as a sum of three parts, for Cody-Waite argument reduction
+    IMATH_HOSTDEVICE static void
+    pio2 (float& a, float& b, float& c) IMATH_NOEXCEPT
+    {
+        a = 1.5703125f;
+        b = 4.837512969970703125e-4f;
+        c = 7.54978995489188216e-8f;
+    }
+
+    // sin(r) and cos(r) for |r| <= pi/4
+    IMATH_HOSTDEVICE static void
+    sinCos (float r, float& s, float& c) IMATH_NOEXCEPT
+    {
+        float z  = r * r;
+        float ps = -1.9515295891e-4f;
+        ps       = ps * z + 8.3321608736e-3f;
+        ps       = ps * z - 1.6666654611e-1f;
+        float pc = 2.443315711809948e-5f;
+        pc       = pc * z - 1.388731625493765e-3f;
+        pc       = pc * z + 4.166664568298827e-2f;
+
+        s = r + r * z * ps;
+        c = 1.0f - 0.5f * z + z * z * pc;
+    }
+
+    // atan(t) for 0 <= t <= tan(pi/8)
+    IMATH_HOSTDEVICE static float
+    atan (float t) IMATH_NOEXCEPT
+    {
+        float z = t * t;
+        float p = 8.05374449538e-2f;
+        p       = p * z - 1.38776856032e-1f;
+        p       = p * z + 1.99777106478e-1f;
+        p       = p * z - 3.33329491539e-1f;
+        return t + t * z * p;
+    }
+
+    // Above this, atan(t) is pi/4 + atan((t - 1) / (t + 1)).
+    IMATH_HOSTDEVICE static float atanReduce () IMATH_NOEXCEPT
+    {
+        return 0.414213562373095f;
+    }
+
+    // 1 if a > b, otherwise 0, for non-negative a and b
+    IMATH_HOSTDEVICE static float
+    greater (float a, float b) IMATH_NOEXCEPT
+    {
+        uint32_t ia, ib;
+        std::memcpy (&ia, &a, sizeof (ia));
+        std::memcpy (&ib, &b, sizeof (ib));
+        return float (int ((ib - ia) >> 31));
+    }
+};
+
+template <> struct TrigApprox<double>
+{
+    IMATH_HOSTDEVICE static void
+    pio2 (double& a, double& b, double& c) IMATH_NOEXCEPT
+    {
+        a = 1.57079625129699707031;
+        b = 7.54978941586159635336e-8;
+        c = 5.39030285815811905290e-15;
+    }
+
+    IMATH_HOSTDEVICE static void
+    sinCos (double r, double& s, double& c) IMATH_NOEXCEPT
+    {
+        double z  = r * r;
+        double ps = 1.58962301576546568060e-10;
+        ps        = ps * z - 2.50507477628578072866e-8;
+        ps        = ps * z + 2.75573136213857245213e-6;
+        ps        = ps * z - 1.98412698295895385996e-4;
+        ps        = ps * z + 8.33333333332211858878e-3;
+        ps        = ps * z - 1.66666666666666307295e-1;
+        double pc = -1.13585365213876817300e-11;
+        pc        = pc * z + 2.08757008419747316778e-9;
+        pc        = pc * z - 2.75573141792967388112e-7;
+        pc        = pc * z + 2.48015872888517045348e-5;
+        pc        = pc * z - 1.38888888888730564116e-3;
+        pc        = pc * z + 4.16666666666665929218e-2;
+
+        s = r + r * z * ps;
+        c = 1.0 - 0.5 * z + z * z * pc;
+    }
+
+    // atan(t) for 0 <= t <= 0.66
+    IMATH_HOSTDEVICE static double
+    atan (double t) IMATH_NOEXCEPT
+    {
+        double z = t * t;
+        double p = -8.750608600031904122785e-1;
+        p        = p * z - 1.615753718733365076637e1;
+        p        = p * z - 7.500855792314704667340e1;
+        p        = p * z - 1.228866684490136173410e2;
+        p        = p * z - 6.485021904942025371773e1;
+        double q = z + 2.485846490142306297962e1;
+        q        = q * z + 1.650270098316988542046e2;
+        q        = q * z + 4.328810604912902668951e2;
+        q        = q * z + 4.853903996359136964868e2;
+        q        = q * z + 1.945506571482613964425e2;
+        return t + t * z * p / q;
+    }
+
+    IMATH_HOSTDEVICE static double atanReduce () IMATH_NOEXCEPT
+    {
+        return 0.66;
+    }
+
+    IMATH_HOSTDEVICE static double
+    greater (double a, double b) IMATH_NOEXCEPT
+    {
+        uint64_t ia, ib;
+        std::memcpy (&ia, &a, sizeof (ia));
+        std::memcpy (&ib, &b, sizeof (ib));
+        return double (int ((ib - ia) >> 63));
+    }
+};
+/// @endcond
+
+/// A polynomial approximation of sincos(), for float and double.
+/// It has no branches or calls, so loops over arrays vectorize.
+///
+/// Measured against long double results, the error is:
+///
+/// - float: at most 1.6 ulp for |x| <= pi, and an absolute error
+///   below 1e-7 for |x| <= 8192.
+///
+/// - double: at most 1.6 ulp for |x| <= 1e6.
+///
+/// Beyond those ranges the argument reduction loses accuracy. The
+/// valid range is |x| < 2^30 * pi/2, about 1.7e9; beyond it, and for
+/// infinities and NaNs, both results are NaN.
+template <class T>
+IMATH_HOSTDEVICE inline void
+sincosApprox (T x, T& s, T& c) IMATH_NOEXCEPT
+{
+    typedef TrigApprox<T> A;
+
+    //
+    // x = k * pi/2 + r, with |r| <= pi/4, and the quadrant q = k mod 4
+    // picks the signs and whether sine and cosine swap. k is clamped
+    // to [-2^30, 2^30], so that the conversion to int, and q + 1, stay
+    // in range for any x; the comparisons send NaNs to 2^30. Where |k|
+    // reaches 2^30, and for NaNs, r is made a NaN by adding one; -0 is
+    // added otherwise, which leaves any r unchanged. Unlike a select of
+    // r, the addition keeps loops vectorizable.
+    //
+
+    const T m     = T (1 << 30);
+    T       y     = x * T (0.636619772367581343076) +
+                std::copysign (T (0.5), x);
+    bool    valid = std::abs (y) < m;
+    y             = y < m ? y : m;
+    y             = y > -m ? y : -m;
+
+    int q = int (y);
+    T   k = T (q);
+
+    T a, b, d;
+    A::pio2 (a, b, d);
+    T r = ((x - k * a) - k * b) - k * d;
+    r += valid ? T (-0.0) : std::numeric_limits<T>::quiet_NaN ();
+
+    T sr, cr;
+    A::sinCos (r, sr, cr);
+
+    T ss = (q & 1) ? cr : sr;
+    T cc = (q & 1) ? sr : cr;
+    s    = ss * T (1 - (q & 2));
+    c    = cc * T (1 - ((q + 1) & 2));
+}
+
+/// A polynomial approximation of std::atan2(), for float and double.
+/// Like sincosApprox(), it has no branches or calls.
+///
+/// Measured against long double results, the error is at most 2.9
+/// ulp for float and 1.7 ulp for double. Signed zeros give the same
+/// results as std::atan2(). The result is undefined for infinities
+/// and NaNs.
+template <class T>
+IMATH_HOSTDEVICE inline T
+atan2Approx (T y, T x) IMATH_NOEXCEPT
+{
+    typedef TrigApprox<T> A;
+
+    T ax = std::abs (x);
+    T ay = std::abs (y);
+
+    //
+    // atan(mn / mx) is in [0, pi/4], and is reflected into the right
+    // octant below. The products with 0 or 1 are exact.
+    //
+
+    T swap = A::greater (ay, ax);
+    T mn   = ay * (1 - swap) + ax * swap;
+    T mx   = ax * (1 - swap) + ay * swap;
+
+    T reduce = A::greater (mn, A::atanReduce () * mx);
+    T num    = mn - reduce * mx;
+    T den    = mx + reduce * mn + (1 - A::greater (mx, T (0)));
+    T a      = A::atan (num / den) + reduce * T (0.785398163397448309616);
+
+    a = swap * T (1.57079632679489661923) + a * (1 - 2 * swap);
+
+    T negX = (1 - std::copysign (T (1), x)) * T (0.5);
+    a      = negX * T (3.14159265358979323846) + a * (1 - 2 * negX);
+
+    return std::copysign (a, y);
+}
+
+/// @cond Doxygen_Suppress
+//
+// The sines, cosines and arctangents of arrays, for the array rotation
+// functions, with the std:: functions or the approximations. Each is a
+// single loop, which the compiler vectorizes in the case of the
+// approximations. The rotation functions choose between them with a
+// template parameter, whose default is IMATH_APPROX_TRIG_DEFAULT, so
+// that translation units that differ in IMATH_USE_APPROX_TRIG call
+// different functions rather than different definitions of one.
+//
+
+#ifdef IMATH_USE_APPROX_TRIG
+#    define IMATH_APPROX_TRIG_DEFAULT true
+#else
+#    define IMATH_APPROX_TRIG_DEFAULT false
+#endif
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+arraySincos (const T* x, T* s, T* c, size_t n) IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+        sincos (x[i], s[i], c[i]);
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+arraySincosApprox (const T* x, T* s, T* c, size_t n) IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+        sincosApprox (x[i], s[i], c[i]);
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+arrayAtan2 (const T* y, const T* x, T* a, size_t n) IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+        a[i] = std::atan2 (y[i], x[i]);
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+arrayAtan2Approx (const T* y, const T* x, T* a, size_t n) IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+        a[i] = atan2Approx (y[i], x[i]);
+}
+/// @endcond
+
 /// Compare two numbers and test if they are "approximately equal":
 ///
 /// @return Ttrue if x1 is the same as x2 with an absolute error of
@@ -24,6 +24,15 @@
 #include <limits>
 #include <string.h>
 
+#if defined(IMATH_SIMD_SSE2)
+#    include <emmintrin.h>
+#    if defined(__AVX__)
+#        include <immintrin.h>
+#    endif
+#elif defined(IMATH_SIMD_NEON)
+#    include <arm_neon.h>
+#endif
+
 #if (defined _WIN32 || defined _WIN64) && defined _MSC_VER
 // suppress exception specification warnings
 #    pragma warning(disable : 4290)
@@ -1071,7 +1080,8 @@ public:
         const Matrix44& b,           // &a != &c and
         Matrix44&       c) IMATH_NOEXCEPT; // &b != &c.
 
-    /// Matrix-matrix multiplication returning a result.
+    /// Matrix-matrix multiplication returning a result. This is always
+    /// the portable scalar code, even with IMATH_ENABLE_SIMD.
     IMATH_HOSTDEVICE
     static IMATH_CONSTEXPR14 Matrix44
     multiply (const Matrix44& a, const Matrix44& b) IMATH_NOEXCEPT;
@@ -1093,6 +1103,90 @@ public:
     IMATH_HOSTDEVICE void
     multDirMatrix (const Vec3<S>& src, Vec3<S>& dst) const IMATH_NOEXCEPT;
 
+    /// Vector-matrix multiplication of an array of points: transform
+    /// each of the `n` points in `src` as multVecMatrix() does, and
+    /// store the results in `dst`. If the last column of the matrix
+    /// is (0, 0, 0, 1), the homogeneous divide is skipped, which
+    /// gives identical results for finite input.
+    /// @param[in] src The input points
+    /// @param[out] dst The output points; may be the same array as `src`
+    /// @param[in] n The number of points
+    template <class S>
+    IMATH_HOSTDEVICE void multVecMatrix (
+        const Vec3<S>* src, Vec3<S>* dst, size_t n) const IMATH_NOEXCEPT;
+
+    /// Vector-matrix multiplication of an array of points stored as
+    /// separate x, y and z arrays (structure of arrays), which
+    /// vectorizes better than an array of Vec3. Each output array
+    /// must either be the same as the corresponding input array or
+    /// not overlap any of the input arrays.
+    template <class S>
+    IMATH_HOSTDEVICE void multVecMatrix (
+        const S* srcX,
+        const S* srcY,
+        const S* srcZ,
+        S*       dstX,
+        S*       dstY,
+        S*       dstZ,
+        size_t   n) const IMATH_NOEXCEPT;
+
+    /// Vector-matrix multiplication of an array of directions:
+    /// transform each of the `n` vectors in `src` as multDirMatrix()
+    /// does, and store the results in `dst`.
+    /// @param[in] src The input vectors
+    /// @param[out] dst The output vectors; may be the same array as `src`
+    /// @param[in] n The number of vectors
+    template <class S>
+    IMATH_HOSTDEVICE void multDirMatrix (
+        const Vec3<S>* src, Vec3<S>* dst, size_t n) const IMATH_NOEXCEPT;
+
+    /// Vector-matrix multiplication of an array of directions stored
+    /// as separate x, y and z arrays (structure of arrays), with the
+    /// same restrictions on overlap as multVecMatrix().
+    template <class S>
+    IMATH_HOSTDEVICE void multDirMatrix (
+        const S* srcX,
+        const S* srcY,
+        const S* srcZ,
+        S*       dstX,
+        S*       dstY,
+        S*       dstZ,
+        size_t   n) const IMATH_NOEXCEPT;
+
+    /// Vector-matrix multiplication of a padded and aligned point, as
+    /// multVecMatrix() of a Vec3 does. With IMATH_ENABLE_SIMD, a
+    /// float point is loaded, transformed and stored as one 4-lane
+    /// SIMD vector; the results agree with those for a Vec3 to within
+    /// rounding.
+    template <class S>
+    IMATH_HOSTDEVICE void
+    multVecMatrix (const Vec3A<S>& src, Vec3A<S>& dst) const IMATH_NOEXCEPT;
+
+    /// Vector-matrix multiplication of a padded and aligned direction,
+    /// as multDirMatrix() of a Vec3 does, and with SIMD like the
+    /// Vec3A multVecMatrix().
+    template <class S>
+    IMATH_HOSTDEVICE void
+    multDirMatrix (const Vec3A<S>& src, Vec3A<S>& dst) const IMATH_NOEXCEPT;
+
+    /// Vector-matrix multiplication of an array of padded and aligned
+    /// points, as the Vec3A multVecMatrix() does.
+    /// @param[in] src The input points
+    /// @param[out] dst The output points; may be the same array as `src`
+    /// @param[in] n The number of points
+    template <class S>
+    IMATH_HOSTDEVICE void multVecMatrix (
+        const Vec3A<S>* src, Vec3A<S>* dst, size_t n) const IMATH_NOEXCEPT;
+
+    /// Vector-matrix multiplication of an array of padded and aligned
+    /// directions, as the Vec3A multDirMatrix() does.
+    /// @param[in] src The input vectors
+    /// @param[out] dst The output vectors; may be the same array as `src`
+    /// @param[in] n The number of vectors
+    template <class S>
+    IMATH_HOSTDEVICE void multDirMatrix (
+        const Vec3A<S>* src, Vec3A<S>* dst, size_t n) const IMATH_NOEXCEPT;
+
     /// @}
 
     /// @{
@@ -1145,6 +1239,32 @@ public:
     /// unmodified Significantly slower but more accurate than inverse().
     IMATH_HOSTDEVICE Matrix44<T> gjInverse () const IMATH_NOEXCEPT;
 
+    /// Return the inverse of an affine matrix, leaving this
+    /// unmodified. The last column is assumed to be (0 0 0 1) and is
+    /// not checked; inverse() checks it and calls this when it holds.
+    /// @param singExc If true, throw an exception if the matrix cannot be inverted.
+    IMATH_CONSTEXPR14 Matrix44<T> inverseAffine (bool singExc) const;
+
+    /// Return the inverse of an affine matrix, leaving this
+    /// unmodified. The last column is assumed to be (0 0 0 1) and is
+    /// not checked. Returns the identity if the matrix is singular.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 Matrix44<T>
+                                       inverseAffine () const IMATH_NOEXCEPT;
+
+    /// Return the inverse of a rigid transformation, leaving this
+    /// unmodified. The upper 3x3 is assumed to be orthonormal (a
+    /// rotation, possibly with a reflection) and the last column to
+    /// be (0 0 0 1); neither is checked. The rotation is transposed
+    /// and the translation is rotated back and negated.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 Matrix44<T>
+                                       inverseRigid () const IMATH_NOEXCEPT;
+
+    /// Return the inverse of an orthonormal matrix, which is its
+    /// transpose. The matrix is assumed to be orthonormal and is not
+    /// checked; for a rotation with a translation use inverseRigid().
+    IMATH_HOSTDEVICE constexpr Matrix44<T>
+                               inverseOrthonormal () const IMATH_NOEXCEPT;
+
     /// Calculate the matrix minor of the (r,c) element
     IMATH_HOSTDEVICE IMATH_CONSTEXPR14 T
     minorOf (const int r, const int c) const IMATH_NOEXCEPT;
@@ -1366,6 +1486,16 @@ template <class S, class T>
 IMATH_HOSTDEVICE inline Vec3<S>
 operator* (const Vec3<S>& v, const Matrix44<T>& m) IMATH_NOEXCEPT;
 
+/// Vector-matrix multiplication: v *= m
+template <class S, class T>
+IMATH_HOSTDEVICE inline const Vec3A<S>&
+operator*= (Vec3A<S>& v, const Matrix44<T>& m) IMATH_NOEXCEPT;
+
+/// Vector-matrix multiplication: r = v * m
+template <class S, class T>
+IMATH_HOSTDEVICE inline Vec3A<S>
+operator* (const Vec3A<S>& v, const Matrix44<T>& m) IMATH_NOEXCEPT;
+
 /// Vector-matrix multiplication: v *= m
 template <class S, class T>
 IMATH_HOSTDEVICE inline const Vec4<S>&
@@ -1376,6 +1506,27 @@ template <class S, class T>
 IMATH_HOSTDEVICE inline Vec4<S>
 operator* (const Vec4<S>& v, const Matrix44<T>& m) IMATH_NOEXCEPT;
 
+/// Invert each of the `n` affine matrices in `src` as
+/// Matrix44::inverseAffine() does, writing the results to `dst`.
+/// `src` and `dst` may be the same array.
+template <class T>
+IMATH_HOSTDEVICE void inverseAffine (
+    const Matrix44<T>* src, Matrix44<T>* dst, size_t n) IMATH_NOEXCEPT;
+
+/// Invert each of the `n` rigid transformations in `src` as
+/// Matrix44::inverseRigid() does, writing the results to `dst`.
+/// `src` and `dst` may be the same array.
+template <class T>
+IMATH_HOSTDEVICE void inverseRigid (
+    const Matrix44<T>* src, Matrix44<T>* dst, size_t n) IMATH_NOEXCEPT;
+
+/// Invert each of the `n` orthonormal matrices in `src` as
+/// Matrix44::inverseOrthonormal() does, writing the results to `dst`.
+/// `src` and `dst` may be the same array.
+template <class T>
+IMATH_HOSTDEVICE void inverseOrthonormal (
+    const Matrix44<T>* src, Matrix44<T>* dst, size_t n) IMATH_NOEXCEPT;
+
 //-------------------------
 // Typedefs for convenience
 //-------------------------
@@ -1398,6 +1549,307 @@ typedef Matrix44<float> M44f;
 /// 4x4 matrix of double
 typedef Matrix44<double> M44d;
 
+#if defined(IMATH_SIMD_SSE2) || defined(IMATH_SIMD_NEON)
+
+/// @cond Doxygen_Suppress
+
+//-----------------------------------------------------------------------
+// Matrix44 multiplication kernels for IMATH_ENABLE_SIMD
+//
+// simdMultiply (a, b, c) computes c = a * b and returns true, or
+// returns false if there is no kernel for the element type. There are
+// only float kernels; for double, compilers already generate code from
+// the scalar version that is as fast. Each element of c is summed in
+// the same order as the scalar code and no fused multiply-add is used,
+// so the results match unless the compiler contracts the scalar code.
+// c must not be a or b.
+//-----------------------------------------------------------------------
+
+template <class T>
+inline bool
+simdMultiply (
+    const T (&)[4][4], const T (&)[4][4], T (&)[4][4]) IMATH_NOEXCEPT
+{
+    return false;
+}
+
+#    if defined(IMATH_SIMD_SSE2)
+
+#        if defined(__AVX__)
+
+//
+// Two rows of c at a time: each 128-bit half of the registers holds
+// one row, and the elements of a are broadcast within each half.
+//
+
+inline bool
+simdMultiply (
+    const float (&a)[4][4], const float (&b)[4][4], float (&c)[4][4])
+    IMATH_NOEXCEPT
+{
+    const __m256 b0 =
+        _mm256_broadcast_ps (reinterpret_cast<const __m128*> (b[0]));
+    const __m256 b1 =
+        _mm256_broadcast_ps (reinterpret_cast<const __m128*> (b[1]));
+    const __m256 b2 =
+        _mm256_broadcast_ps (reinterpret_cast<const __m128*> (b[2]));
+    const __m256 b3 =
+        _mm256_broadcast_ps (reinterpret_cast<const __m128*> (b[3]));
+
+    for (int i = 0; i < 4; i += 2)
+    {
+        const __m256 ai = _mm256_loadu_ps (a[i]);
+
+        __m256 r = _mm256_mul_ps (_mm256_shuffle_ps (ai, ai, 0x00), b0);
+        r = _mm256_add_ps (
+            r, _mm256_mul_ps (_mm256_shuffle_ps (ai, ai, 0x55), b1));
+        r = _mm256_add_ps (
+            r, _mm256_mul_ps (_mm256_shuffle_ps (ai, ai, 0xaa), b2));
+        r = _mm256_add_ps (
+            r, _mm256_mul_ps (_mm256_shuffle_ps (ai, ai, 0xff), b3));
+        _mm256_storeu_ps (c[i], r);
+    }
+
+    return true;
+}
+
+#        else
+
+inline bool
+simdMultiply (
+    const float (&a)[4][4], const float (&b)[4][4], float (&c)[4][4])
+    IMATH_NOEXCEPT
+{
+    const __m128 b0 = _mm_loadu_ps (b[0]);
+    const __m128 b1 = _mm_loadu_ps (b[1]);
+    const __m128 b2 = _mm_loadu_ps (b[2]);
+    const __m128 b3 = _mm_loadu_ps (b[3]);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        const __m128 ai = _mm_loadu_ps (a[i]);
+
+        __m128 r = _mm_mul_ps (_mm_shuffle_ps (ai, ai, 0x00), b0);
+        r = _mm_add_ps (r, _mm_mul_ps (_mm_shuffle_ps (ai, ai, 0x55), b1));
+        r = _mm_add_ps (r, _mm_mul_ps (_mm_shuffle_ps (ai, ai, 0xaa), b2));
+        r = _mm_add_ps (r, _mm_mul_ps (_mm_shuffle_ps (ai, ai, 0xff), b3));
+        _mm_storeu_ps (c[i], r);
+    }
+
+    return true;
+}
+
+#        endif
+
+#    elif defined(IMATH_SIMD_NEON)
+
+//
+// vmulq_n and vaddq rather than vmlaq or vfmaq, which may be fused.
+//
+
+inline bool
+simdMultiply (
+    const float (&a)[4][4], const float (&b)[4][4], float (&c)[4][4])
+    IMATH_NOEXCEPT
+{
+    const float32x4_t b0 = vld1q_f32 (b[0]);
+    const float32x4_t b1 = vld1q_f32 (b[1]);
+    const float32x4_t b2 = vld1q_f32 (b[2]);
+    const float32x4_t b3 = vld1q_f32 (b[3]);
+
+    for (int i = 0; i < 4; ++i)
+    {
+        float32x4_t r = vmulq_n_f32 (b0, a[i][0]);
+        r             = vaddq_f32 (r, vmulq_n_f32 (b1, a[i][1]));
+        r             = vaddq_f32 (r, vmulq_n_f32 (b2, a[i][2]));
+        r             = vaddq_f32 (r, vmulq_n_f32 (b3, a[i][3]));
+        vst1q_f32 (c[i], r);
+    }
+
+    return true;
+}
+
+#    endif
+
+//-----------------------------------------------------------------------
+// Vec3A transform kernels for IMATH_ENABLE_SIMD
+//
+// simdMultVecMatrix (m, src, dst, n, divide) transforms the n points
+// in src by m as Matrix44::multVecMatrix() does, dividing by w only
+// if divide is true, and simdMultDirMatrix (m, src, dst, n) transforms
+// directions as multDirMatrix() does. They return true, or false if
+// there is no kernel for the element types. There are only float
+// kernels; for double, the scalar code is as fast. Each result is
+// computed in one SIMD register and stored as a whole, padding
+// included, and each lane is summed in the same order as the scalar
+// code, without fused multiply-add, so the results are the same. The
+// loads and stores are unaligned ones, which cost nothing extra on
+// aligned data, because containers need not honor the alignment of
+// Vec3A before C++17. dst may be the same array as src.
+//-----------------------------------------------------------------------
+
+template <class T, class S>
+inline bool
+simdMultVecMatrix (
+    const T (&)[4][4], const Vec3A<S>*, Vec3A<S>*, size_t, bool) IMATH_NOEXCEPT
+{
+    return false;
+}
+
+template <class T, class S>
+inline bool
+simdMultDirMatrix (
+    const T (&)[4][4], const Vec3A<S>*, Vec3A<S>*, size_t) IMATH_NOEXCEPT
+{
+    return false;
+}
+
+#    if defined(IMATH_SIMD_SSE2)
+
+//
+// v * m for a direction. With AVX, the elements of v are broadcast
+// from memory, which needs no shuffles.
+//
+
+inline __m128
+simdMultDir (
+    const Vec3A<float>& v, __m128 m0, __m128 m1, __m128 m2) IMATH_NOEXCEPT
+{
+#        if defined(__AVX__)
+    __m128 r = _mm_mul_ps (_mm_broadcast_ss (&v.x), m0);
+    r        = _mm_add_ps (r, _mm_mul_ps (_mm_broadcast_ss (&v.y), m1));
+    return _mm_add_ps (r, _mm_mul_ps (_mm_broadcast_ss (&v.z), m2));
+#        else
+    const __m128 a = _mm_loadu_ps (&v.x);
+
+    __m128 r = _mm_mul_ps (_mm_shuffle_ps (a, a, 0x00), m0);
+    r        = _mm_add_ps (r, _mm_mul_ps (_mm_shuffle_ps (a, a, 0x55), m1));
+    return _mm_add_ps (r, _mm_mul_ps (_mm_shuffle_ps (a, a, 0xaa), m2));
+#        endif
+}
+
+inline bool
+simdMultVecMatrix (
+    const float (&m)[4][4],
+    const Vec3A<float>* src,
+    Vec3A<float>*       dst,
+    size_t              n,
+    bool                divide) IMATH_NOEXCEPT
+{
+    const __m128 m0 = _mm_loadu_ps (m[0]);
+    const __m128 m1 = _mm_loadu_ps (m[1]);
+    const __m128 m2 = _mm_loadu_ps (m[2]);
+    const __m128 m3 = _mm_loadu_ps (m[3]);
+
+    if (divide)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            __m128 r = _mm_add_ps (simdMultDir (src[i], m0, m1, m2), m3);
+            r        = _mm_div_ps (r, _mm_shuffle_ps (r, r, 0xff));
+            _mm_storeu_ps (&dst[i].x, r);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            __m128 r = _mm_add_ps (simdMultDir (src[i], m0, m1, m2), m3);
+            _mm_storeu_ps (&dst[i].x, r);
+        }
+    }
+
+    return true;
+}
+
+inline bool
+simdMultDirMatrix (
+    const float (&m)[4][4],
+    const Vec3A<float>* src,
+    Vec3A<float>*       dst,
+    size_t              n) IMATH_NOEXCEPT
+{
+    const __m128 m0 = _mm_loadu_ps (m[0]);
+    const __m128 m1 = _mm_loadu_ps (m[1]);
+    const __m128 m2 = _mm_loadu_ps (m[2]);
+
+    for (size_t i = 0; i < n; ++i)
+        _mm_storeu_ps (&dst[i].x, simdMultDir (src[i], m0, m1, m2));
+
+    return true;
+}
+
+#    elif defined(IMATH_SIMD_NEON)
+
+inline float32x4_t
+simdMultDir (
+    const Vec3A<float>& v,
+    float32x4_t         m0,
+    float32x4_t         m1,
+    float32x4_t         m2) IMATH_NOEXCEPT
+{
+    float32x4_t r = vmulq_n_f32 (m0, v.x);
+    r             = vaddq_f32 (r, vmulq_n_f32 (m1, v.y));
+    return vaddq_f32 (r, vmulq_n_f32 (m2, v.z));
+}
+
+inline bool
+simdMultVecMatrix (
+    const float (&m)[4][4],
+    const Vec3A<float>* src,
+    Vec3A<float>*       dst,
+    size_t              n,
+    bool                divide) IMATH_NOEXCEPT
+{
+    const float32x4_t m0 = vld1q_f32 (m[0]);
+    const float32x4_t m1 = vld1q_f32 (m[1]);
+    const float32x4_t m2 = vld1q_f32 (m[2]);
+    const float32x4_t m3 = vld1q_f32 (m[3]);
+
+    if (divide)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            float32x4_t r = vaddq_f32 (simdMultDir (src[i], m0, m1, m2), m3);
+            r             = vdivq_f32 (r, vdupq_laneq_f32 (r, 3));
+            vst1q_f32 (&dst[i].x, r);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            float32x4_t r = vaddq_f32 (simdMultDir (src[i], m0, m1, m2), m3);
+            vst1q_f32 (&dst[i].x, r);
+        }
+    }
+
+    return true;
+}
+
+inline bool
+simdMultDirMatrix (
+    const float (&m)[4][4],
+    const Vec3A<float>* src,
+    Vec3A<float>*       dst,
+    size_t              n) IMATH_NOEXCEPT
+{
+    const float32x4_t m0 = vld1q_f32 (m[0]);
+    const float32x4_t m1 = vld1q_f32 (m[1]);
+    const float32x4_t m2 = vld1q_f32 (m[2]);
+
+    for (size_t i = 0; i < n; ++i)
+        vst1q_f32 (&dst[i].x, simdMultDir (src[i], m0, m1, m2));
+
+    return true;
+}
+
+#    endif
+
+/// @endcond
+
+#endif // IMATH_SIMD_SSE2 || IMATH_SIMD_NEON
+
 //---------------------------
 // Implementation of Matrix22
 //---------------------------
@@ -4019,6 +4471,18 @@ template <class T>
 IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const Matrix44<T>&
 Matrix44<T>::operator*= (const Matrix44<T>& v) IMATH_NOEXCEPT
 {
+#if defined(IMATH_SIMD_SSE2) || defined(IMATH_SIMD_NEON)
+    if (!IMATH_IS_CONSTANT_EVALUATED ())
+    {
+        Matrix44 c (IMATH_INTERNAL_NAMESPACE::UNINITIALIZED);
+        if (simdMultiply (x, v.x, c.x))
+        {
+            *this = c;
+            return *this;
+        }
+    }
+#endif
+
     *this = multiply (*this, v);
     return *this;
 }
@@ -4027,6 +4491,16 @@ template <class T>
 IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Matrix44<T>
 Matrix44<T>::operator* (const Matrix44<T>& v) const IMATH_NOEXCEPT
 {
+#if defined(IMATH_SIMD_SSE2) || defined(IMATH_SIMD_NEON)
+    if (!IMATH_IS_CONSTANT_EVALUATED ())
+    {
+        Matrix44 c (IMATH_INTERNAL_NAMESPACE::UNINITIALIZED);
+        if (!simdMultiply (x, v.x, c.x))
+            c = multiply (*this, v);
+        return c;
+    }
+#endif
+
     return multiply (*this, v);
 }
 
@@ -4035,6 +4509,15 @@ IMATH_HOSTDEVICE inline void
 Matrix44<T>::multiply (
     const Matrix44<T>& a, const Matrix44<T>& b, Matrix44<T>& c) IMATH_NOEXCEPT
 {
+#if defined(IMATH_SIMD_SSE2) || defined(IMATH_SIMD_NEON)
+    Matrix44 tmp (IMATH_INTERNAL_NAMESPACE::UNINITIALIZED);
+    if (simdMultiply (a.x, b.x, tmp.x))
+    {
+        c = tmp;
+        return;
+    }
+#endif
+
     c = multiply (a, b);
 }
 
@@ -4073,6 +4556,284 @@ Matrix44<T>::multDirMatrix (const Vec3<S>& src, Vec3<S>& dst) const
     dst.z = c;
 }
 
+//
+// The array versions of multVecMatrix() and multDirMatrix() copy the
+// matrix into locals and decide once whether the homogeneous divide
+// is needed, leaving loop bodies without branches or aliasing
+// concerns that the compiler can vectorize. The arithmetic matches
+// the single-vector versions term for term, so results agree to within
+// rounding; they are identical unless the compiler contracts the terms
+// into fused multiply-adds differently in the two versions.
+//
+
+/// @cond Doxygen_Suppress
+
+template <class T, class V>
+IMATH_HOSTDEVICE inline void
+multVecMatrixArray (
+    const T (&m)[4][4], const V* src, V* dst, size_t n) IMATH_NOEXCEPT
+{
+    typedef typename V::BaseType S;
+
+    const T m00 = m[0][0], m01 = m[0][1], m02 = m[0][2], m03 = m[0][3];
+    const T m10 = m[1][0], m11 = m[1][1], m12 = m[1][2], m13 = m[1][3];
+    const T m20 = m[2][0], m21 = m[2][1], m22 = m[2][2], m23 = m[2][3];
+    const T m30 = m[3][0], m31 = m[3][1], m32 = m[3][2], m33 = m[3][3];
+
+    if (m03 == 0 && m13 == 0 && m23 == 0 && m33 == 1)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const S sx = src[i].x, sy = src[i].y, sz = src[i].z;
+
+            dst[i].x = sx * m00 + sy * m10 + sz * m20 + m30;
+            dst[i].y = sx * m01 + sy * m11 + sz * m21 + m31;
+            dst[i].z = sx * m02 + sy * m12 + sz * m22 + m32;
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const S sx = src[i].x, sy = src[i].y, sz = src[i].z;
+
+            S a = sx * m00 + sy * m10 + sz * m20 + m30;
+            S b = sx * m01 + sy * m11 + sz * m21 + m31;
+            S c = sx * m02 + sy * m12 + sz * m22 + m32;
+            S w = sx * m03 + sy * m13 + sz * m23 + m33;
+
+            dst[i].x = a / w;
+            dst[i].y = b / w;
+            dst[i].z = c / w;
+        }
+    }
+}
+
+template <class T, class V>
+IMATH_HOSTDEVICE inline void
+multDirMatrixArray (
+    const T (&m)[4][4], const V* src, V* dst, size_t n) IMATH_NOEXCEPT
+{
+    typedef typename V::BaseType S;
+
+    const T m00 = m[0][0], m01 = m[0][1], m02 = m[0][2];
+    const T m10 = m[1][0], m11 = m[1][1], m12 = m[1][2];
+    const T m20 = m[2][0], m21 = m[2][1], m22 = m[2][2];
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const S sx = src[i].x, sy = src[i].y, sz = src[i].z;
+
+        dst[i].x = sx * m00 + sy * m10 + sz * m20;
+        dst[i].y = sx * m01 + sy * m11 + sz * m21;
+        dst[i].z = sx * m02 + sy * m12 + sz * m22;
+    }
+}
+
+/// @endcond
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE inline void
+Matrix44<T>::multVecMatrix (const Vec3<S>* src, Vec3<S>* dst, size_t n) const
+    IMATH_NOEXCEPT
+{
+    multVecMatrixArray (x, src, dst, n);
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE inline void
+Matrix44<T>::multVecMatrix (
+    const S* srcX,
+    const S* srcY,
+    const S* srcZ,
+    S*       dstX,
+    S*       dstY,
+    S*       dstZ,
+    size_t   n) const IMATH_NOEXCEPT
+{
+    const T m00 = x[0][0], m01 = x[0][1], m02 = x[0][2], m03 = x[0][3];
+    const T m10 = x[1][0], m11 = x[1][1], m12 = x[1][2], m13 = x[1][3];
+    const T m20 = x[2][0], m21 = x[2][1], m22 = x[2][2], m23 = x[2][3];
+    const T m30 = x[3][0], m31 = x[3][1], m32 = x[3][2], m33 = x[3][3];
+
+    const bool affine = m03 == 0 && m13 == 0 && m23 == 0 && m33 == 1;
+
+    //
+    // With three input and three output arrays that may alias, the
+    // compiler cannot vectorize a single loop, so compute each block
+    // into local arrays and copy those out afterwards.
+    //
+
+    const size_t block = 64;
+    S            tx[block], ty[block], tz[block];
+
+    for (size_t j = 0; j < n; j += block)
+    {
+        const size_t m = (n - j < block) ? n - j : block;
+
+        if (affine)
+        {
+            for (size_t i = 0; i < m; ++i)
+            {
+                const S sx = srcX[j + i], sy = srcY[j + i], sz = srcZ[j + i];
+
+                tx[i] = sx * m00 + sy * m10 + sz * m20 + m30;
+                ty[i] = sx * m01 + sy * m11 + sz * m21 + m31;
+                tz[i] = sx * m02 + sy * m12 + sz * m22 + m32;
+            }
+        }
+        else
+        {
+            for (size_t i = 0; i < m; ++i)
+            {
+                const S sx = srcX[j + i], sy = srcY[j + i], sz = srcZ[j + i];
+
+                S a = sx * m00 + sy * m10 + sz * m20 + m30;
+                S b = sx * m01 + sy * m11 + sz * m21 + m31;
+                S c = sx * m02 + sy * m12 + sz * m22 + m32;
+                S w = sx * m03 + sy * m13 + sz * m23 + m33;
+
+                tx[i] = a / w;
+                ty[i] = b / w;
+                tz[i] = c / w;
+            }
+        }
+
+        for (size_t i = 0; i < m; ++i)
+            dstX[j + i] = tx[i];
+        for (size_t i = 0; i < m; ++i)
+            dstY[j + i] = ty[i];
+        for (size_t i = 0; i < m; ++i)
+            dstZ[j + i] = tz[i];
+    }
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE inline void
+Matrix44<T>::multDirMatrix (const Vec3<S>* src, Vec3<S>* dst, size_t n) const
+    IMATH_NOEXCEPT
+{
+    multDirMatrixArray (x, src, dst, n);
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE inline void
+Matrix44<T>::multDirMatrix (
+    const S* srcX,
+    const S* srcY,
+    const S* srcZ,
+    S*       dstX,
+    S*       dstY,
+    S*       dstZ,
+    size_t   n) const IMATH_NOEXCEPT
+{
+    const T m00 = x[0][0], m01 = x[0][1], m02 = x[0][2];
+    const T m10 = x[1][0], m11 = x[1][1], m12 = x[1][2];
+    const T m20 = x[2][0], m21 = x[2][1], m22 = x[2][2];
+
+    // blocked for the same reason as multVecMatrix() above
+    const size_t block = 64;
+    S            tx[block], ty[block], tz[block];
+
+    for (size_t j = 0; j < n; j += block)
+    {
+        const size_t m = (n - j < block) ? n - j : block;
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            const S sx = srcX[j + i], sy = srcY[j + i], sz = srcZ[j + i];
+
+            tx[i] = sx * m00 + sy * m10 + sz * m20;
+            ty[i] = sx * m01 + sy * m11 + sz * m21;
+            tz[i] = sx * m02 + sy * m12 + sz * m22;
+        }
+
+        for (size_t i = 0; i < m; ++i)
+            dstX[j + i] = tx[i];
+        for (size_t i = 0; i < m; ++i)
+            dstY[j + i] = ty[i];
+        for (size_t i = 0; i < m; ++i)
+            dstZ[j + i] = tz[i];
+    }
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE inline void
+Matrix44<T>::multVecMatrix (const Vec3A<S>& src, Vec3A<S>& dst) const
+    IMATH_NOEXCEPT
+{
+#if defined(IMATH_SIMD_SSE2) || defined(IMATH_SIMD_NEON)
+    if (simdMultVecMatrix (x, &src, &dst, 1, true)) return;
+#endif
+
+    S a, b, c, w;
+
+    a = src.x * x[0][0] + src.y * x[1][0] + src.z * x[2][0] + x[3][0];
+    b = src.x * x[0][1] + src.y * x[1][1] + src.z * x[2][1] + x[3][1];
+    c = src.x * x[0][2] + src.y * x[1][2] + src.z * x[2][2] + x[3][2];
+    w = src.x * x[0][3] + src.y * x[1][3] + src.z * x[2][3] + x[3][3];
+
+    dst.x = a / w;
+    dst.y = b / w;
+    dst.z = c / w;
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE inline void
+Matrix44<T>::multDirMatrix (const Vec3A<S>& src, Vec3A<S>& dst) const
+    IMATH_NOEXCEPT
+{
+#if defined(IMATH_SIMD_SSE2) || defined(IMATH_SIMD_NEON)
+    if (simdMultDirMatrix (x, &src, &dst, 1)) return;
+#endif
+
+    S a, b, c;
+
+    a = src.x * x[0][0] + src.y * x[1][0] + src.z * x[2][0];
+    b = src.x * x[0][1] + src.y * x[1][1] + src.z * x[2][1];
+    c = src.x * x[0][2] + src.y * x[1][2] + src.z * x[2][2];
+
+    dst.x = a;
+    dst.y = b;
+    dst.z = c;
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE inline void
+Matrix44<T>::multVecMatrix (const Vec3A<S>* src, Vec3A<S>* dst, size_t n) const
+    IMATH_NOEXCEPT
+{
+#if defined(IMATH_SIMD_SSE2) || defined(IMATH_SIMD_NEON)
+    // skip the divide for affine matrices, as multVecMatrixArray() does
+    const bool affine =
+        x[0][3] == 0 && x[1][3] == 0 && x[2][3] == 0 && x[3][3] == 1;
+
+    if (simdMultVecMatrix (x, src, dst, n, !affine)) return;
+#endif
+
+    multVecMatrixArray (x, src, dst, n);
+}
+
+template <class T>
+template <class S>
+IMATH_HOSTDEVICE inline void
+Matrix44<T>::multDirMatrix (const Vec3A<S>* src, Vec3A<S>* dst, size_t n) const
+    IMATH_NOEXCEPT
+{
+#if defined(IMATH_SIMD_SSE2) || defined(IMATH_SIMD_NEON)
+    if (simdMultDirMatrix (x, src, dst, n)) return;
+#endif
+
+    multDirMatrixArray (x, src, dst, n);
+}
+
 template <class T>
 IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const Matrix44<T>&
 Matrix44<T>::operator/= (T a) IMATH_NOEXCEPT
@@ -4399,6 +5160,23 @@ Matrix44<T>::inverse (bool singExc) const
     if (x[0][3] != 0 || x[1][3] != 0 || x[2][3] != 0 || x[3][3] != 1)
         return gjInverse (singExc);
 
+    return inverseAffine (singExc);
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Matrix44<T>
+                 Matrix44<T>::inverse () const IMATH_NOEXCEPT
+{
+    if (x[0][3] != 0 || x[1][3] != 0 || x[2][3] != 0 || x[3][3] != 1)
+        return gjInverse ();
+
+    return inverseAffine ();
+}
+
+template <class T>
+IMATH_CONSTEXPR14 inline Matrix44<T>
+Matrix44<T>::inverseAffine (bool singExc) const
+{
     Matrix44 s (
         x[1][1] * x[2][2] - x[2][1] * x[1][2],
         x[2][1] * x[0][2] - x[0][1] * x[2][2],
@@ -4469,11 +5247,8 @@ Matrix44<T>::inverse (bool singExc) const
 
 template <class T>
 IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Matrix44<T>
-                 Matrix44<T>::inverse () const IMATH_NOEXCEPT
+                 Matrix44<T>::inverseAffine () const IMATH_NOEXCEPT
 {
-    if (x[0][3] != 0 || x[1][3] != 0 || x[2][3] != 0 || x[3][3] != 1)
-        return gjInverse ();
-
     Matrix44 s (
         x[1][1] * x[2][2] - x[2][1] * x[1][2],
         x[2][1] * x[0][2] - x[0][1] * x[2][2],
@@ -4538,6 +5313,41 @@ IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Matrix44<T>
     return s;
 }
 
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Matrix44<T>
+                 Matrix44<T>::inverseRigid () const IMATH_NOEXCEPT
+{
+    const T tx = x[3][0], ty = x[3][1], tz = x[3][2];
+
+    return Matrix44 (
+        x[0][0],
+        x[1][0],
+        x[2][0],
+        0,
+
+        x[0][1],
+        x[1][1],
+        x[2][1],
+        0,
+
+        x[0][2],
+        x[1][2],
+        x[2][2],
+        0,
+
+        -(tx * x[0][0] + ty * x[0][1] + tz * x[0][2]),
+        -(tx * x[1][0] + ty * x[1][1] + tz * x[1][2]),
+        -(tx * x[2][0] + ty * x[2][1] + tz * x[2][2]),
+        1);
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Matrix44<T>
+Matrix44<T>::inverseOrthonormal () const IMATH_NOEXCEPT
+{
+    return transposed ();
+}
+
 template <class T>
 IMATH_HOSTDEVICE constexpr inline T
 Matrix44<T>::fastMinor (
@@ -5153,6 +5963,23 @@ operator* (const Vec3<S>& v, const Matrix44<T>& m) IMATH_NOEXCEPT
     return Vec3<S> (x / w, y / w, z / w);
 }
 
+template <class S, class T>
+IMATH_HOSTDEVICE inline const Vec3A<S>&
+operator*= (Vec3A<S>& v, const Matrix44<T>& m) IMATH_NOEXCEPT
+{
+    m.multVecMatrix (v, v);
+    return v;
+}
+
+template <class S, class T>
+IMATH_HOSTDEVICE inline Vec3A<S>
+operator* (const Vec3A<S>& v, const Matrix44<T>& m) IMATH_NOEXCEPT
+{
+    Vec3A<S> r;
+    m.multVecMatrix (v, r);
+    return r;
+}
+
 template <class S, class T>
 IMATH_HOSTDEVICE inline const Vec4<S>& IMATH_HOSTDEVICE
 operator*= (Vec4<S>& v, const Matrix44<T>& m) IMATH_NOEXCEPT
@@ -5190,6 +6017,37 @@ operator* (const Vec4<S>& v, const Matrix44<T>& m) IMATH_NOEXCEPT
     return Vec4<S> (x, y, z, w);
 }
 
+//----------------------------------
+// Implementation of batch inverses
+//----------------------------------
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+inverseAffine (const Matrix44<T>* src, Matrix44<T>* dst, size_t n)
+    IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = src[i].inverseAffine ();
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+inverseRigid (const Matrix44<T>* src, Matrix44<T>* dst, size_t n)
+    IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = src[i].inverseRigid ();
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+inverseOrthonormal (const Matrix44<T>* src, Matrix44<T>* dst, size_t n)
+    IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = src[i].inverseOrthonormal ();
+}
+
 IMATH_INTERNAL_NAMESPACE_HEADER_EXIT
 
 #endif // INCLUDED_IMATHMATRIX_H
@@ -68,6 +68,95 @@ private:
     double _correction;
 };
 
+// Solves the Procrustes problem from the weighted centroids of the two point
+// sets, C = sum w * (B - Bcenter) * (A - Acenter)^T, and, if doScale is
+// true, traceATA = sum w * |A - Acenter|^2.
+M44d
+procrustesFromMoments (
+    const V3d&   Acenter,
+    const V3d&   Bcenter,
+    const M33d&  C,
+    const double traceATA,
+    const bool   doScale)
+{
+    M33d U, V;
+    V3d  S;
+    jacobiSVD (C, U, S, V, std::numeric_limits<double>::epsilon (), true);
+
+    // We want Q.transposed() here since we are going to be using it in the
+    // Imath style (multiplying vectors on the right, v' = v*A^T):
+    const M33d Qt = V * U.transposed ();
+
+    double s = 1.0;
+    if (doScale)
+    {
+        // Finding a uniform scale: let us assume the Q is completely fixed
+        // at this point (solving for both simultaneously seems much harder).
+        // We are trying to compute (again, per Golub and van Loan)
+        //    min || s*A*Q - B ||_F
+        // Notice that we've jammed a uniform scale in front of the Q.
+        // Now, the Frobenius norm (the least squares norm over matrices)
+        // has the neat property that it is equivalent to minimizing the trace
+        // of M^T*M (see your friendly neighborhood linear algebra text for a
+        // derivation).  Thus, we can expand this out as
+        //   min tr (s*A*Q - B)^T*(s*A*Q - B)
+        // = min tr(Q^T*A^T*s*s*A*Q) + tr(B^T*B) - 2*tr(Q^T*A^T*s*B)  by linearity of the trace
+        // = min s^2 tr(A^T*A) + tr(B^T*B) - 2*s*tr(Q^T*A^T*B)        using the fact that the trace is invariant
+        //                                                            under similarity transforms Q*M*Q^T
+        // If we differentiate w.r.t. s and set this to 0, we get
+        // 0 = 2*s*tr(A^T*A) - 2*tr(Q^T*A^T*B)
+        // so
+        // 2*s*tr(A^T*A) = 2*s*tr(Q^T*A^T*B)
+        // s = tr(Q^T*A^T*B) / tr(A^T*A)
+
+        KahanSum traceBATQ;
+        for (int i = 0; i < 3; ++i)
+            for (int j = 0; j < 3; ++j)
+                traceBATQ += Qt[j][i] * C[i][j];
+
+        s = traceBATQ.get () / traceATA;
+    }
+
+    // Q is the rotation part of what we want to return.
+    // The entire transform is:
+    //    (translate origin to Bcenter) * Q * (translate Acenter to origin)
+    //                last                                first
+    // The effect of this on a point is:
+    //    (translate origin to Bcenter) * Q * (translate Acenter to origin) * point
+    //  = (translate origin to Bcenter) * Q * (-Acenter + point)
+    //  = (translate origin to Bcenter) * (-Q*Acenter + Q*point)
+    //  = (translate origin to Bcenter) * (translate Q*Acenter to origin) * Q*point
+    //  = (translate Q*Acenter to Bcenter) * Q*point
+    // So what we want to return is:
+    //    (translate Q*Acenter to Bcenter) * Q
+    //
+    // In block form, this is:
+    //   [ 1 0 0  | ] [       0 ] [ 1 0 0  |  ]   [ 1 0 0  | ] [           |   ]   [                 ]
+    //   [ 0 1 0 tb ] [  s*Q  0 ] [ 0 1 0 -ta ] = [ 0 1 0 tb ] [  s*Q  -s*Q*ta ] = [   Q   tb-s*Q*ta ]
+    //   [ 0 0 1  | ] [       0 ] [ 0 0 1  |  ]   [ 0 0 1  | ] [           |   ]   [                 ]
+    //   [ 0 0 0  1 ] [ 0 0 0 1 ] [ 0 0 0  1  ]   [ 0 0 0  1 ] [ 0 0 0     1   ]   [ 0 0 0    1      ]
+    // (ofc the whole thing is transposed for Imath).
+    const V3d translate = Bcenter - s * Acenter * Qt;
+
+    return M44d (
+        s * Qt.x[0][0],
+        s * Qt.x[0][1],
+        s * Qt.x[0][2],
+        0.0,
+        s * Qt.x[1][0],
+        s * Qt.x[1][1],
+        s * Qt.x[1][2],
+        0.0,
+        s * Qt.x[2][0],
+        s * Qt.x[2][1],
+        s * Qt.x[2][2],
+        0.0,
+        translate.x,
+        translate.y,
+        translate.z,
+        1.0);
+} // procrustesFromMoments
+
 } // namespace
 
 template <typename T>
@@ -137,95 +226,27 @@ procrustesRotationAndTranslation (
         }
     }
 
-    M33d U, V;
-    V3d  S;
-    jacobiSVD (C, U, S, V, std::numeric_limits<double>::epsilon (), true);
-
-    // We want Q.transposed() here since we are going to be using it in the
-    // Imath style (multiplying vectors on the right, v' = v*A^T):
-    const M33d Qt = V * U.transposed ();
-
-    double s = 1.0;
+    double traceATA = 0.0;
     if (doScale && numPoints > 1)
     {
-        // Finding a uniform scale: let us assume the Q is completely fixed
-        // at this point (solving for both simultaneously seems much harder).
-        // We are trying to compute (again, per Golub and van Loan)
-        //    min || s*A*Q - B ||_F
-        // Notice that we've jammed a uniform scale in front of the Q.
-        // Now, the Frobenius norm (the least squares norm over matrices)
-        // has the neat property that it is equivalent to minimizing the trace
-        // of M^T*M (see your friendly neighborhood linear algebra text for a
-        // derivation).  Thus, we can expand this out as
-        //   min tr (s*A*Q - B)^T*(s*A*Q - B)
-        // = min tr(Q^T*A^T*s*s*A*Q) + tr(B^T*B) - 2*tr(Q^T*A^T*s*B)  by linearity of the trace
-        // = min s^2 tr(A^T*A) + tr(B^T*B) - 2*s*tr(Q^T*A^T*B)        using the fact that the trace is invariant
-        //                                                            under similarity transforms Q*M*Q^T
-        // If we differentiate w.r.t. s and set this to 0, we get
-        // 0 = 2*s*tr(A^T*A) - 2*tr(Q^T*A^T*B)
-        // so
-        // 2*s*tr(A^T*A) = 2*s*tr(Q^T*A^T*B)
-        // s = tr(Q^T*A^T*B) / tr(A^T*A)
-
-        KahanSum traceATA;
+        KahanSum sum;
         if (weights == 0)
         {
             for (size_t i = 0; i < numPoints; ++i)
-                traceATA += ((V3d) A[i] - Acenter).length2 ();
+                sum += ((V3d) A[i] - Acenter).length2 ();
         }
         else
         {
             for (size_t i = 0; i < numPoints; ++i)
-                traceATA +=
+                sum +=
                     ((double) weights[i]) * ((V3d) A[i] - Acenter).length2 ();
         }
 
-        KahanSum traceBATQ;
-        for (int i = 0; i < 3; ++i)
-            for (int j = 0; j < 3; ++j)
-                traceBATQ += Qt[j][i] * C[i][j];
-
-        s = traceBATQ.get () / traceATA.get ();
+        traceATA = sum.get ();
     }
 
-    // Q is the rotation part of what we want to return.
-    // The entire transform is:
-    //    (translate origin to Bcenter) * Q * (translate Acenter to origin)
-    //                last                                first
-    // The effect of this on a point is:
-    //    (translate origin to Bcenter) * Q * (translate Acenter to origin) * point
-    //  = (translate origin to Bcenter) * Q * (-Acenter + point)
-    //  = (translate origin to Bcenter) * (-Q*Acenter + Q*point)
-    //  = (translate origin to Bcenter) * (translate Q*Acenter to origin) * Q*point
-    //  = (translate Q*Acenter to Bcenter) * Q*point
-    // So what we want to return is:
-    //    (translate Q*Acenter to Bcenter) * Q
-    //
-    // In block form, this is:
-    //   [ 1 0 0  | ] [       0 ] [ 1 0 0  |  ]   [ 1 0 0  | ] [           |   ]   [                 ]
-    //   [ 0 1 0 tb ] [  s*Q  0 ] [ 0 1 0 -ta ] = [ 0 1 0 tb ] [  s*Q  -s*Q*ta ] = [   Q   tb-s*Q*ta ]
-    //   [ 0 0 1  | ] [       0 ] [ 0 0 1  |  ]   [ 0 0 1  | ] [           |   ]   [                 ]
-    //   [ 0 0 0  1 ] [ 0 0 0 1 ] [ 0 0 0  1  ]   [ 0 0 0  1 ] [ 0 0 0     1   ]   [ 0 0 0    1      ]
-    // (ofc the whole thing is transposed for Imath).
-    const V3d translate = Bcenter - s * Acenter * Qt;
-
-    return M44d (
-        s * Qt.x[0][0],
-        s * Qt.x[0][1],
-        s * Qt.x[0][2],
-        T (0),
-        s * Qt.x[1][0],
-        s * Qt.x[1][1],
-        s * Qt.x[1][2],
-        T (0),
-        s * Qt.x[2][0],
-        s * Qt.x[2][1],
-        s * Qt.x[2][2],
-        T (0),
-        translate.x,
-        translate.y,
-        translate.z,
-        T (1));
+    return procrustesFromMoments (
+        Acenter, Bcenter, C, traceATA, doScale && numPoints > 1);
 } // procrustesRotationAndTranslation
 
 ///
@@ -247,6 +268,15 @@ procrustesRotationAndTranslation (
         A, B, (const T*) 0, numPoints, doScale);
 } // procrustesRotationAndTranslation
 
+M44d
+ProcrustesAccumulator::solve (bool doScaling) const
+{
+    if (_weightsSum == 0) return M44d ();
+
+    return procrustesFromMoments (
+        _Acenter, _Bcenter, _C, _traceATA, doScaling && _numPoints > 1);
+}
+
 /// TODO
 template IMATH_EXPORT M44d procrustesRotationAndTranslation (
     const V3d* from, const V3d* to, const size_t numPoints, const bool doScale);
@@ -668,67 +698,21 @@ maxOffDiag (const IMATH_INTERNAL_NAMESPACE::Matrix44<T>& A)
     return result;
 }
 
+} // namespace
+
+// Reads the singular values off the diagonalized A and brings the
+// decomposition into the canonical form: all singular values positive and
+// sorted from largest to smallest, U and V optionally with positive
+// determinant.
 template <typename T>
 void
-twoSidedJacobiSVD (
-    IMATH_INTERNAL_NAMESPACE::Matrix33<T>  A,
-    IMATH_INTERNAL_NAMESPACE::Matrix33<T>& U,
-    IMATH_INTERNAL_NAMESPACE::Vec3<T>&     S,
-    IMATH_INTERNAL_NAMESPACE::Matrix33<T>& V,
-    const T                                tol,
-    const bool                             forcePositiveDeterminant)
+finishJacobiSVD (
+    const IMATH_INTERNAL_NAMESPACE::Matrix33<T>& A,
+    IMATH_INTERNAL_NAMESPACE::Matrix33<T>&       U,
+    IMATH_INTERNAL_NAMESPACE::Vec3<T>&           S,
+    IMATH_INTERNAL_NAMESPACE::Matrix33<T>&       V,
+    const bool                                   forcePositiveDeterminant)
 {
-    // The two-sided Jacobi SVD works by repeatedly zeroing out
-    // off-diagonal entries of the matrix, 2 at a time.  Basically,
-    // we can take our 3x3 matrix,
-    //    [* * *]
-    //    [* * *]
-    //    [* * *]
-    // and use a pair of orthogonal transforms to zero out, say, the
-    // pair of entries (0, 1) and (1, 0):
-    //  [ c1 s1  ] [* * *] [ c2 s2  ]   [*   *]
-    //  [-s1 c1  ] [* * *] [-s2 c2  ] = [  * *]
-    //  [       1] [* * *] [       1]   [* * *]
-    // When we go to zero out the next pair of entries (say, (0, 2) and (2, 0))
-    // then we don't expect those entries to stay 0:
-    //  [ c1 s1  ] [*   *] [ c2 s2  ]   [* *  ]
-    //  [-s1 c1  ] [  * *] [-s2 c2  ] = [* * *]
-    //  [       1] [* * *] [       1]   [  * *]
-    // However, if we keep doing this, we'll find that the off-diagonal entries
-    // converge to 0 fairly quickly (convergence should be roughly cubic).  The
-    // result is a diagonal A matrix and a bunch of orthogonal transforms:
-    //               [* * *]                [*    ]
-    //  L1 L2 ... Ln [* * *] Rn ... R2 R1 = [  *  ]
-    //               [* * *]                [    *]
-    //  ------------ ------- ------------   -------
-    //      U^T         A         V            S
-    // This turns out to be highly accurate because (1) orthogonal transforms
-    // are extremely stable to compute and apply (this is why QR factorization
-    // works so well, FWIW) and because (2) by applying everything to the original
-    // matrix A instead of computing (A^T * A) we avoid any precision loss that
-    // would result from that.
-    U.makeIdentity ();
-    V.makeIdentity ();
-
-    const int maxIter =
-        20; // In case we get really unlucky, prevents infinite loops
-    const T absTol =
-        tol * maxOffDiag (A); // Tolerance is in terms of the maximum
-    if (absTol != 0)          // _off-diagonal_ entry.
-    {
-        int numIter = 0;
-        do
-        {
-            ++numIter;
-            bool changed = twoSidedJacobiRotation<T, 0, 1, 2> (A, U, V, tol);
-            changed      = twoSidedJacobiRotation<T, 0, 2, 1> (A, U, V, tol) ||
-                      changed;
-            changed = twoSidedJacobiRotation<T, 1, 2, 0> (A, U, V, tol) ||
-                      changed;
-            if (!changed) break;
-        } while (maxOffDiag (A) > absTol && numIter < maxIter);
-    }
-
     // The off-diagonal entries are (effectively) 0, so whatever's left on the
     // diagonal are the singular values:
     S.x = A[0][0];
@@ -798,40 +782,19 @@ twoSidedJacobiSVD (
     }
 }
 
+// Reads the singular values off the diagonalized A and brings the
+// decomposition into the canonical form: all singular values positive and
+// sorted from largest to smallest, U and V optionally with positive
+// determinant.
 template <typename T>
 void
-twoSidedJacobiSVD (
-    IMATH_INTERNAL_NAMESPACE::Matrix44<T>  A,
-    IMATH_INTERNAL_NAMESPACE::Matrix44<T>& U,
-    IMATH_INTERNAL_NAMESPACE::Vec4<T>&     S,
-    IMATH_INTERNAL_NAMESPACE::Matrix44<T>& V,
-    const T                                tol,
-    const bool                             forcePositiveDeterminant)
+finishJacobiSVD (
+    const IMATH_INTERNAL_NAMESPACE::Matrix44<T>& A,
+    IMATH_INTERNAL_NAMESPACE::Matrix44<T>&       U,
+    IMATH_INTERNAL_NAMESPACE::Vec4<T>&           S,
+    IMATH_INTERNAL_NAMESPACE::Matrix44<T>&       V,
+    const bool                                   forcePositiveDeterminant)
 {
-    // Please see the Matrix33 version for a detailed description of the algorithm.
-    U.makeIdentity ();
-    V.makeIdentity ();
-
-    const int maxIter =
-        20; // In case we get really unlucky, prevents infinite loops
-    const T absTol =
-        tol * maxOffDiag (A); // Tolerance is in terms of the maximum
-    if (absTol != 0)          // _off-diagonal_ entry.
-    {
-        int numIter = 0;
-        do
-        {
-            ++numIter;
-            bool changed = twoSidedJacobiRotation (A, 0, 1, U, V, tol);
-            changed = twoSidedJacobiRotation (A, 0, 2, U, V, tol) || changed;
-            changed = twoSidedJacobiRotation (A, 0, 3, U, V, tol) || changed;
-            changed = twoSidedJacobiRotation (A, 1, 2, U, V, tol) || changed;
-            changed = twoSidedJacobiRotation (A, 1, 3, U, V, tol) || changed;
-            changed = twoSidedJacobiRotation (A, 2, 3, U, V, tol) || changed;
-            if (!changed) break;
-        } while (maxOffDiag (A) > absTol && numIter < maxIter);
-    }
-
     // The off-diagonal entries are (effectively) 0, so whatever's left on the
     // diagonal are the singular values:
     S[0] = A[0][0];
@@ -913,6 +876,138 @@ twoSidedJacobiSVD (
     }
 }
 
+// The batch SVD in ImathMatrixAlgoBatch.cpp brings its results into the
+// same form with these instances, rather than compiling its own copies
+// with the flags of that file.
+template void finishJacobiSVD (
+    const Matrix33<float>& A,
+    Matrix33<float>&       U,
+    Vec3<float>&           S,
+    Matrix33<float>&       V,
+    const bool             forcePositiveDeterminant);
+template void finishJacobiSVD (
+    const Matrix33<double>& A,
+    Matrix33<double>&       U,
+    Vec3<double>&           S,
+    Matrix33<double>&       V,
+    const bool              forcePositiveDeterminant);
+template void finishJacobiSVD (
+    const Matrix44<float>& A,
+    Matrix44<float>&       U,
+    Vec4<float>&           S,
+    Matrix44<float>&       V,
+    const bool             forcePositiveDeterminant);
+template void finishJacobiSVD (
+    const Matrix44<double>& A,
+    Matrix44<double>&       U,
+    Vec4<double>&           S,
+    Matrix44<double>&       V,
+    const bool              forcePositiveDeterminant);
+
+namespace
+{
+
+template <typename T>
+void
+twoSidedJacobiSVD (
+    IMATH_INTERNAL_NAMESPACE::Matrix33<T>  A,
+    IMATH_INTERNAL_NAMESPACE::Matrix33<T>& U,
+    IMATH_INTERNAL_NAMESPACE::Vec3<T>&     S,
+    IMATH_INTERNAL_NAMESPACE::Matrix33<T>& V,
+    const T                                tol,
+    const bool                             forcePositiveDeterminant)
+{
+    // The two-sided Jacobi SVD works by repeatedly zeroing out
+    // off-diagonal entries of the matrix, 2 at a time.  Basically,
+    // we can take our 3x3 matrix,
+    //    [* * *]
+    //    [* * *]
+    //    [* * *]
+    // and use a pair of orthogonal transforms to zero out, say, the
+    // pair of entries (0, 1) and (1, 0):
+    //  [ c1 s1  ] [* * *] [ c2 s2  ]   [*   *]
+    //  [-s1 c1  ] [* * *] [-s2 c2  ] = [  * *]
+    //  [       1] [* * *] [       1]   [* * *]
+    // When we go to zero out the next pair of entries (say, (0, 2) and (2, 0))
+    // then we don't expect those entries to stay 0:
+    //  [ c1 s1  ] [*   *] [ c2 s2  ]   [* *  ]
+    //  [-s1 c1  ] [  * *] [-s2 c2  ] = [* * *]
+    //  [       1] [* * *] [       1]   [  * *]
+    // However, if we keep doing this, we'll find that the off-diagonal entries
+    // converge to 0 fairly quickly (convergence should be roughly cubic).  The
+    // result is a diagonal A matrix and a bunch of orthogonal transforms:
+    //               [* * *]                [*    ]
+    //  L1 L2 ... Ln [* * *] Rn ... R2 R1 = [  *  ]
+    //               [* * *]                [    *]
+    //  ------------ ------- ------------   -------
+    //      U^T         A         V            S
+    // This turns out to be highly accurate because (1) orthogonal transforms
+    // are extremely stable to compute and apply (this is why QR factorization
+    // works so well, FWIW) and because (2) by applying everything to the original
+    // matrix A instead of computing (A^T * A) we avoid any precision loss that
+    // would result from that.
+    U.makeIdentity ();
+    V.makeIdentity ();
+
+    const int maxIter =
+        20; // In case we get really unlucky, prevents infinite loops
+    const T absTol =
+        tol * maxOffDiag (A); // Tolerance is in terms of the maximum
+    if (absTol != 0)          // _off-diagonal_ entry.
+    {
+        int numIter = 0;
+        do
+        {
+            ++numIter;
+            bool changed = twoSidedJacobiRotation<T, 0, 1, 2> (A, U, V, tol);
+            changed      = twoSidedJacobiRotation<T, 0, 2, 1> (A, U, V, tol) ||
+                      changed;
+            changed = twoSidedJacobiRotation<T, 1, 2, 0> (A, U, V, tol) ||
+                      changed;
+            if (!changed) break;
+        } while (maxOffDiag (A) > absTol && numIter < maxIter);
+    }
+
+    finishJacobiSVD (A, U, S, V, forcePositiveDeterminant);
+}
+
+template <typename T>
+void
+twoSidedJacobiSVD (
+    IMATH_INTERNAL_NAMESPACE::Matrix44<T>  A,
+    IMATH_INTERNAL_NAMESPACE::Matrix44<T>& U,
+    IMATH_INTERNAL_NAMESPACE::Vec4<T>&     S,
+    IMATH_INTERNAL_NAMESPACE::Matrix44<T>& V,
+    const T                                tol,
+    const bool                             forcePositiveDeterminant)
+{
+    // Please see the Matrix33 version for a detailed description of the algorithm.
+    U.makeIdentity ();
+    V.makeIdentity ();
+
+    const int maxIter =
+        20; // In case we get really unlucky, prevents infinite loops
+    const T absTol =
+        tol * maxOffDiag (A); // Tolerance is in terms of the maximum
+    if (absTol != 0)          // _off-diagonal_ entry.
+    {
+        int numIter = 0;
+        do
+        {
+            ++numIter;
+            bool changed = twoSidedJacobiRotation (A, 0, 1, U, V, tol);
+            changed = twoSidedJacobiRotation (A, 0, 2, U, V, tol) || changed;
+            changed = twoSidedJacobiRotation (A, 0, 3, U, V, tol) || changed;
+            changed = twoSidedJacobiRotation (A, 1, 2, U, V, tol) || changed;
+            changed = twoSidedJacobiRotation (A, 1, 3, U, V, tol) || changed;
+            changed = twoSidedJacobiRotation (A, 2, 3, U, V, tol) || changed;
+            if (!changed) break;
+        } while (maxOffDiag (A) > absTol && numIter < maxIter);
+    }
+
+    finishJacobiSVD (A, U, S, V, forcePositiveDeterminant);
+}
+
 } // namespace
 
 /// TODO
@@ -19,6 +19,7 @@
 #include "ImathNamespace.h"
 #include "ImathQuat.h"
 #include "ImathVec.h"
+#include <cstddef>
 #include <math.h>
 
 IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
@@ -181,6 +182,110 @@ template <class T> void extractEulerZYX (const Matrix44<T>& mat, Vec3<T>& rot);
 /// @return The extracted quaternion
 template <class T> Quat<T> extractQuat (const Matrix44<T>& mat);
 
+/// Extract the rotation from each of `n` 4x4 matrices in the form of a
+/// quaternion. The results agree with those of extractQuat() for a
+/// single matrix to within rounding, but the choice between its cases
+/// is made with selects rather than branches, so that the work on
+/// several matrices runs side by side in SIMD lanes.
+///
+/// Currently only available for single- and double-precision matrices.
+///
+/// @param[in] mats The input matrices
+/// @param[out] quats The extracted quaternions
+/// @param[in] n The number of matrices
+template <class T>
+void extractQuat (const Matrix44<T>* mats, Quat<T>* quats, size_t n);
+
+/// Extract the rotation from each of `n` 3x3 matrices in the form of a
+/// quaternion, as extractQuat() does for the upper left 3x3 part of a
+/// 4x4 matrix.
+///
+/// @param[in] mats The input matrices
+/// @param[out] quats The extracted quaternions
+/// @param[in] n The number of matrices
+template <class T>
+void extractQuat (const Matrix33<T>* mats, Quat<T>* quats, size_t n);
+
+/// Convert each of `n` unit quaternions to a rotation matrix, as
+/// Quat::toMatrix44() does.
+///
+/// @param[in] quats The input quaternions
+/// @param[out] mats The rotation matrices
+/// @param[in] n The number of quaternions
+template <class T>
+void toMatrix44 (const Quat<T>* quats, Matrix44<T>* mats, size_t n);
+
+/// Convert each of `n` unit quaternions to a rotation matrix, as
+/// Quat::toMatrix33() does.
+///
+/// @param[in] quats The input quaternions
+/// @param[out] mats The rotation matrices
+/// @param[in] n The number of quaternions
+template <class T>
+void toMatrix33 (const Quat<T>* quats, Matrix33<T>* mats, size_t n);
+
+///
+/// A transform made of a scale, a rotation and a translation, applied
+/// in that order: the matrix it represents is `S * R * T`, as in
+/// extractSHRT() without shear. This is a compact form for the poses
+/// of skeletons and scene graph nodes.
+///
+
+template <class T> struct TRS
+{
+    /// The rotation, as a unit quaternion
+    Quat<T> rotation;
+
+    /// The translation
+    Vec3<T> translation;
+
+    /// The scale
+    Vec3<T> scale;
+
+    /// Initialize to the identity transform.
+    TRS () IMATH_NOEXCEPT : translation (0), scale (1) {}
+
+    /// Initialize from a rotation, a translation and a scale.
+    TRS (
+        const Quat<T>& rotation,
+        const Vec3<T>& translation,
+        const Vec3<T>& scale = Vec3<T> (1)) IMATH_NOEXCEPT
+        : rotation (rotation)
+        , translation (translation)
+        , scale (scale)
+    {}
+};
+
+/// TRS of type float
+typedef TRS<float> TRSf;
+
+/// TRS of type double
+typedef TRS<double> TRSd;
+
+/// Convert each of `n` transforms to a 4x4 matrix.
+///
+/// Currently only available for single- and double-precision transforms.
+///
+/// @param[in] trs The input transforms
+/// @param[out] mats The matrices
+/// @param[in] n The number of transforms
+template <class T>
+void toMatrix44 (const TRS<T>* trs, Matrix44<T>* mats, size_t n);
+
+/// Decompose each of `n` 4x4 matrices into a scale, a rotation and a
+/// translation. The scale along each axis is the length of the
+/// corresponding row of the upper left 3x3 part, negated on all three
+/// axes if the matrix flips handedness. The matrices must not contain
+/// shear or a perspective projection; if they do, the result does not
+/// reproduce them. A zero scale gives a zero row in the rotation
+/// part, and the rotation is then not meaningful.
+///
+/// @param[in] mats The input matrices
+/// @param[out] trs The extracted transforms
+/// @param[in] n The number of matrices
+template <class T>
+void extractTRS (const Matrix44<T>* mats, TRS<T>* trs, size_t n);
+
 /// Extract the scaling, shear, rotation, and translation components
 /// of the given 4x4 matrix. The values are such that:
 ///
@@ -1462,6 +1567,175 @@ M44d procrustesRotationAndTranslation (
     const size_t   numPoints,
     const bool     doScaling = false);
 
+///
+/// Accumulates point correspondences one at a time for the Procrustes
+/// problem solved by `procrustesRotationAndTranslation`, so that the
+/// transformation can be computed in a single pass over the data, without
+/// holding the point sets in memory.
+///
+/// Each `add()` updates the weighted centroids of the two point sets and
+/// their cross-covariance in double precision, using centered updates that
+/// stay accurate for points far from the origin.  Accumulators filled from
+/// separate parts of the data, e.g. by different threads, can be combined
+/// with `merge()`; the result does not depend on how the data was split,
+/// up to rounding.
+///
+
+class IMATH_EXPORT ProcrustesAccumulator
+{
+  public:
+    /// Initialize to an empty set of points.
+    ProcrustesAccumulator () IMATH_NOEXCEPT;
+
+    /// Add a point `a` of the "from" set that should map to `b` in the
+    /// "to" set.  Points with zero weight are counted but do not otherwise
+    /// contribute.
+    template <typename T>
+    void add (const Vec3<T>& a, const Vec3<T>& b, T weight = T (1))
+        IMATH_NOEXCEPT;
+
+    /// Add `numPoints` pairs of points from the arrays `A` and `B`, with
+    /// weights from `weights`, or with unit weights if `weights` is null.
+    template <typename T>
+    void add (
+        const Vec3<T>* A,
+        const Vec3<T>* B,
+        const T*       weights,
+        size_t         numPoints) IMATH_NOEXCEPT;
+
+    /// Add all the points of another accumulator.
+    void merge (const ProcrustesAccumulator& other) IMATH_NOEXCEPT;
+
+    /// Remove all points.
+    void clear () IMATH_NOEXCEPT;
+
+    /// Return the number of points added so far.
+    size_t numPoints () const IMATH_NOEXCEPT { return _numPoints; }
+
+    /// Return the sum of the weights of the points added so far.
+    double weightsSum () const IMATH_NOEXCEPT { return _weightsSum; }
+
+    /// Return the transformation that brings the "from" points added so
+    /// far as close as possible to the "to" points; see
+    /// `procrustesRotationAndTranslation`.  Returns the identity if no
+    /// points with non-zero weight have been added.
+    /// @param doScaling If true, include a uniform scale
+    M44d solve (bool doScaling = false) const;
+
+  private:
+    size_t _numPoints;
+    double _weightsSum;
+    V3d    _Acenter;
+    V3d    _Bcenter;
+    M33d   _C;        // sum w * (B - _Bcenter) * (A - _Acenter)^T
+    double _traceATA; // sum w * |A - _Acenter|^2
+};
+
+inline ProcrustesAccumulator::ProcrustesAccumulator () IMATH_NOEXCEPT
+    : _numPoints (0),
+      _weightsSum (0),
+      _Acenter (0.0),
+      _Bcenter (0.0),
+      _C (0.0),
+      _traceATA (0)
+{}
+
+template <typename T>
+inline void
+ProcrustesAccumulator::add (
+    const Vec3<T>& a, const Vec3<T>& b, T weight) IMATH_NOEXCEPT
+{
+    ++_numPoints;
+
+    const double w = weight;
+    if (w == 0) return;
+
+    // Weighted version of Welford's update: move the centroids towards the
+    // new point, and add its contribution measured from the old centroid
+    // of B and the new centroid of A.
+    const double weightsSum = _weightsSum + w;
+    const double f          = w / weightsSum;
+    const V3d    da         = V3d (a) - _Acenter;
+    const V3d    db         = V3d (b) - _Bcenter;
+
+    _Acenter += f * da;
+    _Bcenter += f * db;
+    _weightsSum = weightsSum;
+
+    const V3d wdb = w * db;
+    const V3d ea  = V3d (a) - _Acenter;
+
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            _C[i][j] += wdb[i] * ea[j];
+
+    _traceATA += w * (da ^ ea);
+}
+
+template <typename T>
+inline void
+ProcrustesAccumulator::add (
+    const Vec3<T>* A,
+    const Vec3<T>* B,
+    const T*       weights,
+    size_t         numPoints) IMATH_NOEXCEPT
+{
+    if (weights)
+    {
+        for (size_t i = 0; i < numPoints; ++i)
+            add (A[i], B[i], weights[i]);
+    }
+    else
+    {
+        for (size_t i = 0; i < numPoints; ++i)
+            add (A[i], B[i]);
+    }
+}
+
+inline void
+ProcrustesAccumulator::merge (
+    const ProcrustesAccumulator& other) IMATH_NOEXCEPT
+{
+    if (other._weightsSum == 0)
+    {
+        _numPoints += other._numPoints;
+        return;
+    }
+
+    if (_weightsSum == 0)
+    {
+        const size_t numPoints = _numPoints + other._numPoints;
+        *this                  = other;
+        _numPoints             = numPoints;
+        return;
+    }
+
+    // Chan et al.'s pairwise update: the two partial sums are taken about
+    // different centroids, and the difference between the centroids adds
+    // a rank one term.
+    const double weightsSum = _weightsSum + other._weightsSum;
+    const double f          = other._weightsSum / weightsSum;
+    const double g          = _weightsSum * f;
+    const V3d    da         = other._Acenter - _Acenter;
+    const V3d    db         = other._Bcenter - _Bcenter;
+
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            _C[i][j] += other._C[i][j] + g * db[i] * da[j];
+
+    _traceATA += other._traceATA + g * (da ^ da);
+    _Acenter += f * da;
+    _Bcenter += f * db;
+    _weightsSum = weightsSum;
+    _numPoints += other._numPoints;
+}
+
+inline void
+ProcrustesAccumulator::clear () IMATH_NOEXCEPT
+{
+    *this = ProcrustesAccumulator ();
+}
+
 /// Compute the SVD of a 3x3 matrix using Jacobi transformations.  This method
 /// should be quite accurate (competitive with LAPACK) even for poorly
 /// conditioned matrices, and because it has been written specifically for the
@@ -1510,6 +1784,45 @@ void jacobiSVD (
     const T            tol = std::numeric_limits<T>::epsilon (),
     const bool         forcePositiveDeterminant = false);
 
+/// Compute the SVDs of `n` 3x3 matrices, `A[i] = U[i] * S[i] * V[i]^T`,
+/// with the same conventions as the single-matrix `jacobiSVD`.
+///
+/// The matrices are processed in blocks of 8, with the Jacobi sweeps of a
+/// block running side by side in SIMD lanes.  Instead of testing each
+/// matrix for convergence in its own loop, every block runs the same sweeps
+/// until all of its matrices have converged, or `maxSweeps` sweeps have been
+/// done.  With the default `maxSweeps` the results agree with those of the
+/// single-matrix version to within rounding, though not necessarily bit for
+/// bit; a smaller value puts a fixed bound on the work per matrix at the
+/// expense of accuracy for badly conditioned inputs.
+///
+/// The function keeps no state, so a large batch can be split into ranges
+/// that are solved concurrently.
+///
+/// Currently only available for single- and double-precision matrices.
+template <typename T>
+void jacobiSVD (
+    const Matrix33<T>* A,
+    Matrix33<T>*       U,
+    Vec3<T>*           S,
+    Matrix33<T>*       V,
+    size_t             n,
+    const T            tol = std::numeric_limits<T>::epsilon (),
+    const bool         forcePositiveDeterminant = false,
+    const int          maxSweeps                = 20);
+
+/// Compute the SVDs of `n` 4x4 matrices.  See the Matrix33 version.
+template <typename T>
+void jacobiSVD (
+    const Matrix44<T>* A,
+    Matrix44<T>*       U,
+    Vec4<T>*           S,
+    Matrix44<T>*       V,
+    size_t             n,
+    const T            tol = std::numeric_limits<T>::epsilon (),
+    const bool         forcePositiveDeterminant = false,
+    const int          maxSweeps                = 20);
+
 /// Compute the eigenvalues (S) and the eigenvectors (V) of a real
 /// symmetric matrix using Jacobi transformation, using a given
 /// tolerance `tol`.
@@ -1566,6 +1879,35 @@ jacobiEigenSolver (Matrix44<T>& A, Vec4<T>& S, Matrix44<T>& V)
     jacobiEigenSolver (A, S, V, std::numeric_limits<T>::epsilon ());
 }
 
+/// Compute the eigenvalues (S) and eigenvectors (V) of `n` real symmetric
+/// 3x3 matrices, with the same conventions as the single-matrix
+/// `jacobiEigenSolver`.  Unlike that function, the input matrices are not
+/// modified.
+///
+/// The matrices are processed in blocks of 8 in SIMD lanes, with at most
+/// `maxSweeps` Jacobi sweeps per block; see the batch version of `jacobiSVD`.
+/// The function keeps no state, so a large batch can be split into ranges
+/// that are solved concurrently.
+template <typename T>
+void jacobiEigenSolver (
+    const Matrix33<T>* A,
+    Vec3<T>*           S,
+    Matrix33<T>*       V,
+    size_t             n,
+    const T            tol       = std::numeric_limits<T>::epsilon (),
+    const int          maxSweeps = 20);
+
+/// Compute the eigenvalues (S) and eigenvectors (V) of `n` real symmetric
+/// 4x4 matrices.  See the Matrix33 version.
+template <typename T>
+void jacobiEigenSolver (
+    const Matrix44<T>* A,
+    Vec4<T>*           S,
+    Matrix44<T>*       V,
+    size_t             n,
+    const T            tol       = std::numeric_limits<T>::epsilon (),
+    const int          maxSweeps = 20);
+
 /// Compute a eigenvector corresponding to the abs max eigenvalue
 /// of a real symmetric matrix using Jacobi transformation.
 template <typename TM, typename TV> void maxEigenVector (TM& A, TV& S);
@@ -0,0 +1,867 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+///
+/// @file  ImathMatrixAlgoBatch.cpp
+///
+/// @brief The batch versions of jacobiSVD, jacobiEigenSolver and the
+/// rotation and TRS conversions declared in ImathMatrixAlgo.h.
+///
+
+#include "ImathMatrixAlgo.h"
+#include <algorithm>
+#include <cmath>
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_ENTER
+
+// Reads the singular values off the diagonalized A and brings the
+// decomposition into the canonical form, as for the single-matrix
+// jacobiSVD.  Defined in ImathMatrixAlgo.cpp, which is compiled without
+// the flags of this file.
+template <typename T>
+void finishJacobiSVD (
+    const Matrix33<T>& A,
+    Matrix33<T>&       U,
+    Vec3<T>&           S,
+    Matrix33<T>&       V,
+    const bool         forcePositiveDeterminant);
+
+template <typename T>
+void finishJacobiSVD (
+    const Matrix44<T>& A,
+    Matrix44<T>&       U,
+    Vec4<T>&           S,
+    Matrix44<T>&       V,
+    const bool         forcePositiveDeterminant);
+
+namespace
+{
+
+// The batch solvers work on blocks of jacobiLanes matrices at a time, stored
+// as a "structure of arrays": A[i][j] is the array of the (i, j) entries of
+// all the matrices in the block.  Every step of a rotation then becomes a
+// short loop over the lanes that the compiler can vectorize.  The rotations
+// are computed as in the single-matrix solvers in ImathMatrixAlgo.cpp, except
+// that a rotation those would skip becomes the identity rotation here, and
+// lanes that have converged are masked off the same way.
+const int jacobiLanes = 8;
+
+// One two-sided rotation of the (j, k) entries of all the lanes; see
+// twoSidedJacobiRotation.  `active` is 1 for the lanes that have not
+// converged yet and 0 for the others.  The masking is written as arithmetic
+// on values that are computed either way, which lets the compiler turn the
+// whole loop body into straight-line vector code.
+template <typename T, int N, int j, int k>
+void
+twoSidedJacobiLanesRotation (
+    T (&A)[N][N][jacobiLanes],
+    T (&U)[N][N][jacobiLanes],
+    T (&V)[N][N][jacobiLanes],
+    const T (&active)[jacobiLanes],
+    const T tol)
+{
+    T c1[jacobiLanes], s1[jacobiLanes];
+    T c2[jacobiLanes], s2[jacobiLanes];
+
+    for (int m = 0; m < jacobiLanes; ++m)
+    {
+        const T w = A[j][j][m];
+        const T x = A[j][k][m];
+        const T y = A[k][j][m];
+        const T z = A[k][k][m];
+
+        // Symmetrize:
+        const T    mu1       = w + z;
+        const T    mu2       = x - y;
+        const bool symmetric = (active[m] == T (0)) |
+                               (std::abs (mu2) <= tol * std::abs (mu1));
+        const T    rotate    = symmetric ? T (0) : T (1);
+
+        const T rho = mu1 / (symmetric ? T (1) : mu2);
+        const T s   = rotate * (rho < 0 ? T (-1) : T (1)) /
+                    std::sqrt (T (1) + rho * rho);
+        const T c = s * rho + (T (1) - rotate);
+
+        const T mu1_2 = s * (x + y) + c * (z - w);
+        const T mu2_2 =
+            rotate * T (2) * (c * x - s * z) + (T (1) - rotate) * (x + y);
+
+        // Diagonalize:
+        const bool diagonal = (active[m] == T (0)) |
+                              (std::abs (mu2_2) <= tol * std::abs (mu1_2));
+
+        const T rho_2 = mu1_2 / (diagonal ? T (1) : mu2_2);
+        const T t_2   = (diagonal ? T (0) : rho_2 < 0 ? T (-1) : T (1)) /
+                      (std::abs (rho_2) + std::sqrt (T (1) + rho_2 * rho_2));
+        const T c_2 = T (1) / std::sqrt (T (1) + t_2 * t_2);
+        const T s_2 = c_2 * t_2;
+        const T c_1 = c_2 * c - s_2 * s;
+        const T s_1 = s_2 * c + c_2 * s;
+
+        A[j][j][m] = c_1 * (w * c_2 - x * s_2) - s_1 * (y * c_2 - z * s_2);
+        A[k][k][m] = s_1 * (w * s_2 + x * c_2) + c_1 * (y * s_2 + z * c_2);
+        A[j][k][m] = (T (1) - active[m]) * x;
+        A[k][j][m] = (T (1) - active[m]) * y;
+
+        c1[m] = c_1;
+        s1[m] = s_1;
+        c2[m] = c_2;
+        s2[m] = s_2;
+    }
+
+    for (int l = 0; l < N; ++l)
+    {
+        if (l == j || l == k) continue;
+
+        for (int m = 0; m < jacobiLanes; ++m)
+        {
+            const T tau1 = A[j][l][m];
+            const T tau2 = A[k][l][m];
+            A[j][l][m]   = c1[m] * tau1 - s1[m] * tau2;
+            A[k][l][m]   = s1[m] * tau1 + c1[m] * tau2;
+        }
+
+        for (int m = 0; m < jacobiLanes; ++m)
+        {
+            const T tau1 = A[l][j][m];
+            const T tau2 = A[l][k][m];
+            A[l][j][m]   = c2[m] * tau1 - s2[m] * tau2;
+            A[l][k][m]   = s2[m] * tau1 + c2[m] * tau2;
+        }
+    }
+
+    for (int i = 0; i < N; ++i)
+    {
+        for (int m = 0; m < jacobiLanes; ++m)
+        {
+            const T tau1 = U[i][j][m];
+            const T tau2 = U[i][k][m];
+            U[i][j][m]   = c1[m] * tau1 - s1[m] * tau2;
+            U[i][k][m]   = s1[m] * tau1 + c1[m] * tau2;
+        }
+
+        for (int m = 0; m < jacobiLanes; ++m)
+        {
+            const T tau1 = V[i][j][m];
+            const T tau2 = V[i][k][m];
+            V[i][j][m]   = c2[m] * tau1 - s2[m] * tau2;
+            V[i][k][m]   = s2[m] * tau1 + c2[m] * tau2;
+        }
+    }
+}
+
+template <typename T>
+void
+twoSidedJacobiLanesSweep (
+    T (&A)[3][3][jacobiLanes],
+    T (&U)[3][3][jacobiLanes],
+    T (&V)[3][3][jacobiLanes],
+    const T (&active)[jacobiLanes],
+    const T tol)
+{
+    twoSidedJacobiLanesRotation<T, 3, 0, 1> (A, U, V, active, tol);
+    twoSidedJacobiLanesRotation<T, 3, 0, 2> (A, U, V, active, tol);
+    twoSidedJacobiLanesRotation<T, 3, 1, 2> (A, U, V, active, tol);
+}
+
+template <typename T>
+void
+twoSidedJacobiLanesSweep (
+    T (&A)[4][4][jacobiLanes],
+    T (&U)[4][4][jacobiLanes],
+    T (&V)[4][4][jacobiLanes],
+    const T (&active)[jacobiLanes],
+    const T tol)
+{
+    twoSidedJacobiLanesRotation<T, 4, 0, 1> (A, U, V, active, tol);
+    twoSidedJacobiLanesRotation<T, 4, 0, 2> (A, U, V, active, tol);
+    twoSidedJacobiLanesRotation<T, 4, 0, 3> (A, U, V, active, tol);
+    twoSidedJacobiLanesRotation<T, 4, 1, 2> (A, U, V, active, tol);
+    twoSidedJacobiLanesRotation<T, 4, 1, 3> (A, U, V, active, tol);
+    twoSidedJacobiLanesRotation<T, 4, 2, 3> (A, U, V, active, tol);
+}
+
+// Returns the largest off-diagonal entry of the matrix in lane m.  For the
+// eigensolver only the upper triangle is looked at.
+template <typename T, int N>
+T
+maxOffDiagLane (const T (&A)[N][N][jacobiLanes], const int m, const bool symm)
+{
+    T result = 0;
+    for (int i = 0; i < N; ++i)
+        for (int j = symm ? i + 1 : 0; j < N; ++j)
+            if (i != j) result = std::max (result, std::abs (A[i][j][m]));
+
+    return result;
+}
+
+template <typename T, int N>
+void
+twoSidedJacobiLanes (
+    T (&A)[N][N][jacobiLanes],
+    T (&U)[N][N][jacobiLanes],
+    T (&V)[N][N][jacobiLanes],
+    const T   tol,
+    const int maxSweeps)
+{
+    T    absTol[jacobiLanes];
+    T    active[jacobiLanes];
+    bool anyActive = false;
+
+    for (int m = 0; m < jacobiLanes; ++m)
+    {
+        absTol[m] = tol * maxOffDiagLane (A, m, false);
+        active[m] = absTol[m] != 0 ? T (1) : T (0);
+        anyActive = anyActive || absTol[m] != 0;
+    }
+
+    for (int sweep = 0; sweep < maxSweeps && anyActive; ++sweep)
+    {
+        twoSidedJacobiLanesSweep (A, U, V, active, tol);
+
+        // Same termination test as the single-matrix version, per lane.
+        anyActive = false;
+        for (int m = 0; m < jacobiLanes; ++m)
+        {
+            if (active[m] != 0 && maxOffDiagLane (A, m, false) <= absTol[m])
+                active[m] = 0;
+            anyActive = anyActive || active[m] != 0;
+        }
+    }
+}
+
+// One rotation of the (j, k) entries of all the lanes; see jacobiRotation.
+template <typename T, int N, int j, int k>
+void
+jacobiLanesRotation (
+    T (&A)[N][N][jacobiLanes],
+    T (&V)[N][N][jacobiLanes],
+    T (&Z)[N][jacobiLanes],
+    const T (&active)[jacobiLanes],
+    const T tol)
+{
+    T s[jacobiLanes], tau[jacobiLanes];
+
+    for (int m = 0; m < jacobiLanes; ++m)
+    {
+        const T x = A[j][j][m];
+        const T y = A[j][k][m];
+        const T z = A[k][k][m];
+
+        const T    mu1  = z - x;
+        const T    mu2  = T (2) * y;
+        const bool skip = (active[m] == T (0)) |
+                          (std::abs (mu2) <= tol * std::abs (mu1));
+
+        const T rho = mu1 / (skip ? T (1) : mu2);
+        const T t   = (skip ? T (0) : rho < 0 ? T (-1) : T (1)) /
+                    (std::abs (rho) + std::sqrt (T (1) + rho * rho));
+        const T c = T (1) / std::sqrt (T (1) + t * t);
+        const T h = t * y;
+
+        s[m]   = t * c;
+        tau[m] = s[m] / (T (1) + c);
+
+        Z[j][m] -= h;
+        Z[k][m] += h;
+        A[j][j][m] -= h;
+        A[k][k][m] += h;
+        A[j][k][m] = (T (1) - active[m]) * y;
+    }
+
+    // Only the upper triangle of A is kept up to date.
+    for (int l = 0; l < N; ++l)
+    {
+        if (l == j || l == k) continue;
+
+        T* offd1 = l < j ? A[l][j] : A[j][l];
+        T* offd2 = l < k ? A[l][k] : A[k][l];
+        for (int m = 0; m < jacobiLanes; ++m)
+        {
+            const T nu1 = offd1[m];
+            const T nu2 = offd2[m];
+            offd1[m]    = nu1 - s[m] * (nu2 + tau[m] * nu1);
+            offd2[m]    = nu2 + s[m] * (nu1 - tau[m] * nu2);
+        }
+    }
+
+    for (int i = 0; i < N; ++i)
+    {
+        for (int m = 0; m < jacobiLanes; ++m)
+        {
+            const T nu1 = V[i][j][m];
+            const T nu2 = V[i][k][m];
+            V[i][j][m]  = nu1 - s[m] * (nu2 + tau[m] * nu1);
+            V[i][k][m]  = nu2 + s[m] * (nu1 - tau[m] * nu2);
+        }
+    }
+}
+
+template <typename T>
+void
+jacobiLanesSweep (
+    T (&A)[3][3][jacobiLanes],
+    T (&V)[3][3][jacobiLanes],
+    T (&Z)[3][jacobiLanes],
+    const T (&active)[jacobiLanes],
+    const T tol)
+{
+    jacobiLanesRotation<T, 3, 0, 1> (A, V, Z, active, tol);
+    jacobiLanesRotation<T, 3, 0, 2> (A, V, Z, active, tol);
+    jacobiLanesRotation<T, 3, 1, 2> (A, V, Z, active, tol);
+}
+
+template <typename T>
+void
+jacobiLanesSweep (
+    T (&A)[4][4][jacobiLanes],
+    T (&V)[4][4][jacobiLanes],
+    T (&Z)[4][jacobiLanes],
+    const T (&active)[jacobiLanes],
+    const T tol)
+{
+    jacobiLanesRotation<T, 4, 0, 1> (A, V, Z, active, tol);
+    jacobiLanesRotation<T, 4, 0, 2> (A, V, Z, active, tol);
+    jacobiLanesRotation<T, 4, 0, 3> (A, V, Z, active, tol);
+    jacobiLanesRotation<T, 4, 1, 2> (A, V, Z, active, tol);
+    jacobiLanesRotation<T, 4, 1, 3> (A, V, Z, active, tol);
+    jacobiLanesRotation<T, 4, 2, 3> (A, V, Z, active, tol);
+}
+
+template <typename T, int N>
+void
+jacobiEigenLanes (
+    T (&A)[N][N][jacobiLanes],
+    T (&S)[N][jacobiLanes],
+    T (&V)[N][N][jacobiLanes],
+    const T   tol,
+    const int maxSweeps)
+{
+    T    absTol[jacobiLanes];
+    T    active[jacobiLanes];
+    bool anyActive = false;
+
+    for (int m = 0; m < jacobiLanes; ++m)
+    {
+        for (int i = 0; i < N; ++i)
+            S[i][m] = A[i][i][m];
+
+        absTol[m] = tol * maxOffDiagLane (A, m, true);
+        active[m] = absTol[m] != 0 ? T (1) : T (0);
+        anyActive = anyActive || absTol[m] != 0;
+    }
+
+    for (int sweep = 0; sweep < maxSweeps && anyActive; ++sweep)
+    {
+        // Z accumulates the changes to the diagonal over one sweep, see
+        // jacobiEigenSolver.
+        T Z[N][jacobiLanes] = {};
+
+        jacobiLanesSweep (A, V, Z, active, tol);
+
+        anyActive = false;
+        for (int m = 0; m < jacobiLanes; ++m)
+        {
+            for (int i = 0; i < N; ++i)
+                A[i][i][m] = S[i][m] += Z[i][m];
+
+            if (active[m] != 0 && maxOffDiagLane (A, m, true) <= absTol[m])
+                active[m] = 0;
+            anyActive = anyActive || active[m] != 0;
+        }
+    }
+}
+
+template <typename TM, typename TV>
+void
+jacobiSVDBatch (
+    const TM*                   A,
+    TM*                         U,
+    TV*                         S,
+    TM*                         V,
+    const size_t                n,
+    const typename TM::BaseType tol,
+    const bool                  forcePositiveDeterminant,
+    const int                   maxSweeps)
+{
+    typedef typename TM::BaseType T;
+    const int                     N = TM::dimensions ();
+
+    T a[N][N][jacobiLanes];
+    T u[N][N][jacobiLanes];
+    T v[N][N][jacobiLanes];
+
+    for (size_t first = 0; first < n; first += jacobiLanes)
+    {
+        const size_t count = std::min (n - first, size_t (jacobiLanes));
+
+        // Unused lanes get the identity, which needs no rotations.
+        for (int i = 0; i < N; ++i)
+        {
+            for (int j = 0; j < N; ++j)
+            {
+                for (int m = 0; m < jacobiLanes; ++m)
+                {
+                    a[i][j][m] = m < int (count) ? A[first + m][i][j]
+                                                 : T (i == j);
+                    u[i][j][m] = T (i == j);
+                    v[i][j][m] = T (i == j);
+                }
+            }
+        }
+
+        twoSidedJacobiLanes<T, N> (a, u, v, tol, maxSweeps);
+
+        for (size_t m = 0; m < count; ++m)
+        {
+            TM d;
+            for (int i = 0; i < N; ++i)
+            {
+                for (int j = 0; j < N; ++j)
+                {
+                    d[i][j]            = a[i][j][m];
+                    U[first + m][i][j] = u[i][j][m];
+                    V[first + m][i][j] = v[i][j][m];
+                }
+            }
+
+            finishJacobiSVD (
+                d, U[first + m], S[first + m], V[first + m],
+                forcePositiveDeterminant);
+        }
+    }
+}
+
+template <typename TM, typename TV>
+void
+jacobiEigenSolverBatch (
+    const TM*                   A,
+    TV*                         S,
+    TM*                         V,
+    const size_t                n,
+    const typename TM::BaseType tol,
+    const int                   maxSweeps)
+{
+    typedef typename TM::BaseType T;
+    const int                     N = TM::dimensions ();
+
+    T a[N][N][jacobiLanes];
+    T s[N][jacobiLanes];
+    T v[N][N][jacobiLanes];
+
+    for (size_t first = 0; first < n; first += jacobiLanes)
+    {
+        const size_t count = std::min (n - first, size_t (jacobiLanes));
+
+        for (int i = 0; i < N; ++i)
+        {
+            for (int j = 0; j < N; ++j)
+            {
+                for (int m = 0; m < jacobiLanes; ++m)
+                {
+                    a[i][j][m] = m < int (count) ? A[first + m][i][j]
+                                                 : T (i == j);
+                    v[i][j][m] = T (i == j);
+                }
+            }
+        }
+
+        jacobiEigenLanes<T, N> (a, s, v, tol, maxSweeps);
+
+        for (size_t m = 0; m < count; ++m)
+        {
+            for (int i = 0; i < N; ++i)
+            {
+                S[first + m][i] = s[i][m];
+                for (int j = 0; j < N; ++j)
+                    V[first + m][i][j] = v[i][j][m];
+            }
+        }
+    }
+}
+
+} // namespace
+
+template <typename T>
+void
+jacobiSVD (
+    const Matrix33<T>* A,
+    Matrix33<T>*       U,
+    Vec3<T>*           S,
+    Matrix33<T>*       V,
+    const size_t       n,
+    const T            tol,
+    const bool         forcePositiveDeterminant,
+    const int          maxSweeps)
+{
+    jacobiSVDBatch (A, U, S, V, n, tol, forcePositiveDeterminant, maxSweeps);
+}
+
+template <typename T>
+void
+jacobiSVD (
+    const Matrix44<T>* A,
+    Matrix44<T>*       U,
+    Vec4<T>*           S,
+    Matrix44<T>*       V,
+    const size_t       n,
+    const T            tol,
+    const bool         forcePositiveDeterminant,
+    const int          maxSweeps)
+{
+    jacobiSVDBatch (A, U, S, V, n, tol, forcePositiveDeterminant, maxSweeps);
+}
+
+template <typename T>
+void
+jacobiEigenSolver (
+    const Matrix33<T>* A,
+    Vec3<T>*           S,
+    Matrix33<T>*       V,
+    const size_t       n,
+    const T            tol,
+    const int          maxSweeps)
+{
+    jacobiEigenSolverBatch (A, S, V, n, tol, maxSweeps);
+}
+
+template <typename T>
+void
+jacobiEigenSolver (
+    const Matrix44<T>* A,
+    Vec4<T>*           S,
+    Matrix44<T>*       V,
+    const size_t       n,
+    const T            tol,
+    const int          maxSweeps)
+{
+    jacobiEigenSolverBatch (A, S, V, n, tol, maxSweeps);
+}
+
+template IMATH_EXPORT void jacobiSVD (
+    const Matrix33<float>* A,
+    Matrix33<float>*       U,
+    Vec3<float>*           S,
+    Matrix33<float>*       V,
+    const size_t           n,
+    const float            tol,
+    const bool             forcePositiveDeterminant,
+    const int              maxSweeps);
+template IMATH_EXPORT void jacobiSVD (
+    const Matrix33<double>* A,
+    Matrix33<double>*       U,
+    Vec3<double>*           S,
+    Matrix33<double>*       V,
+    const size_t            n,
+    const double            tol,
+    const bool              forcePositiveDeterminant,
+    const int               maxSweeps);
+template IMATH_EXPORT void jacobiSVD (
+    const Matrix44<float>* A,
+    Matrix44<float>*       U,
+    Vec4<float>*           S,
+    Matrix44<float>*       V,
+    const size_t           n,
+    const float            tol,
+    const bool             forcePositiveDeterminant,
+    const int              maxSweeps);
+template IMATH_EXPORT void jacobiSVD (
+    const Matrix44<double>* A,
+    Matrix44<double>*       U,
+    Vec4<double>*           S,
+    Matrix44<double>*       V,
+    const size_t            n,
+    const double            tol,
+    const bool              forcePositiveDeterminant,
+    const int               maxSweeps);
+
+template IMATH_EXPORT void jacobiEigenSolver (
+    const Matrix33<float>* A,
+    Vec3<float>*           S,
+    Matrix33<float>*       V,
+    const size_t           n,
+    const float            tol,
+    const int              maxSweeps);
+template IMATH_EXPORT void jacobiEigenSolver (
+    const Matrix33<double>* A,
+    Vec3<double>*           S,
+    Matrix33<double>*       V,
+    const size_t            n,
+    const double            tol,
+    const int               maxSweeps);
+template IMATH_EXPORT void jacobiEigenSolver (
+    const Matrix44<float>* A,
+    Vec4<float>*           S,
+    Matrix44<float>*       V,
+    const size_t           n,
+    const float            tol,
+    const int              maxSweeps);
+template IMATH_EXPORT void jacobiEigenSolver (
+    const Matrix44<double>* A,
+    Vec4<double>*           S,
+    Matrix44<double>*       V,
+    const size_t            n,
+    const double            tol,
+    const int               maxSweeps);
+
+namespace
+{
+
+// The batch conversions between rotations and quaternions work on blocks of
+// quatLanes matrices, whose 3x3 parts are copied into a "structure of
+// arrays", a[i][j] being the array of the (i, j) entries of the block.
+// extractQuatLanes computes the values of all four cases of extractQuat
+// with its arithmetic, and picks one with selects, so that the loop
+// vectorizes and the results agree with extractQuat to within rounding.
+const int quatLanes = 16;
+
+template <typename T>
+void
+extractQuatLanes (const T (&a)[3][3][quatLanes], const int n, Quat<T>* quats)
+{
+    T s[quatLanes];
+
+    // A positive trace picks the first case; otherwise the largest
+    // diagonal entry picks one of the others.
+    for (int m = 0; m < n; ++m)
+    {
+        const T m00 = a[0][0][m], m11 = a[1][1][m], m22 = a[2][2][m];
+        const T tr  = m00 + m11 + m22;
+
+        const bool i1 = m11 > m00;
+        const bool i2 = m22 > (i1 ? m11 : m00);
+
+        const T d = tr > T (0.0) ? tr
+                    : i2         ? m22 - (m00 + m11)
+                    : i1         ? m11 - (m22 + m00)
+                                 : m00 - (m11 + m22);
+        s[m] = std::sqrt (d + T (1.0));
+    }
+
+    // The largest component is s / 2, and the others are sums and
+    // differences of entries scaled by 0.5 / s, or by 0 where extractQuat
+    // leaves s = 0.
+    for (int m = 0; m < n; ++m)
+    {
+        const T m00 = a[0][0][m], m01 = a[0][1][m], m02 = a[0][2][m];
+        const T m10 = a[1][0][m], m11 = a[1][1][m], m12 = a[1][2][m];
+        const T m20 = a[2][0][m], m21 = a[2][1][m], m22 = a[2][2][m];
+        const T tr  = m00 + m11 + m22;
+
+        const bool c3 = tr > T (0.0);
+        const bool i1 = m11 > m00;
+        const bool i2 = m22 > (i1 ? m11 : m00);
+
+        const T big = s[m] * T (0.5);
+        const T inv = T (0.5) / (s[m] != T (0.0) ? s[m] : T (1.0));
+        const T f   = c3 || s[m] != T (0.0) ? inv : T (0.0);
+
+        const T dx = (m12 - m21) * f;
+        const T dy = (m20 - m02) * f;
+        const T dz = (m01 - m10) * f;
+        const T xy = (m01 + m10) * f;
+        const T xz = (m02 + m20) * f;
+        const T yz = (m12 + m21) * f;
+
+        Quat<T>& q = quats[m];
+        q.v.x      = c3 ? dx : i2 ? xz : i1 ? xy : big;
+        q.v.y      = c3 ? dy : i2 ? yz : i1 ? big : xy;
+        q.v.z      = c3 ? dz : i2 ? big : i1 ? yz : xz;
+        q.r        = c3 ? big : i2 ? dz : i1 ? dy : dx;
+    }
+}
+
+template <typename T, typename M>
+void
+extractQuatBatch (const M* mats, Quat<T>* quats, const size_t n)
+{
+    T a[3][3][quatLanes];
+
+    for (size_t first = 0; first < n; first += quatLanes)
+    {
+        const int count = int (std::min<size_t> (n - first, quatLanes));
+
+        for (int m = 0; m < count; ++m)
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    a[i][j][m] = mats[first + m][i][j];
+
+        extractQuatLanes (a, count, quats + first);
+    }
+}
+
+} // namespace
+
+template <typename T>
+void
+extractQuat (const Matrix44<T>* mats, Quat<T>* quats, const size_t n)
+{
+    extractQuatBatch (mats, quats, n);
+}
+
+template <typename T>
+void
+extractQuat (const Matrix33<T>* mats, Quat<T>* quats, const size_t n)
+{
+    extractQuatBatch (mats, quats, n);
+}
+
+template <typename T>
+void
+toMatrix44 (const Quat<T>* quats, Matrix44<T>* mats, const size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        mats[i] = quats[i].toMatrix44 ();
+}
+
+template <typename T>
+void
+toMatrix33 (const Quat<T>* quats, Matrix33<T>* mats, const size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        mats[i] = quats[i].toMatrix33 ();
+}
+
+template <typename T>
+void
+toMatrix44 (const TRS<T>* trs, Matrix44<T>* mats, const size_t n)
+{
+    // A TRS is ten values, which the compiler will not load as a vector
+    // group, so the fields are copied into one array each first.
+    T q[4][quatLanes], t[3][quatLanes], s[3][quatLanes];
+
+    for (size_t first = 0; first < n; first += quatLanes)
+    {
+        const int count = int (std::min<size_t> (n - first, quatLanes));
+
+        for (int m = 0; m < count; ++m)
+        {
+            const TRS<T>& x = trs[first + m];
+
+            q[0][m] = x.rotation.v.x;
+            q[1][m] = x.rotation.v.y;
+            q[2][m] = x.rotation.v.z;
+            q[3][m] = x.rotation.r;
+            t[0][m] = x.translation.x;
+            t[1][m] = x.translation.y;
+            t[2][m] = x.translation.z;
+            s[0][m] = x.scale.x;
+            s[1][m] = x.scale.y;
+            s[2][m] = x.scale.z;
+        }
+
+        // The rows of the rotation, as in Quat::toMatrix44, are scaled.
+        for (int m = 0; m < count; ++m)
+        {
+            const T x = q[0][m], y = q[1][m], z = q[2][m], r = q[3][m];
+
+            Matrix44<T>& mat = mats[first + m];
+
+            mat[0][0] = s[0][m] * (1 - 2 * (y * y + z * z));
+            mat[0][1] = s[0][m] * (2 * (x * y + z * r));
+            mat[0][2] = s[0][m] * (2 * (z * x - y * r));
+            mat[0][3] = 0;
+            mat[1][0] = s[1][m] * (2 * (x * y - z * r));
+            mat[1][1] = s[1][m] * (1 - 2 * (z * z + x * x));
+            mat[1][2] = s[1][m] * (2 * (y * z + x * r));
+            mat[1][3] = 0;
+            mat[2][0] = s[2][m] * (2 * (z * x + y * r));
+            mat[2][1] = s[2][m] * (2 * (y * z - x * r));
+            mat[2][2] = s[2][m] * (1 - 2 * (y * y + x * x));
+            mat[2][3] = 0;
+            mat[3][0] = t[0][m];
+            mat[3][1] = t[1][m];
+            mat[3][2] = t[2][m];
+            mat[3][3] = 1;
+        }
+    }
+}
+
+template <typename T>
+void
+extractTRS (const Matrix44<T>* mats, TRS<T>* trs, const size_t n)
+{
+    T       a[3][3][quatLanes], s[3][quatLanes];
+    Quat<T> q[quatLanes];
+
+    for (size_t first = 0; first < n; first += quatLanes)
+    {
+        const int count = int (std::min<size_t> (n - first, quatLanes));
+
+        for (int m = 0; m < count; ++m)
+            for (int i = 0; i < 3; ++i)
+                for (int j = 0; j < 3; ++j)
+                    a[i][j][m] = mats[first + m][i][j];
+
+        // The scale is the length of each row, negated if the rows are a
+        // left-handed basis so that what remains is a proper rotation.
+        // The rows are then divided by it, leaving zero rows alone.
+        for (int m = 0; m < count; ++m)
+        {
+            const T det = a[0][0][m] * (a[1][1][m] * a[2][2][m] -
+                                        a[1][2][m] * a[2][1][m]) +
+                          a[0][1][m] * (a[1][2][m] * a[2][0][m] -
+                                        a[1][0][m] * a[2][2][m]) +
+                          a[0][2][m] * (a[1][0][m] * a[2][1][m] -
+                                        a[1][1][m] * a[2][0][m]);
+
+            const T sign = det < T (0) ? T (-1) : T (1);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                const T l = sign * std::sqrt (a[i][0][m] * a[i][0][m] +
+                                              a[i][1][m] * a[i][1][m] +
+                                              a[i][2][m] * a[i][2][m]);
+                const T inv = l != T (0) ? T (1) / l : T (0);
+
+                s[i][m] = l;
+                a[i][0][m] *= inv;
+                a[i][1][m] *= inv;
+                a[i][2][m] *= inv;
+            }
+        }
+
+        extractQuatLanes (a, count, q);
+
+        for (int m = 0; m < count; ++m)
+        {
+            const Matrix44<T>& mat = mats[first + m];
+            TRS<T>&            x   = trs[first + m];
+
+            x.rotation    = q[m];
+            x.translation = Vec3<T> (mat[3][0], mat[3][1], mat[3][2]);
+            x.scale       = Vec3<T> (s[0][m], s[1][m], s[2][m]);
+        }
+    }
+}
+
+template IMATH_EXPORT void
+extractQuat (const Matrix44<float>* mats, Quat<float>* quats, const size_t n);
+template IMATH_EXPORT void
+extractQuat (const Matrix44<double>* mats, Quat<double>* quats, const size_t n);
+template IMATH_EXPORT void
+extractQuat (const Matrix33<float>* mats, Quat<float>* quats, const size_t n);
+template IMATH_EXPORT void
+extractQuat (const Matrix33<double>* mats, Quat<double>* quats, const size_t n);
+
+template IMATH_EXPORT void
+toMatrix44 (const Quat<float>* quats, Matrix44<float>* mats, const size_t n);
+template IMATH_EXPORT void
+toMatrix44 (const Quat<double>* quats, Matrix44<double>* mats, const size_t n);
+template IMATH_EXPORT void
+toMatrix33 (const Quat<float>* quats, Matrix33<float>* mats, const size_t n);
+template IMATH_EXPORT void
+toMatrix33 (const Quat<double>* quats, Matrix33<double>* mats, const size_t n);
+
+template IMATH_EXPORT void
+toMatrix44 (const TRS<float>* trs, Matrix44<float>* mats, const size_t n);
+template IMATH_EXPORT void
+toMatrix44 (const TRS<double>* trs, Matrix44<double>* mats, const size_t n);
+template IMATH_EXPORT void
+extractTRS (const Matrix44<float>* mats, TRS<float>* trs, const size_t n);
+template IMATH_EXPORT void
+extractTRS (const Matrix44<double>* mats, TRS<double>* trs, const size_t n);
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_EXIT
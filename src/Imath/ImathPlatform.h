@@ -47,6 +47,43 @@ IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
 #        define IMATH_CONSTEXPR14 /* can not be constexpr before c++14 */
 #    endif
 
+//
+// IMATH_IS_CONSTANT_EVALUATED() is true when a constexpr function is
+// being evaluated at compile time, where intrinsics cannot be used.
+// IMATH_HAVE_IS_CONSTANT_EVALUATED is defined if the compiler
+// provides it, whatever the C++ standard.
+//
+#    if defined(__clang__)
+#        if defined(__has_builtin)
+#            if __has_builtin(__builtin_is_constant_evaluated)
+#                define IMATH_HAVE_IS_CONSTANT_EVALUATED 1
+#            endif
+#        endif
+#    elif defined(__GNUC__) && __GNUC__ >= 9
+#        define IMATH_HAVE_IS_CONSTANT_EVALUATED 1
+#    elif defined(_MSC_VER) && _MSC_VER >= 1925
+#        define IMATH_HAVE_IS_CONSTANT_EVALUATED 1
+#    endif
+
+#    ifdef IMATH_HAVE_IS_CONSTANT_EVALUATED
+#        define IMATH_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated ()
+#    endif
+
+//
+// With IMATH_ENABLE_SIMD, select the instruction set for the
+// hand-written matrix kernels: SSE2 on x86, NEON on 64-bit ARM.
+// Never when compiling device code for Cuda.
+//
+#    if defined(IMATH_ENABLE_SIMD) &&                                          \
+        defined(IMATH_HAVE_IS_CONSTANT_EVALUATED) && !defined(__CUDA_ARCH__)
+#        if defined(__SSE2__) || defined(_M_X64) ||                            \
+            (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#            define IMATH_SIMD_SSE2 1
+#        elif defined(__ARM_NEON) && defined(__aarch64__)
+#            define IMATH_SIMD_NEON 1
+#        endif
+#    endif
+
 #endif // __cplusplus
 
 #ifndef M_PI
@@ -71,6 +108,22 @@ IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
 #    define IMATH_RESTRICT
 #endif
 
+//-----------------------------------------------------------------------------
+//
+//    IMATH_NO_UNROLL, placed before a short loop over the lanes of a
+//    packet, keeps GCC from unrolling the loop completely before the
+//    vectorizer sees it. Once unrolled, the selects in the loop body
+//    turn into branches and the code stays scalar.
+//
+//-----------------------------------------------------------------------------
+
+#if defined(__GNUC__) && __GNUC__ >= 8 && !defined(__clang__) &&              \
+    !defined(__INTEL_COMPILER)
+#    define IMATH_NO_UNROLL _Pragma ("GCC unroll 1")
+#else
+#    define IMATH_NO_UNROLL
+#endif
+
 #ifdef __cplusplus
 
 IMATH_INTERNAL_NAMESPACE_HEADER_EXIT
@@ -22,6 +22,7 @@
 
 #include "ImathMatrix.h"
 
+#include <cstddef>
 #include <iostream>
 
 IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
@@ -1003,6 +1004,262 @@ IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline Vec3<T>
     return v + T (2) * (q.r * a + b);
 }
 
+///
+/// The parts of a spherical linear interpolation that do not depend on
+/// `t`, for sampling the same pair of quaternions many times, as when
+/// evaluating an animation channel between two keys. Use it with the
+/// array versions of slerp() and slerpApprox().
+///
+
+template <class T> struct SlerpKey
+{
+    /// The quaternion at `t = 0`
+    Quat<T> q1;
+
+    /// The quaternion at `t = 1`
+    Quat<T> q2;
+
+    /// The angle between `q1` and `q2`, as computed by angle4D()
+    T angle;
+
+    /// `sinx_over_x (angle)`
+    T sinAngleOverAngle;
+
+    /// Initialize to interpolate between two identity quaternions.
+    IMATH_HOSTDEVICE SlerpKey () IMATH_NOEXCEPT
+        : angle (0), sinAngleOverAngle (1)
+    {}
+
+    /// Initialize to interpolate from `q1` to `q2`, which must be unit
+    /// quaternions. Like slerp(), this does not take the shortest arc
+    /// unless `shortestArc` is true, in which case `q2` is negated if
+    /// `q1 ^ q2` is negative, as in slerpShortestArc().
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 SlerpKey (
+        const Quat<T>& q1,
+        const Quat<T>& q2,
+        bool           shortestArc = false) IMATH_NOEXCEPT
+        : q1 (q1)
+        , q2 (shortestArc && (q1 ^ q2) < 0 ? -q2 : q2)
+        , angle (angle4D (this->q1, this->q2))
+        , sinAngleOverAngle (sinx_over_x (angle))
+    {}
+};
+
+/// Slerp key of type float
+typedef SlerpKey<float> SlerpKeyf;
+
+/// Slerp key of type double
+typedef SlerpKey<double> SlerpKeyd;
+
+///
+/// Spherical linear interpolation of an array of keys: set
+/// `result[i]` to `slerp (keys[i].q1, keys[i].q2, t[i])`. The results
+/// are identical to those of slerp(), without recomputing the angle
+/// between the quaternions for every sample.
+///
+/// @param keys The keys
+/// @param t The interpolation parameters, one per key
+/// @param[out] result The interpolated quaternions
+/// @param n The number of keys
+///
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+slerp (const SlerpKey<T>* keys, const T* t, Quat<T>* result, size_t n)
+    IMATH_NOEXCEPT
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        const SlerpKey<T>& k = keys[i];
+
+        T a = k.angle;
+        T s = 1 - t[i];
+
+        Quat<T> q = sinx_over_x (s * a) / k.sinAngleOverAngle * s * k.q1 +
+                    sinx_over_x (t[i] * a) / k.sinAngleOverAngle * t[i] * k.q2;
+
+        result[i] = q.normalized ();
+    }
+}
+
+/// @cond Doxygen_Suppress
+
+//
+// Polynomial approximations for slerpApprox(). slerpSinxOverX() is
+// sin(x)/x as a function of x*x for |x| <= pi, from the Taylor series
+// through x^16, with an error below 1e-8. slerpAcos() is acos(x) for
+// 0 <= x <= 1, from Abramowitz and Stegun 4.4.46, with an error below
+// 2.2e-8.
+//
+
+template <class T>
+IMATH_HOSTDEVICE inline T
+slerpSinxOverX (T x2) IMATH_NOEXCEPT
+{
+    T p = T (1.0 / 355687428096000.0);
+    p   = p * x2 - T (1.0 / 1307674368000.0);
+    p   = p * x2 + T (1.0 / 6227020800.0);
+    p   = p * x2 - T (1.0 / 39916800.0);
+    p   = p * x2 + T (1.0 / 362880.0);
+    p   = p * x2 - T (1.0 / 5040.0);
+    p   = p * x2 + T (1.0 / 120.0);
+    p   = p * x2 - T (1.0 / 6.0);
+    return p * x2 + T (1);
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline T
+slerpAcos (T x) IMATH_NOEXCEPT
+{
+    T p = T (-0.0012624911);
+    p   = p * x + T (0.0066700901);
+    p   = p * x + T (-0.0170881256);
+    p   = p * x + T (0.0308918810);
+    p   = p * x + T (-0.0501743046);
+    p   = p * x + T (0.0889789874);
+    p   = p * x + T (-0.2145988016);
+    p   = p * x + T (1.5707963050);
+    return std::sqrt (1 - x) * p;
+}
+
+//
+// The interpolation itself, given the angle between q1 and q2 and
+// sinx_over_x of that angle. The result has unit length up to the
+// error of the approximation, so a single Newton step for 1/sqrt(x)
+// near x = 1 normalizes it, without a sqrt or a branch that would
+// keep the array version from vectorizing.
+//
+
+template <class T>
+IMATH_HOSTDEVICE inline Quat<T>
+slerpApproxNormalize (T c1, const Quat<T>& q1, T c2, const Quat<T>& q2)
+    IMATH_NOEXCEPT
+{
+    T r  = c1 * q1.r + c2 * q2.r;
+    T vx = c1 * q1.v.x + c2 * q2.v.x;
+    T vy = c1 * q1.v.y + c2 * q2.v.y;
+    T vz = c1 * q1.v.z + c2 * q2.v.z;
+
+    T l2  = r * r + vx * vx + vy * vy + vz * vz;
+    T inv = (3 - l2) / 2;
+
+    return Quat<T> (r * inv, vx * inv, vy * inv, vz * inv);
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline Quat<T>
+slerpApproxAngle (
+    const Quat<T>& q1, const Quat<T>& q2, T a, T sinAngleOverAngle, T t)
+    IMATH_NOEXCEPT
+{
+    T s  = 1 - t;
+    T c1 = s * slerpSinxOverX (s * a * s * a) / sinAngleOverAngle;
+    T c2 = t * slerpSinxOverX (t * a * t * a) / sinAngleOverAngle;
+
+    return slerpApproxNormalize (c1, q1, c2, q2);
+}
+
+/// @endcond
+
+///
+/// An approximation of slerp() that replaces the trigonometric
+/// functions with polynomials. Like slerp(), it assumes `q1` and `q2`
+/// are normalized and does not take the shortest arc.
+///
+/// When `q1 ^ q2 >= 0`, as after choosing the shortest arc, the
+/// rotation it represents differs from that of slerp() by less than
+/// 4e-7 radians for float, which is the accuracy of slerp() itself, and
+/// 5e-9 radians for double. The error grows as `q2` approaches `-q1`,
+/// where slerp() is ill-conditioned; at an angle of 0.9 pi between the
+/// quaternions it is about 2e-6 radians for float and 1.5e-8 radians
+/// for double.
+///
+
+template <class T>
+IMATH_HOSTDEVICE inline Quat<T>
+slerpApprox (const Quat<T>& q1, const Quat<T>& q2, T t) IMATH_NOEXCEPT
+{
+    T x = q1 ^ q2;
+    x   = x < -1 ? T (-1) : (x > 1 ? T (1) : x);
+
+    T a = slerpAcos (x < 0 ? -x : x);
+    a   = x < 0 ? T (M_PI) - a : a;
+
+    return slerpApproxAngle (q1, q2, a, slerpSinxOverX (a * a), t);
+}
+
+///
+/// The array version of slerpApprox(): set `result[i]` to an
+/// approximation of `slerp (keys[i].q1, keys[i].q2, t[i])`. The angle
+/// between each pair is precomputed exactly, so the error is no larger
+/// than that of slerpApprox(), and for double, much smaller.
+///
+/// @param keys The keys
+/// @param t The interpolation parameters, one per key
+/// @param[out] result The interpolated quaternions
+/// @param n The number of keys
+///
+
+template <class T>
+IMATH_HOSTDEVICE inline void
+slerpApprox (const SlerpKey<T>* keys, const T* t, Quat<T>* result, size_t n)
+    IMATH_NOEXCEPT
+{
+    //
+    // The coefficients are computed a block at a time, in a loop that
+    // vectorizes across keys, and then applied to the quaternions.
+    //
+
+    const size_t B = 64;
+    T            c1[B], c2[B];
+
+    for (size_t first = 0; first < n; first += B)
+    {
+        const size_t m = n - first < B ? n - first : B;
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            c1[i] = keys[first + i].angle;
+            c2[i] = keys[first + i].sinAngleOverAngle;
+        }
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            T a   = c1[i];
+            T d   = c2[i];
+            T u   = t[first + i];
+            T s   = 1 - u;
+            c1[i] = s * slerpSinxOverX (s * a * s * a) / d;
+            c2[i] = u * slerpSinxOverX (u * a * u * a) / d;
+        }
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            const SlerpKey<T>& k = keys[first + i];
+            result[first + i] = slerpApproxNormalize (c1[i], k.q1, c2[i], k.q2);
+        }
+    }
+}
+
+///
+/// An approximation of squad() built from three calls to
+/// slerpApprox().
+///
+
+template <class T>
+IMATH_HOSTDEVICE inline Quat<T>
+squadApprox (
+    const Quat<T>& q1,
+    const Quat<T>& qa,
+    const Quat<T>& qb,
+    const Quat<T>& q2,
+    T              t) IMATH_NOEXCEPT
+{
+    Quat<T> r1 = slerpApprox (q1, q2, t);
+    Quat<T> r2 = slerpApprox (qa, qb, t);
+    return slerpApprox (r1, r2, 2 * t * (1 - t));
+}
+
 #if (defined _WIN32 || defined _WIN64) && defined _MSC_VER
 #    pragma warning(pop)
 #endif
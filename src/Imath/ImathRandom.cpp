@@ -12,6 +12,7 @@
 
 #include "ImathRandom.h"
 #include <cstdint>
+#include <cstring>
 
 IMATH_INTERNAL_NAMESPACE_SOURCE_ENTER
 namespace
@@ -68,6 +69,115 @@ rand48Next (unsigned short state[3])
     state[0] = (unsigned short) (x);
 }
 
+//
+// The coefficients of the linear congruential step x -> a * x + c,
+// applied n times, computed by repeated squaring. The arithmetic wraps
+// modulo the range of U, which for a power of two m no greater than
+// that range is also correct modulo m.
+//
+
+template <class U>
+void
+lcgSkip (U& a, U& c, unsigned long long n)
+{
+    U an = 1;
+    U cn = 0;
+
+    while (n)
+    {
+        if (n & 1)
+        {
+            an = an * a;
+            cn = cn * a + c;
+        }
+
+        c = (a + 1) * c;
+        a = a * a;
+        n >>= 1;
+    }
+
+    a = an;
+    c = cn;
+}
+
+//
+// The bulk generators advance a block of consecutive states by the
+// block size at a time. The lanes are independent, so the compiler
+// vectorizes the loops over them.
+//
+
+const int lanes = 8;
+
+uint64_t
+rand48Get (const unsigned short state[3])
+{
+    return (uint64_t (state[2]) << 32) | (uint64_t (state[1]) << 16) |
+           uint64_t (state[0]);
+}
+
+void
+rand48Set (unsigned short state[3], uint64_t x)
+{
+    state[2] = (unsigned short) (x >> 32);
+    state[1] = (unsigned short) (x >> 16);
+    state[0] = (unsigned short) (x);
+}
+
+const uint64_t rand48A    = uint64_t (0x5deece66dLL);
+const uint64_t rand48C    = uint64_t (0xbLL);
+const uint64_t rand48Mask = (uint64_t (1) << 48) - 1;
+
+//
+// The float in [0, 1[ whose significand is the 23 most significant
+// bits of the 48-bit state `x`.
+//
+
+inline float
+rand48Float (uint64_t x)
+{
+    uint32_t bits = 0x3f800000 | uint32_t (x >> 25);
+    float    f;
+
+    std::memcpy (&f, &bits, sizeof (f));
+    return f - 1;
+}
+
+//
+// Call `store(i, x)` with the 48-bit states that produce the next `n`
+// values of a Rand48 sequence, starting at `state`, and return the
+// number of values stored, a multiple of the block size.
+//
+
+template <class Store>
+size_t
+rand48Blocks (const unsigned short state[3], size_t n, Store store)
+{
+    uint64_t x = rand48Get (state);
+    uint64_t s[lanes];
+
+    for (int k = 0; k < lanes; ++k)
+    {
+        x    = (rand48A * x + rand48C) & rand48Mask;
+        s[k] = x;
+    }
+
+    uint64_t a = rand48A;
+    uint64_t c = rand48C;
+    lcgSkip (a, c, lanes);
+
+    size_t i = 0;
+
+    for (; i + lanes <= n; i += lanes)
+    {
+        store (i, s);
+
+        for (int k = 0; k < lanes; ++k)
+            s[k] = (a * s[k] + c) & rand48Mask;
+    }
+
+    return i;
+}
+
 } // namespace
 
 ///
@@ -167,4 +277,131 @@ Rand32::nextf ()
     return u.f - 1;
 }
 
+void
+Rand32::skip (unsigned long long n)
+{
+    unsigned long int a = 1664525L;
+    unsigned long int c = 1013904223L;
+
+    lcgSkip (a, c, n);
+    _state = a * _state + c;
+}
+
+void
+Rand32::fill (float* dst, size_t n)
+{
+    //
+    // nextf() only depends on the low 23 bits of the state, so the
+    // lanes run modulo 2^32, and the full state is skipped at the end.
+    //
+
+    unsigned long int start = _state;
+    size_t            i     = 0;
+
+    if (n >= size_t (lanes))
+    {
+        uint32_t s[lanes];
+
+        for (int k = 0; k < lanes; ++k)
+        {
+            next ();
+            s[k] = uint32_t (_state);
+        }
+
+        uint32_t a = 1664525U;
+        uint32_t c = 1013904223U;
+        lcgSkip (a, c, lanes);
+
+        for (; i + lanes <= n; i += lanes)
+        {
+            uint32_t bits[lanes];
+            float    f[lanes];
+
+            for (int k = 0; k < lanes; ++k)
+            {
+                bits[k] = 0x3f800000 | (s[k] & 0x7fffff);
+                s[k]    = a * s[k] + c;
+            }
+
+            std::memcpy (f, bits, sizeof (f));
+
+            for (int k = 0; k < lanes; ++k)
+                dst[i + k] = f[k] - 1;
+        }
+
+        _state = start;
+        skip (i);
+    }
+
+    for (; i < n; ++i)
+        dst[i] = nextf ();
+}
+
+void
+Rand32::fill (float* dst, size_t n, float rangeMin, float rangeMax)
+{
+    fill (dst, n);
+
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = rangeMin * (1 - dst[i]) + rangeMax * dst[i];
+}
+
+void
+Rand48::skip (unsigned long long n)
+{
+    uint64_t a = rand48A;
+    uint64_t c = rand48C;
+
+    lcgSkip (a, c, n);
+    rand48Set (_state, (a * rand48Get (_state) + c) & rand48Mask);
+}
+
+void
+Rand48::fill (double* dst, size_t n)
+{
+    //
+    // The same bits as erand48().
+    //
+
+    size_t i = rand48Blocks (_state, n, [dst] (size_t j, const uint64_t* s) {
+        uint64_t bits[lanes];
+        double   d[lanes];
+
+        for (int k = 0; k < lanes; ++k)
+            bits[k] = (uint64_t (0x3ff) << 52) | (s[k] << 4) | (s[k] >> 44);
+
+        std::memcpy (d, bits, sizeof (d));
+
+        for (int k = 0; k < lanes; ++k)
+            dst[j + k] = d[k] - 1;
+    });
+
+    skip (i);
+
+    for (; i < n; ++i)
+        dst[i] = nextf ();
+}
+
+void
+Rand48::fill (float* dst, size_t n)
+{
+    //
+    // The 23 most significant bits of the state are the float
+    // significand.
+    //
+
+    size_t i = rand48Blocks (_state, n, [dst] (size_t j, const uint64_t* s) {
+        for (int k = 0; k < lanes; ++k)
+            dst[j + k] = rand48Float (s[k]);
+    });
+
+    skip (i);
+
+    for (; i < n; ++i)
+    {
+        rand48Next (_state);
+        dst[i] = rand48Float (rand48Get (_state));
+    }
+}
+
 IMATH_INTERNAL_NAMESPACE_SOURCE_EXIT
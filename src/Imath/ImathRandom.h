@@ -22,6 +22,7 @@
 #include "ImathNamespace.h"
 
 #include <math.h>
+#include <stddef.h>
 #include <stdlib.h>
 
 IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
@@ -50,6 +51,31 @@ public:
     /// Get the next value in the sequence (range [rangeMin ... rangeMax[)
     IMATH_HOSTDEVICE float nextf (float rangeMin, float rangeMax);
 
+    /// Advance the sequence by `n` values in O(log n) time, as if
+    /// next() had been called `n` times. Generators with the same seed
+    /// skipped by multiples of a block size yield independent,
+    /// non-overlapping substreams.
+    void skip (unsigned long long n);
+
+    /// Store the next `n` values of the sequence in `dst`, the same
+    /// values as `n` calls of nextf(), computing several at a time.
+    void fill (float* dst, size_t n);
+
+    /// Store the next `n` values of the sequence in `dst`, in
+    /// [rangeMin ... rangeMax[, the same values as nextf(rangeMin,
+    /// rangeMax).
+    void fill (float* dst, size_t n, float rangeMin, float rangeMax);
+
+    /// Store the next `n` values of the sequence in `dst`, in tasks of
+    /// 16384 values, each with its own generator skipped to the start
+    /// of the task. `executor` is called as `executor(numTasks, task)`
+    /// and must call `task(i)` for every `i` in [0, numTasks), in any
+    /// order and possibly concurrently, before returning; the same
+    /// convention as BVH::Executor. The values, and the state of the
+    /// generator afterwards, are the same as without an executor.
+    template <class Executor>
+    void fill (float* dst, size_t n, const Executor& executor);
+
 private:
     IMATH_HOSTDEVICE void next ();
 
@@ -80,6 +106,23 @@ public:
     /// Get the next value in the sequence (range [rangeMin ... rangeMax[)
     IMATH_HOSTDEVICE double nextf (double rangeMin, double rangeMax);
 
+    /// Advance the sequence by `n` values in O(log n) time, as if
+    /// nextf() had been called `n` times. See Rand32::skip().
+    IMATH_EXPORT void skip (unsigned long long n);
+
+    /// Store the next `n` values of the sequence in `dst`, the same
+    /// values as `n` calls of nextf(), computing several at a time.
+    IMATH_EXPORT void fill (double* dst, size_t n);
+
+    /// Store the next `n` values of the sequence in `dst`, truncated
+    /// to multiples of 2^-23 like those of Rand32 (range: [0 ... 1[).
+    IMATH_EXPORT void fill (float* dst, size_t n);
+
+    /// Store the next `n` values of the sequence in `dst`, using
+    /// `executor` to run the tasks. See Rand32::fill().
+    template <class T, class Executor>
+    void fill (T* dst, size_t n, const Executor& executor);
+
 private:
     unsigned short int _state[3];
 };
@@ -199,6 +242,48 @@ Rand48::nextf (double rangeMin, double rangeMax)
     return rangeMin * (1 - f) + rangeMax * f;
 }
 
+/// @cond Doxygen_Suppress
+
+//
+// Fill `dst` with the next `n` values of `rand` in tasks of 16384
+// values, each generated by a copy of `rand` skipped to its start.
+//
+
+template <class Rand, class T, class Executor>
+inline void
+fillRand (Rand& rand, T* dst, size_t n, const Executor& executor)
+{
+    const size_t grain = 16384;
+    const Rand   start = rand;
+
+    executor ((n + grain - 1) / grain, [=] (size_t task) {
+        size_t begin = task * grain;
+        size_t count = n - begin < grain ? n - begin : grain;
+        Rand   r     = start;
+
+        r.skip (begin);
+        r.fill (dst + begin, count);
+    });
+
+    rand.skip (n);
+}
+
+/// @endcond
+
+template <class Executor>
+inline void
+Rand32::fill (float* dst, size_t n, const Executor& executor)
+{
+    fillRand (*this, dst, n, executor);
+}
+
+template <class T, class Executor>
+inline void
+Rand48::fill (T* dst, size_t n, const Executor& executor)
+{
+    fillRand (*this, dst, n, executor);
+}
+
 template <class Vec, class Rand>
 IMATH_HOSTDEVICE Vec
 solidSphereRand (Rand& rand)
@@ -932,6 +932,159 @@ private:
     IMATH_HOSTDEVICE IMATH_CONSTEXPR14 T lengthTiny () const IMATH_NOEXCEPT;
 };
 
+///
+/// 3-element vector padded to the size of four elements and aligned to
+/// that size: 16 bytes for float, 32 for double. A Vec3A fills one
+/// SIMD register, and with IMATH_ENABLE_SIMD the Matrix44 transforms
+/// of Vec3A<float> load, transform and store each vector as a whole.
+/// That pays off most when the matrix changes from one vector to the
+/// next; to transform many vectors by one matrix, an array of Vec3 or
+/// a Vec3Array vectorizes as well or better.
+///
+/// Vec3A converts implicitly to and from Vec3, and its arithmetic gives
+/// the same results as that of Vec3.
+///
+/// The padding is not a member: it has no defined value, and the
+/// transforms may overwrite it. Before C++17, standard containers do
+/// not honor the 32-byte alignment of Vec3A<double>.
+///
+
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec3A
+{
+public:
+    /// @{
+    /// @name Direct access to elements
+
+    // The alignment of x sets that of the class, and so its size.
+    alignas (4 * sizeof (T)) T x;
+    T y, z;
+
+    /// @}
+
+    /// Element access by index.
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 T& operator[] (int i) IMATH_NOEXCEPT;
+
+    /// Element access by index.
+    IMATH_HOSTDEVICE constexpr const T& operator[] (int i) const IMATH_NOEXCEPT;
+
+    /// @{
+    ///	@name Constructors and Assignment
+
+    /// Uninitialized by default
+    IMATH_HOSTDEVICE Vec3A () IMATH_NOEXCEPT;
+
+    /// Initialize to a scalar `(a,a,a)`
+    IMATH_HOSTDEVICE constexpr explicit Vec3A (T a) IMATH_NOEXCEPT;
+
+    /// Initialize to given elements `(a,b,c)`
+    IMATH_HOSTDEVICE constexpr Vec3A (T a, T b, T c) IMATH_NOEXCEPT;
+
+    /// Construct from a Vec3
+    IMATH_HOSTDEVICE constexpr Vec3A (const Vec3<T>& v) IMATH_NOEXCEPT;
+
+    /// Convert to a Vec3
+    IMATH_HOSTDEVICE constexpr operator Vec3<T> () const IMATH_NOEXCEPT;
+
+    /// @}
+
+    /// @{
+    /// @name Arithmetic and Comparison
+
+    /// Equality
+    IMATH_HOSTDEVICE constexpr bool
+    operator== (const Vec3A& v) const IMATH_NOEXCEPT;
+
+    /// Inequality
+    IMATH_HOSTDEVICE constexpr bool
+    operator!= (const Vec3A& v) const IMATH_NOEXCEPT;
+
+    /// Dot product
+    IMATH_HOSTDEVICE constexpr T dot (const Vec3A& v) const IMATH_NOEXCEPT;
+
+    /// Right-handed cross product
+    IMATH_HOSTDEVICE constexpr Vec3A
+    cross (const Vec3A& v) const IMATH_NOEXCEPT;
+
+    /// Component-wise addition
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 const Vec3A&
+    operator+= (const Vec3A& v) IMATH_NOEXCEPT;
+
+    /// Component-wise addition
+    IMATH_HOSTDEVICE constexpr Vec3A
+    operator+ (const Vec3A& v) const IMATH_NOEXCEPT;
+
+    /// Component-wise subtraction
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 const Vec3A&
+    operator-= (const Vec3A& v) IMATH_NOEXCEPT;
+
+    /// Component-wise subtraction
+    IMATH_HOSTDEVICE constexpr Vec3A
+    operator- (const Vec3A& v) const IMATH_NOEXCEPT;
+
+    /// Component-wise multiplication by -1
+    IMATH_HOSTDEVICE constexpr Vec3A operator- () const IMATH_NOEXCEPT;
+
+    /// Component-wise multiplication
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 const Vec3A&
+    operator*= (const Vec3A& v) IMATH_NOEXCEPT;
+
+    /// Component-wise multiplication
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 const Vec3A&
+    operator*= (T a) IMATH_NOEXCEPT;
+
+    /// Component-wise multiplication
+    IMATH_HOSTDEVICE constexpr Vec3A
+    operator* (const Vec3A& v) const IMATH_NOEXCEPT;
+
+    /// Component-wise multiplication
+    IMATH_HOSTDEVICE constexpr Vec3A operator* (T a) const IMATH_NOEXCEPT;
+
+    /// Component-wise division
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 const Vec3A&
+    operator/= (const Vec3A& v) IMATH_NOEXCEPT;
+
+    /// Component-wise division
+    IMATH_HOSTDEVICE IMATH_CONSTEXPR14 const Vec3A&
+    operator/= (T a) IMATH_NOEXCEPT;
+
+    /// Component-wise division
+    IMATH_HOSTDEVICE constexpr Vec3A
+    operator/ (const Vec3A& v) const IMATH_NOEXCEPT;
+
+    /// Component-wise division
+    IMATH_HOSTDEVICE constexpr Vec3A operator/ (T a) const IMATH_NOEXCEPT;
+
+    /// @}
+
+    /// @{
+    /// @name Query and Manipulation
+
+    /// Return the Euclidean norm, as Vec3::length() does
+    IMATH_HOSTDEVICE T length () const IMATH_NOEXCEPT;
+
+    /// Return the square of the Euclidean norm, i.e. the dot product
+    /// with itself.
+    IMATH_HOSTDEVICE constexpr T length2 () const IMATH_NOEXCEPT;
+
+    /// Normalize in place. If length()==0, return a null vector.
+    IMATH_HOSTDEVICE const Vec3A& normalize () IMATH_NOEXCEPT;
+
+    /// Return a normalized vector. Does not modify *this.
+    IMATH_HOSTDEVICE Vec3A normalized () const IMATH_NOEXCEPT;
+
+    /// @}
+
+    /// Return the number of dimensions, i.e. 3
+    IMATH_HOSTDEVICE constexpr static unsigned int dimensions () IMATH_NOEXCEPT
+    {
+        return 3;
+    }
+
+    /// The base type: In templates that accept a parameter `V`, you
+    /// can refer to `T` as `V::BaseType`
+    typedef T BaseType;
+};
+
 /// Stream output, as "(x y)"
 template <class T> std::ostream& operator<< (std::ostream& s, const Vec2<T>& v);
 
@@ -941,6 +1094,10 @@ template <class T> std::ostream& operator<< (std::ostream& s, const Vec3<T>& v);
 /// Stream output, as "(x y z w)"
 template <class T> std::ostream& operator<< (std::ostream& s, const Vec4<T>& v);
 
+/// Stream output, as "(x y z)"
+template <class T>
+std::ostream& operator<< (std::ostream& s, const Vec3A<T>& v);
+
 /// Reverse multiplication: S * Vec2<T>
 template <class T>
 IMATH_HOSTDEVICE constexpr Vec2<T>
@@ -956,6 +1113,11 @@ template <class T>
 IMATH_HOSTDEVICE constexpr Vec4<T>
 operator* (T a, const Vec4<T>& v) IMATH_NOEXCEPT;
 
+/// Reverse multiplication: S * Vec3A<T>
+template <class T>
+IMATH_HOSTDEVICE constexpr Vec3A<T>
+operator* (T a, const Vec3A<T>& v) IMATH_NOEXCEPT;
+
 //-------------------------
 // Typedefs for convenience
 //-------------------------
@@ -990,6 +1152,12 @@ typedef Vec3<float> V3f;
 /// Vec3 of double
 typedef Vec3<double> V3d;
 
+/// Padded and aligned Vec3 of float
+typedef Vec3A<float> V3fa;
+
+/// Padded and aligned Vec3 of double
+typedef Vec3A<double> V3da;
+
 /// Vec4 of short
 typedef Vec4<short> V4s;
 
@@ -2442,6 +2610,223 @@ Vec4<T>::normalizedNonNull () const IMATH_NOEXCEPT
     return Vec4 (x / l, y / l, z / l, w / l);
 }
 
+//------------------------
+// Implementation of Vec3A
+//------------------------
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline T&
+Vec3A<T>::operator[] (int i) IMATH_NOEXCEPT
+{
+    return (&x)[i]; // NOSONAR - suppress SonarCloud bug report.
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline const T&
+Vec3A<T>::operator[] (int i) const IMATH_NOEXCEPT
+{
+    return (&x)[i]; // NOSONAR - suppress SonarCloud bug report.
+}
+
+template <class T> IMATH_HOSTDEVICE inline Vec3A<T>::Vec3A () IMATH_NOEXCEPT
+{
+    // empty, and not constexpr because data is uninitialized.
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>::Vec3A (T a) IMATH_NOEXCEPT
+    : x (a),
+      y (a),
+      z (a)
+{}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>::Vec3A (T a, T b, T c)
+    IMATH_NOEXCEPT : x (a),
+                     y (b),
+                     z (c)
+{}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>::Vec3A (const Vec3<T>& v)
+    IMATH_NOEXCEPT : x (v.x),
+                     y (v.y),
+                     z (v.z)
+{}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>::operator Vec3<T> () const
+    IMATH_NOEXCEPT
+{
+    return Vec3<T> (x, y, z);
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline bool
+Vec3A<T>::operator== (const Vec3A& v) const IMATH_NOEXCEPT
+{
+    return x == v.x && y == v.y && z == v.z;
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline bool
+Vec3A<T>::operator!= (const Vec3A& v) const IMATH_NOEXCEPT
+{
+    return x != v.x || y != v.y || z != v.z;
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline T
+Vec3A<T>::dot (const Vec3A& v) const IMATH_NOEXCEPT
+{
+    return x * v.x + y * v.y + z * v.z;
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>
+Vec3A<T>::cross (const Vec3A& v) const IMATH_NOEXCEPT
+{
+    return Vec3A (y * v.z - z * v.y, z * v.x - x * v.z, x * v.y - y * v.x);
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const Vec3A<T>&
+Vec3A<T>::operator+= (const Vec3A& v) IMATH_NOEXCEPT
+{
+    x += v.x;
+    y += v.y;
+    z += v.z;
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>
+Vec3A<T>::operator+ (const Vec3A& v) const IMATH_NOEXCEPT
+{
+    return Vec3A (x + v.x, y + v.y, z + v.z);
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const Vec3A<T>&
+Vec3A<T>::operator-= (const Vec3A& v) IMATH_NOEXCEPT
+{
+    x -= v.x;
+    y -= v.y;
+    z -= v.z;
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>
+Vec3A<T>::operator- (const Vec3A& v) const IMATH_NOEXCEPT
+{
+    return Vec3A (x - v.x, y - v.y, z - v.z);
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>
+Vec3A<T>::operator- () const IMATH_NOEXCEPT
+{
+    return Vec3A (-x, -y, -z);
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const Vec3A<T>&
+Vec3A<T>::operator*= (const Vec3A& v) IMATH_NOEXCEPT
+{
+    x *= v.x;
+    y *= v.y;
+    z *= v.z;
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const Vec3A<T>&
+Vec3A<T>::operator*= (T a) IMATH_NOEXCEPT
+{
+    x *= a;
+    y *= a;
+    z *= a;
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>
+Vec3A<T>::operator* (const Vec3A& v) const IMATH_NOEXCEPT
+{
+    return Vec3A (x * v.x, y * v.y, z * v.z);
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>
+Vec3A<T>::operator* (T a) const IMATH_NOEXCEPT
+{
+    return Vec3A (x * a, y * a, z * a);
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const Vec3A<T>&
+Vec3A<T>::operator/= (const Vec3A& v) IMATH_NOEXCEPT
+{
+    x /= v.x;
+    y /= v.y;
+    z /= v.z;
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE IMATH_CONSTEXPR14 inline const Vec3A<T>&
+Vec3A<T>::operator/= (T a) IMATH_NOEXCEPT
+{
+    x /= a;
+    y /= a;
+    z /= a;
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>
+Vec3A<T>::operator/ (const Vec3A& v) const IMATH_NOEXCEPT
+{
+    return Vec3A (x / v.x, y / v.y, z / v.z);
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>
+Vec3A<T>::operator/ (T a) const IMATH_NOEXCEPT
+{
+    return Vec3A (x / a, y / a, z / a);
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline T
+Vec3A<T>::length () const IMATH_NOEXCEPT
+{
+    return Vec3<T> (x, y, z).length ();
+}
+
+template <class T>
+IMATH_HOSTDEVICE constexpr inline T
+Vec3A<T>::length2 () const IMATH_NOEXCEPT
+{
+    return dot (*this);
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline const Vec3A<T>&
+Vec3A<T>::normalize () IMATH_NOEXCEPT
+{
+    *this = Vec3<T> (x, y, z).normalize ();
+    return *this;
+}
+
+template <class T>
+IMATH_HOSTDEVICE inline Vec3A<T>
+Vec3A<T>::normalized () const IMATH_NOEXCEPT
+{
+    return Vec3<T> (x, y, z).normalized ();
+}
+
 //-----------------------------
 // Stream output implementation
 //-----------------------------
@@ -2467,6 +2852,13 @@ operator<< (std::ostream& s, const Vec4<T>& v)
     return s << '(' << v.x << ' ' << v.y << ' ' << v.z << ' ' << v.w << ')';
 }
 
+template <class T>
+std::ostream&
+operator<< (std::ostream& s, const Vec3A<T>& v)
+{
+    return s << '(' << v.x << ' ' << v.y << ' ' << v.z << ')';
+}
+
 //-----------------------------------------
 // Implementation of reverse multiplication
 //-----------------------------------------
@@ -2492,6 +2884,13 @@ operator* (T a, const Vec4<T>& v) IMATH_NOEXCEPT
     return Vec4<T> (a * v.x, a * v.y, a * v.z, a * v.w);
 }
 
+template <class T>
+IMATH_HOSTDEVICE constexpr inline Vec3A<T>
+operator* (T a, const Vec3A<T>& v) IMATH_NOEXCEPT
+{
+    return Vec3A<T> (a * v.x, a * v.y, a * v.z);
+}
+
 #if (defined _WIN32 || defined _WIN64) && defined _MSC_VER
 #    pragma warning(pop)
 #endif
@@ -0,0 +1,594 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+//
+// Batch operations on structure-of-arrays vector arrays
+//
+
+#include "ImathVecArray.h"
+#include <cmath>
+#include <limits>
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_ENTER
+
+namespace
+{
+
+//
+// The component arrays of a vector array, so that the operations can
+// be written once for all dimensions.
+//
+
+template <class T>
+void
+components (const Vec2Array<T>& a, const T* (&c)[2])
+{
+    c[0] = a.x ();
+    c[1] = a.y ();
+}
+
+template <class T>
+void
+components (Vec2Array<T>& a, T* (&c)[2])
+{
+    c[0] = a.x ();
+    c[1] = a.y ();
+}
+
+template <class T>
+void
+components (const Vec3Array<T>& a, const T* (&c)[3])
+{
+    c[0] = a.x ();
+    c[1] = a.y ();
+    c[2] = a.z ();
+}
+
+template <class T>
+void
+components (Vec3Array<T>& a, T* (&c)[3])
+{
+    c[0] = a.x ();
+    c[1] = a.y ();
+    c[2] = a.z ();
+}
+
+template <class T>
+void
+components (const Vec4Array<T>& a, const T* (&c)[4])
+{
+    c[0] = a.x ();
+    c[1] = a.y ();
+    c[2] = a.z ();
+    c[3] = a.w ();
+}
+
+template <class T>
+void
+components (Vec4Array<T>& a, T* (&c)[4])
+{
+    c[0] = a.x ();
+    c[1] = a.y ();
+    c[2] = a.z ();
+    c[3] = a.w ();
+}
+
+//
+// The length of a single vector, computed by the Vec class itself
+//
+
+template <class T>
+T
+lengthAt (const T* const (&c)[2], size_t i)
+{
+    return Vec2<T> (c[0][i], c[1][i]).length ();
+}
+
+template <class T>
+T
+lengthAt (const T* const (&c)[3], size_t i)
+{
+    return Vec3<T> (c[0][i], c[1][i], c[2][i]).length ();
+}
+
+template <class T>
+T
+lengthAt (const T* const (&c)[4], size_t i)
+{
+    return Vec4<T> (c[0][i], c[1][i], c[2][i], c[3][i]).length ();
+}
+
+//
+// An operation whose result may be the same array as one of its
+// arguments works on blocks of this many vectors, which it computes
+// into local arrays and then copies out. The compiler does not
+// vectorize a loop whose output may be the same as one of its inputs.
+//
+
+const size_t block = 64;
+
+inline size_t
+blockSize (size_t j, size_t n)
+{
+    return (n - j < block) ? n - j : block;
+}
+
+//
+// The sum of the products of the components, in the same order as
+// Vec::dot(), so that the results agree to within rounding.
+//
+
+template <class T, int N>
+inline T
+dotAt (const T* const (&a)[N], const T* const (&b)[N], size_t i)
+{
+    T d = a[0][i] * b[0][i];
+
+    for (int c = 1; c < N; ++c)
+        d += a[c][i] * b[c][i];
+
+    return d;
+}
+
+template <class T, int N>
+void
+dotKernel (const T* const (&a)[N], const T* const (&b)[N], T* r, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        r[i] = dotAt<T, N> (a, b, i);
+}
+
+//
+// Vec::length() returns the square root of dot(), except for vectors
+// so short that dot() underflows, whose lengths it computes with
+// lengthTiny(). Those are rare, so the main loop only counts them,
+// and a second loop fixes up their lengths if there were any.
+//
+
+template <class T, int N>
+void
+lengthKernel (const T* const (&a)[N], T* r, size_t n)
+{
+    const T tiny  = T (2) * std::numeric_limits<T>::min ();
+    size_t  count = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        T l2 = dotAt<T, N> (a, a, i);
+        r[i] = std::sqrt (l2);
+        count += l2 < tiny;
+    }
+
+    if (count)
+    {
+        for (size_t i = 0; i < n; ++i)
+            if (dotAt<T, N> (a, a, i) < tiny) r[i] = lengthAt<T> (a, i);
+    }
+}
+
+//
+// Like Vec::normalize(), divide by the length rather than multiply by
+// its reciprocal, which can overflow. Null vectors are divided by 1
+// instead, which leaves them unchanged without a branch.
+//
+
+template <class T, int N>
+void
+normalizeKernel (T* const (&a)[N], size_t n)
+{
+    T l[block];
+
+    for (size_t j = 0; j < n; j += block)
+    {
+        const size_t m = blockSize (j, n);
+        const T*     s[N];
+
+        for (int c = 0; c < N; ++c)
+            s[c] = a[c] + j;
+
+        lengthKernel<T, N> (s, l, m);
+
+        for (size_t i = 0; i < m; ++i)
+            l[i] += T (l[i] == T (0));
+
+        for (int c = 0; c < N; ++c)
+        {
+            T* x = a[c] + j;
+
+            for (size_t i = 0; i < m; ++i)
+                x[i] /= l[i];
+        }
+    }
+}
+
+template <class T, int N>
+void
+lerpKernel (
+    const T* const (&a)[N], const T* const (&b)[N], T t, T* const (&r)[N],
+    size_t n)
+{
+    T tr[block];
+
+    for (int c = 0; c < N; ++c)
+    {
+        for (size_t j = 0; j < n; j += block)
+        {
+            const size_t m  = blockSize (j, n);
+            const T*     ac = a[c] + j;
+            const T*     bc = b[c] + j;
+
+            for (size_t i = 0; i < m; ++i)
+                tr[i] = ac[i] * (1 - t) + bc[i] * t;
+
+            for (size_t i = 0; i < m; ++i)
+                r[c][j + i] = tr[i];
+        }
+    }
+}
+
+} // namespace
+
+template <class T>
+void
+dot (const Vec2Array<T>& a, const Vec2Array<T>& b, T* result)
+{
+    const T *ca[2], *cb[2];
+    components (a, ca);
+    components (b, cb);
+    dotKernel<T, 2> (ca, cb, result, a.size ());
+}
+
+template <class T>
+void
+dot (const Vec3Array<T>& a, const Vec3Array<T>& b, T* result)
+{
+    const T *ca[3], *cb[3];
+    components (a, ca);
+    components (b, cb);
+    dotKernel<T, 3> (ca, cb, result, a.size ());
+}
+
+template <class T>
+void
+dot (const Vec4Array<T>& a, const Vec4Array<T>& b, T* result)
+{
+    const T *ca[4], *cb[4];
+    components (a, ca);
+    components (b, cb);
+    dotKernel<T, 4> (ca, cb, result, a.size ());
+}
+
+template <class T>
+void
+cross (const Vec3Array<T>& a, const Vec3Array<T>& b, Vec3Array<T>& result)
+{
+    const size_t n = a.size ();
+    result.resize (n);
+
+    const T *ax = a.x (), *ay = a.y (), *az = a.z ();
+    const T *bx = b.x (), *by = b.y (), *bz = b.z ();
+    T *      rx = result.x (), *ry = result.y (), *rz = result.z ();
+    T        tx[block], ty[block], tz[block];
+
+    for (size_t j = 0; j < n; j += block)
+    {
+        const size_t m = blockSize (j, n);
+
+        for (size_t i = 0; i < m; ++i)
+        {
+            const size_t k = j + i;
+
+            tx[i] = ay[k] * bz[k] - az[k] * by[k];
+            ty[i] = az[k] * bx[k] - ax[k] * bz[k];
+            tz[i] = ax[k] * by[k] - ay[k] * bx[k];
+        }
+
+        for (size_t i = 0; i < m; ++i)
+            rx[j + i] = tx[i];
+        for (size_t i = 0; i < m; ++i)
+            ry[j + i] = ty[i];
+        for (size_t i = 0; i < m; ++i)
+            rz[j + i] = tz[i];
+    }
+}
+
+template <class T>
+void
+length (const Vec2Array<T>& a, T* result)
+{
+    const T* ca[2];
+    components (a, ca);
+    lengthKernel<T, 2> (ca, result, a.size ());
+}
+
+template <class T>
+void
+length (const Vec3Array<T>& a, T* result)
+{
+    const T* ca[3];
+    components (a, ca);
+    lengthKernel<T, 3> (ca, result, a.size ());
+}
+
+template <class T>
+void
+length (const Vec4Array<T>& a, T* result)
+{
+    const T* ca[4];
+    components (a, ca);
+    lengthKernel<T, 4> (ca, result, a.size ());
+}
+
+template <class T>
+void
+normalize (Vec2Array<T>& a)
+{
+    T* ca[2];
+    components (a, ca);
+    normalizeKernel<T, 2> (ca, a.size ());
+}
+
+template <class T>
+void
+normalize (Vec3Array<T>& a)
+{
+    T* ca[3];
+    components (a, ca);
+    normalizeKernel<T, 3> (ca, a.size ());
+}
+
+template <class T>
+void
+normalize (Vec4Array<T>& a)
+{
+    T* ca[4];
+    components (a, ca);
+    normalizeKernel<T, 4> (ca, a.size ());
+}
+
+template <class T>
+void
+lerp (const Vec2Array<T>& a, const Vec2Array<T>& b, T t, Vec2Array<T>& result)
+{
+    result.resize (a.size ());
+
+    const T *ca[2], *cb[2];
+    T*       cr[2];
+    components (a, ca);
+    components (b, cb);
+    components (result, cr);
+    lerpKernel<T, 2> (ca, cb, t, cr, a.size ());
+}
+
+template <class T>
+void
+lerp (const Vec3Array<T>& a, const Vec3Array<T>& b, T t, Vec3Array<T>& result)
+{
+    result.resize (a.size ());
+
+    const T *ca[3], *cb[3];
+    T*       cr[3];
+    components (a, ca);
+    components (b, cb);
+    components (result, cr);
+    lerpKernel<T, 3> (ca, cb, t, cr, a.size ());
+}
+
+template <class T>
+void
+lerp (const Vec4Array<T>& a, const Vec4Array<T>& b, T t, Vec4Array<T>& result)
+{
+    result.resize (a.size ());
+
+    const T *ca[4], *cb[4];
+    T*       cr[4];
+    components (a, ca);
+    components (b, cb);
+    components (result, cr);
+    lerpKernel<T, 4> (ca, cb, t, cr, a.size ());
+}
+
+template <class T>
+void
+multVecMatrix (const Matrix33<T>& m, const Vec2Array<T>& src, Vec2Array<T>& dst)
+{
+    const size_t n = src.size ();
+    dst.resize (n);
+
+    const T m00 = m[0][0], m01 = m[0][1], m02 = m[0][2];
+    const T m10 = m[1][0], m11 = m[1][1], m12 = m[1][2];
+    const T m20 = m[2][0], m21 = m[2][1], m22 = m[2][2];
+
+    const T *sx = src.x (), *sy = src.y ();
+    T *      dx = dst.x (), *dy = dst.y ();
+    T        tx[block], ty[block];
+
+    for (size_t j = 0; j < n; j += block)
+    {
+        const size_t bn = blockSize (j, n);
+
+        for (size_t i = 0; i < bn; ++i)
+        {
+            const T x = sx[j + i], y = sy[j + i];
+
+            T a = x * m00 + y * m10 + m20;
+            T b = x * m01 + y * m11 + m21;
+            T w = x * m02 + y * m12 + m22;
+
+            tx[i] = a / w;
+            ty[i] = b / w;
+        }
+
+        for (size_t i = 0; i < bn; ++i)
+            dx[j + i] = tx[i];
+        for (size_t i = 0; i < bn; ++i)
+            dy[j + i] = ty[i];
+    }
+}
+
+template <class T>
+void
+multDirMatrix (const Matrix33<T>& m, const Vec2Array<T>& src, Vec2Array<T>& dst)
+{
+    const size_t n = src.size ();
+    dst.resize (n);
+
+    const T m00 = m[0][0], m01 = m[0][1];
+    const T m10 = m[1][0], m11 = m[1][1];
+
+    const T *sx = src.x (), *sy = src.y ();
+    T *      dx = dst.x (), *dy = dst.y ();
+    T        tx[block], ty[block];
+
+    for (size_t j = 0; j < n; j += block)
+    {
+        const size_t bn = blockSize (j, n);
+
+        for (size_t i = 0; i < bn; ++i)
+        {
+            const T x = sx[j + i], y = sy[j + i];
+
+            tx[i] = x * m00 + y * m10;
+            ty[i] = x * m01 + y * m11;
+        }
+
+        for (size_t i = 0; i < bn; ++i)
+            dx[j + i] = tx[i];
+        for (size_t i = 0; i < bn; ++i)
+            dy[j + i] = ty[i];
+    }
+}
+
+template <class T>
+void
+multVecMatrix (const Matrix44<T>& m, const Vec3Array<T>& src, Vec3Array<T>& dst)
+{
+    dst.resize (src.size ());
+    m.multVecMatrix (
+        src.x (),
+        src.y (),
+        src.z (),
+        dst.x (),
+        dst.y (),
+        dst.z (),
+        src.size ());
+}
+
+template <class T>
+void
+multDirMatrix (const Matrix44<T>& m, const Vec3Array<T>& src, Vec3Array<T>& dst)
+{
+    dst.resize (src.size ());
+    m.multDirMatrix (
+        src.x (),
+        src.y (),
+        src.z (),
+        dst.x (),
+        dst.y (),
+        dst.z (),
+        src.size ());
+}
+
+template <class T>
+void
+multVecMatrix (const Matrix44<T>& m, const Vec4Array<T>& src, Vec4Array<T>& dst)
+{
+    const size_t n = src.size ();
+    dst.resize (n);
+
+    const T *ca[4];
+    T*       cd[4];
+    components (src, ca);
+    components (dst, cd);
+
+    T t[4][block];
+
+    for (size_t j = 0; j < n; j += block)
+    {
+        const size_t bn = blockSize (j, n);
+
+        for (int c = 0; c < 4; ++c)
+        {
+            const T m0 = m[0][c], m1 = m[1][c], m2 = m[2][c], m3 = m[3][c];
+
+            for (size_t i = 0; i < bn; ++i)
+            {
+                const size_t k = j + i;
+
+                t[c][i] =
+                    ca[0][k] * m0 + ca[1][k] * m1 + ca[2][k] * m2 +
+                    ca[3][k] * m3;
+            }
+        }
+
+        for (int c = 0; c < 4; ++c)
+            for (size_t i = 0; i < bn; ++i)
+                cd[c][j + i] = t[c][i];
+    }
+}
+
+template IMATH_EXPORT void
+dot (const V2fArray&, const V2fArray&, float*);
+template IMATH_EXPORT void
+dot (const V3fArray&, const V3fArray&, float*);
+template IMATH_EXPORT void
+dot (const V4fArray&, const V4fArray&, float*);
+template IMATH_EXPORT void
+cross (const V3fArray&, const V3fArray&, V3fArray&);
+template IMATH_EXPORT void length (const V2fArray&, float*);
+template IMATH_EXPORT void length (const V3fArray&, float*);
+template IMATH_EXPORT void length (const V4fArray&, float*);
+template IMATH_EXPORT void normalize (V2fArray&);
+template IMATH_EXPORT void normalize (V3fArray&);
+template IMATH_EXPORT void normalize (V4fArray&);
+template IMATH_EXPORT void
+lerp (const V2fArray&, const V2fArray&, float, V2fArray&);
+template IMATH_EXPORT void
+lerp (const V3fArray&, const V3fArray&, float, V3fArray&);
+template IMATH_EXPORT void
+lerp (const V4fArray&, const V4fArray&, float, V4fArray&);
+template IMATH_EXPORT void
+multVecMatrix (const M33f&, const V2fArray&, V2fArray&);
+template IMATH_EXPORT void
+multDirMatrix (const M33f&, const V2fArray&, V2fArray&);
+template IMATH_EXPORT void
+multVecMatrix (const M44f&, const V3fArray&, V3fArray&);
+template IMATH_EXPORT void
+multDirMatrix (const M44f&, const V3fArray&, V3fArray&);
+template IMATH_EXPORT void
+multVecMatrix (const M44f&, const V4fArray&, V4fArray&);
+
+template IMATH_EXPORT void
+dot (const V2dArray&, const V2dArray&, double*);
+template IMATH_EXPORT void
+dot (const V3dArray&, const V3dArray&, double*);
+template IMATH_EXPORT void
+dot (const V4dArray&, const V4dArray&, double*);
+template IMATH_EXPORT void
+cross (const V3dArray&, const V3dArray&, V3dArray&);
+template IMATH_EXPORT void length (const V2dArray&, double*);
+template IMATH_EXPORT void length (const V3dArray&, double*);
+template IMATH_EXPORT void length (const V4dArray&, double*);
+template IMATH_EXPORT void normalize (V2dArray&);
+template IMATH_EXPORT void normalize (V3dArray&);
+template IMATH_EXPORT void normalize (V4dArray&);
+template IMATH_EXPORT void
+lerp (const V2dArray&, const V2dArray&, double, V2dArray&);
+template IMATH_EXPORT void
+lerp (const V3dArray&, const V3dArray&, double, V3dArray&);
+template IMATH_EXPORT void
+lerp (const V4dArray&, const V4dArray&, double, V4dArray&);
+template IMATH_EXPORT void
+multVecMatrix (const M33d&, const V2dArray&, V2dArray&);
+template IMATH_EXPORT void
+multDirMatrix (const M33d&, const V2dArray&, V2dArray&);
+template IMATH_EXPORT void
+multVecMatrix (const M44d&, const V3dArray&, V3dArray&);
+template IMATH_EXPORT void
+multDirMatrix (const M44d&, const V3dArray&, V3dArray&);
+template IMATH_EXPORT void
+multVecMatrix (const M44d&, const V4dArray&, V4dArray&);
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_EXIT
@@ -0,0 +1,659 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+//
+// Arrays of 2D, 3D and 4D vectors stored as structure of arrays
+//
+
+#ifndef INCLUDED_IMATHVECARRAY_H
+#define INCLUDED_IMATHVECARRAY_H
+
+#include "ImathExport.h"
+#include "ImathNamespace.h"
+
+#include "ImathMatrix.h"
+#include "ImathVec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+IMATH_INTERNAL_NAMESPACE_HEADER_ENTER
+
+/// @cond Doxygen_Suppress
+
+//
+// The storage of an N-component vector array: one block of memory
+// holding the N component arrays one after the other. Each component
+// array starts on a 64-byte boundary, and the stride between them is
+// the capacity rounded up to a whole number of 64-byte lines.
+//
+
+template <class T, int N> class VecArrayStorage
+{
+public:
+    enum
+    {
+        alignment = 64,
+        lineSize  = alignment / sizeof (T)
+    };
+
+    VecArrayStorage () IMATH_NOEXCEPT : _size (0),
+                                        _stride (0),
+                                        _buffer (0),
+                                        _data (0)
+    {}
+
+    explicit VecArrayStorage (size_t n)
+        : _size (0), _stride (0), _buffer (0), _data (0)
+    {
+        resize (n);
+    }
+
+    VecArrayStorage (const VecArrayStorage& other)
+        : _size (0), _stride (0), _buffer (0), _data (0)
+    {
+        *this = other;
+    }
+
+    VecArrayStorage (VecArrayStorage&& other) IMATH_NOEXCEPT
+        : _size (other._size),
+          _stride (other._stride),
+          _buffer (other._buffer),
+          _data (other._data)
+    {
+        other._size   = 0;
+        other._stride = 0;
+        other._buffer = 0;
+        other._data   = 0;
+    }
+
+    ~VecArrayStorage () { delete[] _buffer; }
+
+    VecArrayStorage& operator= (const VecArrayStorage& other)
+    {
+        if (this != &other)
+        {
+            _size = 0;
+            resize (other._size);
+
+            for (int c = 0; c < N; ++c)
+                copy (component (c), other.component (c), _size);
+        }
+
+        return *this;
+    }
+
+    VecArrayStorage& operator= (VecArrayStorage&& other) IMATH_NOEXCEPT
+    {
+        if (this != &other)
+        {
+            delete[] _buffer;
+
+            _size   = other._size;
+            _stride = other._stride;
+            _buffer = other._buffer;
+            _data   = other._data;
+
+            other._size   = 0;
+            other._stride = 0;
+            other._buffer = 0;
+            other._data   = 0;
+        }
+
+        return *this;
+    }
+
+    size_t size () const IMATH_NOEXCEPT { return _size; }
+    size_t capacity () const IMATH_NOEXCEPT { return _stride; }
+
+    T*       component (int c) IMATH_NOEXCEPT { return _data + c * _stride; }
+    const T* component (int c) const IMATH_NOEXCEPT
+    {
+        return _data + c * _stride;
+    }
+
+    //
+    // Change the size, keeping the first min(size, n) vectors and
+    // setting the new ones to 0.
+    //
+
+    void resize (size_t n)
+    {
+        if (n > _stride)
+        {
+            size_t stride = (n + lineSize - 1) / lineSize * lineSize;
+
+            unsigned char* buffer =
+                new unsigned char[N * stride * sizeof (T) + alignment - 1];
+
+            uintptr_t p = reinterpret_cast<uintptr_t> (buffer);
+            p           = (p + alignment - 1) & ~uintptr_t (alignment - 1);
+            T* data     = reinterpret_cast<T*> (p);
+
+            for (int c = 0; c < N; ++c)
+                copy (data + c * stride, component (c), _size);
+
+            delete[] _buffer;
+            _stride = stride;
+            _buffer = buffer;
+            _data   = data;
+        }
+
+        for (int c = 0; c < N; ++c)
+            for (size_t i = _size; i < n; ++i)
+                component (c)[i] = T (0);
+
+        _size = n;
+    }
+
+    void swap (VecArrayStorage& other) IMATH_NOEXCEPT
+    {
+        VecArrayStorage t (static_cast<VecArrayStorage&&> (other));
+        other = static_cast<VecArrayStorage&&> (*this);
+        *this = static_cast<VecArrayStorage&&> (t);
+    }
+
+private:
+    static void copy (T* dst, const T* src, size_t n) IMATH_NOEXCEPT
+    {
+        if (n) std::memcpy (dst, src, n * sizeof (T));
+    }
+
+    size_t         _size;
+    size_t         _stride;
+    unsigned char* _buffer;
+    T*             _data;
+};
+
+/// @endcond
+
+///
+/// An array of 2D vectors stored as structure of arrays: the x and y
+/// components are in separate arrays, each aligned to 64 bytes. Loops
+/// over such arrays load whole SIMD registers of one component at a
+/// time, so the batch functions below run at the full vector width,
+/// which loops over an array of Vec2 do not.
+///
+/// The component arrays are available directly through x() and y(),
+/// for use with other code that works on structure of arrays, such as
+/// the structure-of-arrays Matrix44::multVecMatrix(). They are valid
+/// until the array is resized or destroyed.
+///
+/// Converting to and from an array of Vec2 is a copy; do it once, and
+/// keep bulk data in this form while it is processed.
+///
+
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec2Array
+{
+public:
+    /// Component type
+    typedef T BaseType;
+
+    /// The alignment of the component arrays, in bytes
+    static const size_t alignment = 64;
+
+    /// @{
+    /// @name Constructors and Assignment
+
+    /// An empty array
+    Vec2Array () IMATH_NOEXCEPT {}
+
+    /// An array of `n` zero vectors
+    explicit Vec2Array (size_t n) : _s (n) {}
+
+    /// A copy of the `n` vectors in `v`
+    Vec2Array (const Vec2<T>* v, size_t n) { assign (v, n); }
+
+    /// Replace the contents with a copy of the `n` vectors in `v`.
+    void assign (const Vec2<T>* v, size_t n)
+    {
+        resize (n);
+        T* xs = x ();
+        T* ys = y ();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            xs[i] = v[i].x;
+            ys[i] = v[i].y;
+        }
+    }
+
+    /// Copy the vectors to the `size()` elements of `v`.
+    void copyTo (Vec2<T>* v) const IMATH_NOEXCEPT
+    {
+        const T* xs = x ();
+        const T* ys = y ();
+
+        for (size_t i = 0; i < size (); ++i)
+            v[i] = Vec2<T> (xs[i], ys[i]);
+    }
+
+    /// @}
+
+    /// @{
+    /// @name Size
+
+    /// The number of vectors
+    size_t size () const IMATH_NOEXCEPT { return _s.size (); }
+
+    /// Return true if the array is empty.
+    bool empty () const IMATH_NOEXCEPT { return _s.size () == 0; }
+
+    /// The number of vectors the array can hold without reallocating
+    size_t capacity () const IMATH_NOEXCEPT { return _s.capacity (); }
+
+    /// Change the number of vectors, keeping the first ones and
+    /// setting new ones to zero.
+    void resize (size_t n) { _s.resize (n); }
+
+    /// Exchange the contents with those of `a`.
+    void swap (Vec2Array& a) IMATH_NOEXCEPT { _s.swap (a._s); }
+
+    /// @}
+
+    /// @{
+    /// @name Element Access
+
+    /// The x components
+    T* x () IMATH_NOEXCEPT { return _s.component (0); }
+
+    /// The x components
+    const T* x () const IMATH_NOEXCEPT { return _s.component (0); }
+
+    /// The y components
+    T* y () IMATH_NOEXCEPT { return _s.component (1); }
+
+    /// The y components
+    const T* y () const IMATH_NOEXCEPT { return _s.component (1); }
+
+    /// The vector at index `i`
+    Vec2<T> operator[] (size_t i) const IMATH_NOEXCEPT
+    {
+        return Vec2<T> (x ()[i], y ()[i]);
+    }
+
+    /// Set the vector at index `i` to `v`.
+    void set (size_t i, const Vec2<T>& v) IMATH_NOEXCEPT
+    {
+        x ()[i] = v.x;
+        y ()[i] = v.y;
+    }
+
+    /// @}
+
+private:
+    VecArrayStorage<T, 2> _s;
+};
+
+///
+/// An array of 3D vectors stored as structure of arrays, with the x, y
+/// and z components in separate 64-byte aligned arrays. See Vec2Array.
+///
+
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec3Array
+{
+public:
+    /// Component type
+    typedef T BaseType;
+
+    /// The alignment of the component arrays, in bytes
+    static const size_t alignment = 64;
+
+    /// @{
+    /// @name Constructors and Assignment
+
+    /// An empty array
+    Vec3Array () IMATH_NOEXCEPT {}
+
+    /// An array of `n` zero vectors
+    explicit Vec3Array (size_t n) : _s (n) {}
+
+    /// A copy of the `n` vectors in `v`
+    Vec3Array (const Vec3<T>* v, size_t n) { assign (v, n); }
+
+    /// Replace the contents with a copy of the `n` vectors in `v`.
+    void assign (const Vec3<T>* v, size_t n)
+    {
+        resize (n);
+        T* xs = x ();
+        T* ys = y ();
+        T* zs = z ();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            xs[i] = v[i].x;
+            ys[i] = v[i].y;
+            zs[i] = v[i].z;
+        }
+    }
+
+    /// Copy the vectors to the `size()` elements of `v`.
+    void copyTo (Vec3<T>* v) const IMATH_NOEXCEPT
+    {
+        const T* xs = x ();
+        const T* ys = y ();
+        const T* zs = z ();
+
+        for (size_t i = 0; i < size (); ++i)
+            v[i] = Vec3<T> (xs[i], ys[i], zs[i]);
+    }
+
+    /// @}
+
+    /// @{
+    /// @name Size
+
+    /// The number of vectors
+    size_t size () const IMATH_NOEXCEPT { return _s.size (); }
+
+    /// Return true if the array is empty.
+    bool empty () const IMATH_NOEXCEPT { return _s.size () == 0; }
+
+    /// The number of vectors the array can hold without reallocating
+    size_t capacity () const IMATH_NOEXCEPT { return _s.capacity (); }
+
+    /// Change the number of vectors, keeping the first ones and
+    /// setting new ones to zero.
+    void resize (size_t n) { _s.resize (n); }
+
+    /// Exchange the contents with those of `a`.
+    void swap (Vec3Array& a) IMATH_NOEXCEPT { _s.swap (a._s); }
+
+    /// @}
+
+    /// @{
+    /// @name Element Access
+
+    /// The x components
+    T* x () IMATH_NOEXCEPT { return _s.component (0); }
+
+    /// The x components
+    const T* x () const IMATH_NOEXCEPT { return _s.component (0); }
+
+    /// The y components
+    T* y () IMATH_NOEXCEPT { return _s.component (1); }
+
+    /// The y components
+    const T* y () const IMATH_NOEXCEPT { return _s.component (1); }
+
+    /// The z components
+    T* z () IMATH_NOEXCEPT { return _s.component (2); }
+
+    /// The z components
+    const T* z () const IMATH_NOEXCEPT { return _s.component (2); }
+
+    /// The vector at index `i`
+    Vec3<T> operator[] (size_t i) const IMATH_NOEXCEPT
+    {
+        return Vec3<T> (x ()[i], y ()[i], z ()[i]);
+    }
+
+    /// Set the vector at index `i` to `v`.
+    void set (size_t i, const Vec3<T>& v) IMATH_NOEXCEPT
+    {
+        x ()[i] = v.x;
+        y ()[i] = v.y;
+        z ()[i] = v.z;
+    }
+
+    /// @}
+
+private:
+    VecArrayStorage<T, 3> _s;
+};
+
+///
+/// An array of 4D vectors stored as structure of arrays, with the x,
+/// y, z and w components in separate 64-byte aligned arrays. See
+/// Vec2Array.
+///
+
+template <class T> class IMATH_EXPORT_TEMPLATE_TYPE Vec4Array
+{
+public:
+    /// Component type
+    typedef T BaseType;
+
+    /// The alignment of the component arrays, in bytes
+    static const size_t alignment = 64;
+
+    /// @{
+    /// @name Constructors and Assignment
+
+    /// An empty array
+    Vec4Array () IMATH_NOEXCEPT {}
+
+    /// An array of `n` zero vectors
+    explicit Vec4Array (size_t n) : _s (n) {}
+
+    /// A copy of the `n` vectors in `v`
+    Vec4Array (const Vec4<T>* v, size_t n) { assign (v, n); }
+
+    /// Replace the contents with a copy of the `n` vectors in `v`.
+    void assign (const Vec4<T>* v, size_t n)
+    {
+        resize (n);
+        T* xs = x ();
+        T* ys = y ();
+        T* zs = z ();
+        T* ws = w ();
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            xs[i] = v[i].x;
+            ys[i] = v[i].y;
+            zs[i] = v[i].z;
+            ws[i] = v[i].w;
+        }
+    }
+
+    /// Copy the vectors to the `size()` elements of `v`.
+    void copyTo (Vec4<T>* v) const IMATH_NOEXCEPT
+    {
+        const T* xs = x ();
+        const T* ys = y ();
+        const T* zs = z ();
+        const T* ws = w ();
+
+        for (size_t i = 0; i < size (); ++i)
+            v[i] = Vec4<T> (xs[i], ys[i], zs[i], ws[i]);
+    }
+
+    /// @}
+
+    /// @{
+    /// @name Size
+
+    /// The number of vectors
+    size_t size () const IMATH_NOEXCEPT { return _s.size (); }
+
+    /// Return true if the array is empty.
+    bool empty () const IMATH_NOEXCEPT { return _s.size () == 0; }
+
+    /// The number of vectors the array can hold without reallocating
+    size_t capacity () const IMATH_NOEXCEPT { return _s.capacity (); }
+
+    /// Change the number of vectors, keeping the first ones and
+    /// setting new ones to zero.
+    void resize (size_t n) { _s.resize (n); }
+
+    /// Exchange the contents with those of `a`.
+    void swap (Vec4Array& a) IMATH_NOEXCEPT { _s.swap (a._s); }
+
+    /// @}
+
+    /// @{
+    /// @name Element Access
+
+    /// The x components
+    T* x () IMATH_NOEXCEPT { return _s.component (0); }
+
+    /// The x components
+    const T* x () const IMATH_NOEXCEPT { return _s.component (0); }
+
+    /// The y components
+    T* y () IMATH_NOEXCEPT { return _s.component (1); }
+
+    /// The y components
+    const T* y () const IMATH_NOEXCEPT { return _s.component (1); }
+
+    /// The z components
+    T* z () IMATH_NOEXCEPT { return _s.component (2); }
+
+    /// The z components
+    const T* z () const IMATH_NOEXCEPT { return _s.component (2); }
+
+    /// The w components
+    T* w () IMATH_NOEXCEPT { return _s.component (3); }
+
+    /// The w components
+    const T* w () const IMATH_NOEXCEPT { return _s.component (3); }
+
+    /// The vector at index `i`
+    Vec4<T> operator[] (size_t i) const IMATH_NOEXCEPT
+    {
+        return Vec4<T> (x ()[i], y ()[i], z ()[i], w ()[i]);
+    }
+
+    /// Set the vector at index `i` to `v`.
+    void set (size_t i, const Vec4<T>& v) IMATH_NOEXCEPT
+    {
+        x ()[i] = v.x;
+        y ()[i] = v.y;
+        z ()[i] = v.z;
+        w ()[i] = v.w;
+    }
+
+    /// @}
+
+private:
+    VecArrayStorage<T, 4> _s;
+};
+
+/// Vec2Array of float
+typedef Vec2Array<float> V2fArray;
+
+/// Vec2Array of double
+typedef Vec2Array<double> V2dArray;
+
+/// Vec3Array of float
+typedef Vec3Array<float> V3fArray;
+
+/// Vec3Array of double
+typedef Vec3Array<double> V3dArray;
+
+/// Vec4Array of float
+typedef Vec4Array<float> V4fArray;
+
+/// Vec4Array of double
+typedef Vec4Array<double> V4dArray;
+
+///
+/// @{
+/// @name Batch Operations
+///
+/// Each function applies the corresponding Vec2, Vec3 or Vec4
+/// operation to every element of its array arguments, which must all
+/// have the same size. A result array is resized to that size. A
+/// result may be the same array as an argument, but must not
+/// otherwise overlap one.
+///
+/// These are only available for float and double. They are compiled
+/// so that they vectorize, including the square roots, and agree with
+/// the operations on single vectors to within rounding.
+///
+
+/// Set `result[i]` to `a[i].dot (b[i])`.
+template <class T>
+void dot (const Vec2Array<T>& a, const Vec2Array<T>& b, T* result);
+
+/// Set `result[i]` to `a[i].dot (b[i])`.
+template <class T>
+void dot (const Vec3Array<T>& a, const Vec3Array<T>& b, T* result);
+
+/// Set `result[i]` to `a[i].dot (b[i])`.
+template <class T>
+void dot (const Vec4Array<T>& a, const Vec4Array<T>& b, T* result);
+
+/// Set `result[i]` to `a[i].cross (b[i])`.
+template <class T>
+void cross (const Vec3Array<T>& a, const Vec3Array<T>& b, Vec3Array<T>& result);
+
+/// Set `result[i]` to `a[i].length()`.
+template <class T>
+void length (const Vec2Array<T>& a, T* result);
+
+/// Set `result[i]` to `a[i].length()`.
+template <class T>
+void length (const Vec3Array<T>& a, T* result);
+
+/// Set `result[i]` to `a[i].length()`.
+template <class T>
+void length (const Vec4Array<T>& a, T* result);
+
+/// Normalize each vector in `a` as Vec2::normalize() does: null
+/// vectors are left unchanged.
+template <class T>
+void normalize (Vec2Array<T>& a);
+
+/// Normalize each vector in `a` as Vec3::normalize() does.
+template <class T>
+void normalize (Vec3Array<T>& a);
+
+/// Normalize each vector in `a` as Vec4::normalize() does.
+template <class T>
+void normalize (Vec4Array<T>& a);
+
+/// Set `result[i]` to `lerp (a[i], b[i], t)`, that is,
+/// `a[i] * (1 - t) + b[i] * t`.
+template <class T>
+void lerp (
+    const Vec2Array<T>& a, const Vec2Array<T>& b, T t, Vec2Array<T>& result);
+
+/// Set `result[i]` to `lerp (a[i], b[i], t)`.
+template <class T>
+void lerp (
+    const Vec3Array<T>& a, const Vec3Array<T>& b, T t, Vec3Array<T>& result);
+
+/// Set `result[i]` to `lerp (a[i], b[i], t)`.
+template <class T>
+void lerp (
+    const Vec4Array<T>& a, const Vec4Array<T>& b, T t, Vec4Array<T>& result);
+
+/// Transform the points in `src` by `m` as Matrix33::multVecMatrix()
+/// does, and store the results in `dst`.
+template <class T>
+void multVecMatrix (
+    const Matrix33<T>& m, const Vec2Array<T>& src, Vec2Array<T>& dst);
+
+/// Transform the directions in `src` by `m` as
+/// Matrix33::multDirMatrix() does, and store the results in `dst`.
+template <class T>
+void multDirMatrix (
+    const Matrix33<T>& m, const Vec2Array<T>& src, Vec2Array<T>& dst);
+
+/// Transform the points in `src` by `m` as Matrix44::multVecMatrix()
+/// does, and store the results in `dst`.
+template <class T>
+void multVecMatrix (
+    const Matrix44<T>& m, const Vec3Array<T>& src, Vec3Array<T>& dst);
+
+/// Transform the directions in `src` by `m` as
+/// Matrix44::multDirMatrix() does, and store the results in `dst`.
+template <class T>
+void multDirMatrix (
+    const Matrix44<T>& m, const Vec3Array<T>& src, Vec3Array<T>& dst);
+
+/// Set `dst[i]` to `src[i] * m`.
+template <class T>
+void multVecMatrix (
+    const Matrix44<T>& m, const Vec4Array<T>& src, Vec4Array<T>& dst);
+
+/// @}
+
+IMATH_INTERNAL_NAMESPACE_HEADER_EXIT
+
+#endif // INCLUDED_IMATHVECARRAY_H
@@ -18,6 +18,22 @@
 
 #include "half.h"
 #include <assert.h>
+#include <atomic>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) ||            \
+    defined(_M_IX86)
+#    if defined(__GNUC__) || defined(__clang__)
+#        include <cpuid.h>
+#        include <immintrin.h>
+#        define IMATH_HALF_X86_DISPATCH
+#        define IMATH_HALF_TARGET(t) __attribute__ ((target (t)))
+#    elif defined(_MSC_VER)
+#        include <immintrin.h>
+#        include <intrin.h>
+#        define IMATH_HALF_X86_DISPATCH
+#        define IMATH_HALF_TARGET(t)
+#    endif
+#endif
 
 using namespace std;
 
@@ -48,6 +64,716 @@ EXPORT_CONST const imath_half_uif_t *imath_half_to_float_table = imath_half_to_f
 
 // clang-format on
 
+//----------------------------------------------------------------
+// Bulk conversion
+//
+// The kernels below convert 8 or 16 values per instruction, and are
+// selected via cpuid when the library is loaded, independent of the
+// compiler flags the library was built with. The hardware
+// instructions quiet signalling NaNs, whereas the scalar conversion
+// preserves the NaN payload, so NaN lanes are either patched in
+// registers or the block that contains them is handed to the scalar
+// path. That keeps the result identical to the per-element conversion
+// for every input.
+//
+// The scalar path uses the arithmetic half-to-float conversion,
+// which vectorizes, rather than the lookup table, so streaming a
+// large buffer through it does not evict the caller's data.
+//----------------------------------------------------------------
+
+namespace
+{
+
+void
+halfToFloatArrayScalar (const imath_half_bits_t* src, float* dst, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = imath_half_to_float_no_table (src[i]);
+}
+
+void
+floatToHalfArrayScalar (const float* src, imath_half_bits_t* dst, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = imath_float_to_half (src[i]);
+}
+
+#ifdef IMATH_HALF_X86_DISPATCH
+
+enum
+{
+    CPU_F16C   = 0x1,
+    CPU_AVX2   = 0x2,
+    CPU_AVX512 = 0x4
+};
+
+int
+cpuFeatures ()
+{
+    unsigned int regs[4] = {0, 0, 0, 0}; // eax, ebx, ecx, edx
+    unsigned int maxLeaf;
+
+#    if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid (info, 0);
+    maxLeaf = (unsigned int) info[0];
+    __cpuid (info, 1);
+    for (int i = 0; i < 4; ++i)
+        regs[i] = (unsigned int) info[i];
+#    else
+    maxLeaf = __get_cpuid_max (0, 0);
+    if (maxLeaf < 1) return 0;
+    __cpuid (1, regs[0], regs[1], regs[2], regs[3]);
+#    endif
+
+    //
+    // F16C and AVX both need the operating system to save the ymm
+    // registers on a context switch, which it advertises via
+    // OSXSAVE and XCR0.
+    //
+
+    bool osxsave = (regs[2] & (1u << 27)) != 0;
+    bool avx     = (regs[2] & (1u << 28)) != 0;
+    bool f16c    = (regs[2] & (1u << 29)) != 0;
+
+    if (!osxsave || !avx) return 0;
+
+    unsigned long long xcr0;
+#    if defined(_MSC_VER) && !defined(__clang__)
+    xcr0 = _xgetbv (0);
+#    else
+    unsigned int xlo, xhi;
+    __asm__ __volatile__("xgetbv" : "=a"(xlo), "=d"(xhi) : "c"(0));
+    xcr0 = ((unsigned long long) xhi << 32) | xlo;
+#    endif
+
+    if ((xcr0 & 0x6) != 0x6) return 0;
+
+    int features = f16c ? CPU_F16C : 0;
+
+    if (maxLeaf >= 7)
+    {
+#    if defined(_MSC_VER) && !defined(__clang__)
+        __cpuidex (info, 7, 0);
+        for (int i = 0; i < 4; ++i)
+            regs[i] = (unsigned int) info[i];
+#    else
+        __cpuid_count (7, 0, regs[0], regs[1], regs[2], regs[3]);
+#    endif
+
+        bool avx2    = (regs[1] & (1u << 5)) != 0;
+        bool avx512f = (regs[1] & (1u << 16)) != 0;
+
+        if (f16c && avx2) features |= CPU_AVX2;
+
+        // opmask, upper zmm and hi16 zmm state
+        if (f16c && avx2 && avx512f && (xcr0 & 0xe6) == 0xe6)
+            features |= CPU_AVX512;
+    }
+
+    return features;
+}
+
+//
+// F16C: 8 values per iteration
+//
+
+IMATH_HALF_TARGET ("avx,f16c")
+void
+halfToFloatArrayF16C (const imath_half_bits_t* src, float* dst, size_t n)
+{
+    const __m128i absMask = _mm_set1_epi16 (0x7fff);
+    const __m128i infBits = _mm_set1_epi16 (0x7c00);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m128i h   = _mm_loadu_si128 ((const __m128i*) (src + i));
+        __m128i nan = _mm_cmpgt_epi16 (_mm_and_si128 (h, absMask), infBits);
+
+        if (IMATH_UNLIKELY (_mm_movemask_epi8 (nan) != 0))
+            halfToFloatArrayScalar (src + i, dst + i, 8);
+        else
+            _mm256_storeu_ps (dst + i, _mm256_cvtph_ps (h));
+    }
+
+    halfToFloatArrayScalar (src + i, dst + i, n - i);
+}
+
+IMATH_HALF_TARGET ("avx,f16c")
+void
+floatToHalfArrayF16C (const float* src, imath_half_bits_t* dst, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256 f   = _mm256_loadu_ps (src + i);
+        __m256 nan = _mm256_cmp_ps (f, f, _CMP_UNORD_Q);
+
+        if (IMATH_UNLIKELY (_mm256_movemask_ps (nan) != 0))
+            floatToHalfArrayScalar (src + i, dst + i, 8);
+        else
+            _mm_storeu_si128 (
+                (__m128i*) (dst + i),
+                _mm256_cvtps_ph (
+                    f, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+    }
+
+    floatToHalfArrayScalar (src + i, dst + i, n - i);
+}
+
+//
+// AVX2: 16 values per iteration. With 256-bit integer operations
+// available, NaN lanes are patched in registers instead of falling
+// back to the scalar path.
+//
+
+IMATH_HALF_TARGET ("avx2,f16c")
+inline __m256
+halfToFloat8AVX2 (__m128i h)
+{
+    __m256  f = _mm256_cvtph_ps (h);
+    __m256i w = _mm256_cvtepu16_epi32 (h);
+    __m256i nan = _mm256_cmpgt_epi32 (
+        _mm256_and_si256 (w, _mm256_set1_epi32 (0x7fff)),
+        _mm256_set1_epi32 (0x7c00));
+
+    if (IMATH_UNLIKELY (!_mm256_testz_si256 (nan, nan)))
+    {
+        // sign, all exponent bits, and the original significand
+        __m256i bits = _mm256_or_si256 (
+            _mm256_or_si256 (
+                _mm256_slli_epi32 (
+                    _mm256_and_si256 (w, _mm256_set1_epi32 (0x8000)), 16),
+                _mm256_slli_epi32 (
+                    _mm256_and_si256 (w, _mm256_set1_epi32 (0x03ff)), 13)),
+            _mm256_set1_epi32 (0x7f800000));
+
+        f = _mm256_blendv_ps (
+            f, _mm256_castsi256_ps (bits), _mm256_castsi256_ps (nan));
+    }
+
+    return f;
+}
+
+IMATH_HALF_TARGET ("avx2,f16c")
+void
+halfToFloatArrayAVX2 (const imath_half_bits_t* src, float* dst, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m128i h0 = _mm_loadu_si128 ((const __m128i*) (src + i));
+        __m128i h1 = _mm_loadu_si128 ((const __m128i*) (src + i + 8));
+        _mm256_storeu_ps (dst + i, halfToFloat8AVX2 (h0));
+        _mm256_storeu_ps (dst + i + 8, halfToFloat8AVX2 (h1));
+    }
+
+    if (i + 8 <= n)
+    {
+        __m128i h = _mm_loadu_si128 ((const __m128i*) (src + i));
+        _mm256_storeu_ps (dst + i, halfToFloat8AVX2 (h));
+        i += 8;
+    }
+
+    halfToFloatArrayScalar (src + i, dst + i, n - i);
+}
+
+IMATH_HALF_TARGET ("avx2,f16c")
+void
+floatToHalfArrayAVX2 (const float* src, imath_half_bits_t* dst, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256 f0  = _mm256_loadu_ps (src + i);
+        __m256 f1  = _mm256_loadu_ps (src + i + 8);
+        __m256 nan = _mm256_or_ps (
+            _mm256_cmp_ps (f0, f0, _CMP_UNORD_Q),
+            _mm256_cmp_ps (f1, f1, _CMP_UNORD_Q));
+
+        if (IMATH_UNLIKELY (_mm256_movemask_ps (nan) != 0))
+        {
+            floatToHalfArrayF16C (src + i, dst + i, 16);
+        }
+        else
+        {
+            _mm_storeu_si128 (
+                (__m128i*) (dst + i),
+                _mm256_cvtps_ph (
+                    f0, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+            _mm_storeu_si128 (
+                (__m128i*) (dst + i + 8),
+                _mm256_cvtps_ph (
+                    f1, (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+        }
+    }
+
+    floatToHalfArrayF16C (src + i, dst + i, n - i);
+}
+
+//
+// AVX-512: 16 values per instruction
+//
+
+IMATH_HALF_TARGET ("avx512f,avx2,f16c")
+void
+halfToFloatArrayAVX512 (const imath_half_bits_t* src, float* dst, size_t n)
+{
+    const __m512i absMask  = _mm512_set1_epi32 (0x7fff);
+    const __m512i infBits  = _mm512_set1_epi32 (0x7c00);
+    const __m512i signMask = _mm512_set1_epi32 (0x8000);
+    const __m512i mantMask = _mm512_set1_epi32 (0x03ff);
+    const __m512i expBits  = _mm512_set1_epi32 (0x7f800000);
+
+    //
+    // The unmasked forms of these intrinsics start from an undefined
+    // register, which GCC reports as maybe uninitialized; the
+    // zero-masked forms with all lanes selected are the same
+    // instructions.
+    //
+
+    const __mmask16 all = 0xffff;
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m256i   h   = _mm256_loadu_si256 ((const __m256i*) (src + i));
+        __m512    f   = _mm512_maskz_cvtph_ps (all, h);
+        __m512i   w   = _mm512_maskz_cvtepu16_epi32 (all, h);
+        __mmask16 nan = _mm512_cmpgt_epi32_mask (
+            _mm512_and_si512 (w, absMask), infBits);
+
+        if (IMATH_UNLIKELY (nan != 0))
+        {
+            __m512i bits = _mm512_or_si512 (
+                _mm512_or_si512 (
+                    _mm512_maskz_slli_epi32 (
+                        all, _mm512_and_si512 (w, signMask), 16),
+                    _mm512_maskz_slli_epi32 (
+                        all, _mm512_and_si512 (w, mantMask), 13)),
+                expBits);
+
+            f = _mm512_mask_mov_ps (f, nan, _mm512_castsi512_ps (bits));
+        }
+
+        _mm512_storeu_ps (dst + i, f);
+    }
+
+    halfToFloatArrayAVX2 (src + i, dst + i, n - i);
+}
+
+IMATH_HALF_TARGET ("avx512f,avx2,f16c")
+void
+floatToHalfArrayAVX512 (const float* src, imath_half_bits_t* dst, size_t n)
+{
+    const __mmask16 all = 0xffff;
+
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16)
+    {
+        __m512 f = _mm512_loadu_ps (src + i);
+
+        if (IMATH_UNLIKELY (_mm512_cmp_ps_mask (f, f, _CMP_UNORD_Q) != 0))
+            floatToHalfArrayF16C (src + i, dst + i, 16);
+        else
+            _mm256_storeu_si256 (
+                (__m256i*) (dst + i),
+                _mm512_maskz_cvtps_ph (
+                    all,
+                    f,
+                    (_MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC)));
+    }
+
+    floatToHalfArrayF16C (src + i, dst + i, n - i);
+}
+
+#endif // IMATH_HALF_X86_DISPATCH
+
+//----------------------------------------------------------------
+// Table lookup
+//
+// The array evaluations of halfFunction<float> and halfCurve<float>
+// gather 8 floats per instruction with AVX2. They follow the bulk
+// conversion, and use the AVX2 kernels whenever it uses the AVX2 or
+// AVX-512 kernels.
+//----------------------------------------------------------------
+
+void
+lookupFloatArrayScalar (
+    const float* table, const imath_half_bits_t* src, float* dst, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = table[src[i]];
+}
+
+//
+// The value of a halfCurve<float> at h, as halfCurve::operator()
+// computes it: the cubic of piece h >> 7, or its entry in the table
+// if tableIndex is not negative.
+//
+
+inline float
+curveFloat (
+    const float*      coeffs,
+    const int*        tableIndex,
+    const float*      table,
+    imath_half_bits_t h)
+{
+    int p = h >> 7;
+
+    if (tableIndex[p] >= 0) return table[tableIndex[p] + (h & 127)];
+
+    const float* c = coeffs + 4 * p;
+    float        u = (h & 127) * (1 / 64.0f) - 1;
+
+    return ((c[3] * u + c[2]) * u + c[1]) * u + c[0];
+}
+
+void
+curveFloatArrayScalar (
+    const float*             coeffs,
+    const int*               tableIndex,
+    const float*             table,
+    const imath_half_bits_t* src,
+    float*                   dst,
+    size_t                   n)
+{
+    for (size_t i = 0; i < n; ++i)
+        dst[i] = curveFloat (coeffs, tableIndex, table, src[i]);
+}
+
+#ifdef IMATH_HALF_X86_DISPATCH
+
+IMATH_HALF_TARGET ("avx2")
+void
+lookupFloatArrayAVX2 (
+    const float* table, const imath_half_bits_t* src, float* dst, size_t n)
+{
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i index = _mm256_cvtepu16_epi32 (
+            _mm_loadu_si128 ((const __m128i*) (src + i)));
+
+        _mm256_storeu_ps (dst + i, _mm256_i32gather_ps (table, index, 4));
+    }
+
+    lookupFloatArrayScalar (table, src + i, dst + i, n - i);
+}
+
+//
+// Evaluate eight cubics at a time, gathering their coefficients, and
+// then look up the values in table pieces.
+//
+
+IMATH_HALF_TARGET ("avx2")
+void
+curveFloatArrayAVX2 (
+    const float*             coeffs,
+    const int*               tableIndex,
+    const float*             table,
+    const imath_half_bits_t* src,
+    float*                   dst,
+    size_t                   n)
+{
+    const __m256i low   = _mm256_set1_epi32 (127);
+    const __m256  scale = _mm256_set1_ps (1 / 64.0f);
+    const __m256  one   = _mm256_set1_ps (1);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8)
+    {
+        __m256i b = _mm256_cvtepu16_epi32 (
+            _mm_loadu_si128 ((const __m128i*) (src + i)));
+        __m256i p = _mm256_srli_epi32 (b, 7);
+        __m256i k = _mm256_slli_epi32 (p, 2);
+        __m256  m = _mm256_cvtepi32_ps (_mm256_and_si256 (b, low));
+        __m256  u = _mm256_sub_ps (_mm256_mul_ps (m, scale), one);
+
+        __m256 r = _mm256_i32gather_ps (coeffs + 3, k, 4);
+        r        = _mm256_add_ps (
+            _mm256_mul_ps (r, u), _mm256_i32gather_ps (coeffs + 2, k, 4));
+        r = _mm256_add_ps (
+            _mm256_mul_ps (r, u), _mm256_i32gather_ps (coeffs + 1, k, 4));
+        r = _mm256_add_ps (
+            _mm256_mul_ps (r, u), _mm256_i32gather_ps (coeffs, k, 4));
+
+        _mm256_storeu_ps (dst + i, r);
+
+        //
+        // The sign bits of the table indices mark polynomial pieces.
+        //
+
+        int polynomials = _mm256_movemask_ps (_mm256_castsi256_ps (
+            _mm256_i32gather_epi32 (tableIndex, p, 4)));
+
+        if (polynomials != 0xFF)
+        {
+            for (int j = 0; j < 8; ++j)
+                if (!(polynomials & (1 << j)))
+                    dst[i + j] =
+                        curveFloat (coeffs, tableIndex, table, src[i + j]);
+        }
+    }
+
+    curveFloatArrayScalar (coeffs, tableIndex, table, src + i, dst + i, n - i);
+}
+
+#endif // IMATH_HALF_X86_DISPATCH
+
+typedef void (*HalfToFloatArrayFunc) (const imath_half_bits_t*, float*, size_t);
+typedef void (*FloatToHalfArrayFunc) (const float*, imath_half_bits_t*, size_t);
+
+typedef void (*LookupFloatArrayFunc) (
+    const float*, const imath_half_bits_t*, float*, size_t);
+typedef void (*CurveFloatArrayFunc) (
+    const float*,
+    const int*,
+    const float*,
+    const imath_half_bits_t*,
+    float*,
+    size_t);
+
+//
+// Return true and set toFloat and toHalf to the kernels that
+// implement impl, or return false if the host processor (or the
+// compiler the library was built with) does not support impl.
+//
+
+bool
+convertersFor (
+    imath_half_conversion_impl_t impl,
+    HalfToFloatArrayFunc&        toFloat,
+    FloatToHalfArrayFunc&        toHalf)
+{
+#ifdef IMATH_HALF_X86_DISPATCH
+    static const int features = cpuFeatures ();
+#endif
+
+    switch (impl)
+    {
+        case IMATH_HALF_CONVERSION_SCALAR:
+            toFloat = halfToFloatArrayScalar;
+            toHalf  = floatToHalfArrayScalar;
+            return true;
+
+#ifdef IMATH_HALF_X86_DISPATCH
+        case IMATH_HALF_CONVERSION_F16C:
+            if (!(features & CPU_F16C)) return false;
+            toFloat = halfToFloatArrayF16C;
+            toHalf  = floatToHalfArrayF16C;
+            return true;
+
+        case IMATH_HALF_CONVERSION_AVX2:
+            if (!(features & CPU_AVX2)) return false;
+            toFloat = halfToFloatArrayAVX2;
+            toHalf  = floatToHalfArrayAVX2;
+            return true;
+
+        case IMATH_HALF_CONVERSION_AVX512:
+            if (!(features & CPU_AVX512)) return false;
+            toFloat = halfToFloatArrayAVX512;
+            toHalf  = floatToHalfArrayAVX512;
+            return true;
+#endif
+
+        default: return false;
+    }
+}
+
+//
+// Set lookup and curve to the table lookup kernels that go with the
+// bulk conversion impl, which the host is known to support.
+//
+
+void
+lookupsFor (
+    imath_half_conversion_impl_t impl,
+    LookupFloatArrayFunc&        lookup,
+    CurveFloatArrayFunc&         curve)
+{
+    lookup = lookupFloatArrayScalar;
+    curve  = curveFloatArrayScalar;
+
+#ifdef IMATH_HALF_X86_DISPATCH
+    if (impl == IMATH_HALF_CONVERSION_AVX2 ||
+        impl == IMATH_HALF_CONVERSION_AVX512)
+    {
+        lookup = lookupFloatArrayAVX2;
+        curve  = curveFloatArrayAVX2;
+    }
+#else
+    (void) impl;
+#endif
+}
+
+//
+// The active kernels. These start out pointing at resolver functions,
+// which are constant-initialized, so a conversion requested before the
+// library's static initializers have run still selects the best
+// implementation on its first call.
+//
+
+void halfToFloatArrayResolve (const imath_half_bits_t*, float*, size_t);
+void floatToHalfArrayResolve (const float*, imath_half_bits_t*, size_t);
+void lookupFloatArrayResolve (
+    const float*, const imath_half_bits_t*, float*, size_t);
+void curveFloatArrayResolve (
+    const float*,
+    const int*,
+    const float*,
+    const imath_half_bits_t*,
+    float*,
+    size_t);
+
+std::atomic<HalfToFloatArrayFunc> activeToFloat (halfToFloatArrayResolve);
+std::atomic<FloatToHalfArrayFunc> activeToHalf (floatToHalfArrayResolve);
+std::atomic<LookupFloatArrayFunc> activeLookup (lookupFloatArrayResolve);
+std::atomic<CurveFloatArrayFunc>  activeCurve (curveFloatArrayResolve);
+std::atomic<int> activeImpl (IMATH_HALF_CONVERSION_SCALAR);
+
+bool
+install (imath_half_conversion_impl_t impl)
+{
+    HalfToFloatArrayFunc toFloat;
+    FloatToHalfArrayFunc toHalf;
+
+    if (!convertersFor (impl, toFloat, toHalf)) return false;
+
+    LookupFloatArrayFunc lookup;
+    CurveFloatArrayFunc  curve;
+    lookupsFor (impl, lookup, curve);
+
+    activeToFloat.store (toFloat, std::memory_order_relaxed);
+    activeToHalf.store (toHalf, std::memory_order_relaxed);
+    activeLookup.store (lookup, std::memory_order_relaxed);
+    activeCurve.store (curve, std::memory_order_relaxed);
+    activeImpl.store (impl, std::memory_order_relaxed);
+    return true;
+}
+
+void
+installBest ()
+{
+    static const imath_half_conversion_impl_t order[] = {
+        IMATH_HALF_CONVERSION_AVX512,
+        IMATH_HALF_CONVERSION_AVX2,
+        IMATH_HALF_CONVERSION_F16C,
+        IMATH_HALF_CONVERSION_SCALAR};
+
+    for (imath_half_conversion_impl_t impl: order)
+        if (install (impl)) return;
+}
+
+void
+halfToFloatArrayResolve (const imath_half_bits_t* src, float* dst, size_t n)
+{
+    installBest ();
+    activeToFloat.load (std::memory_order_relaxed) (src, dst, n);
+}
+
+void
+floatToHalfArrayResolve (const float* src, imath_half_bits_t* dst, size_t n)
+{
+    installBest ();
+    activeToHalf.load (std::memory_order_relaxed) (src, dst, n);
+}
+
+void
+lookupFloatArrayResolve (
+    const float* table, const imath_half_bits_t* src, float* dst, size_t n)
+{
+    installBest ();
+    activeLookup.load (std::memory_order_relaxed) (table, src, dst, n);
+}
+
+void
+curveFloatArrayResolve (
+    const float*             coeffs,
+    const int*               tableIndex,
+    const float*             table,
+    const imath_half_bits_t* src,
+    float*                   dst,
+    size_t                   n)
+{
+    installBest ();
+    activeCurve.load (std::memory_order_relaxed) (
+        coeffs, tableIndex, table, src, dst, n);
+}
+
+//
+// Select the implementation once, when the library is loaded.
+//
+
+struct LoadTimeSelection
+{
+    LoadTimeSelection ()
+    {
+        if (activeToFloat.load () == halfToFloatArrayResolve) installBest ();
+    }
+} loadTimeSelection;
+
+} // namespace
+
+extern "C" {
+
+IMATH_EXPORT void
+imath_half_to_float_array (const imath_half_bits_t* src, float* dst, size_t n)
+{
+    activeToFloat.load (std::memory_order_relaxed) (src, dst, n);
+}
+
+IMATH_EXPORT void
+imath_float_to_half_array (const float* src, imath_half_bits_t* dst, size_t n)
+{
+    activeToHalf.load (std::memory_order_relaxed) (src, dst, n);
+}
+
+IMATH_EXPORT imath_half_conversion_impl_t
+imath_half_conversion_impl (void)
+{
+    if (activeToFloat.load () == halfToFloatArrayResolve) installBest ();
+    return static_cast<imath_half_conversion_impl_t> (activeImpl.load ());
+}
+
+IMATH_EXPORT int
+imath_half_set_conversion_impl (imath_half_conversion_impl_t impl)
+{
+    return install (impl) ? 1 : 0;
+}
+
+} // extern "C"
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_ENTER
+
+IMATH_EXPORT void
+halfFunctionLookup (const float* table, const half* in, float* out, size_t n)
+{
+    activeLookup.load (std::memory_order_relaxed) (
+        table, reinterpret_cast<const imath_half_bits_t*> (in), out, n);
+}
+
+IMATH_EXPORT void
+halfCurveEvaluate (
+    const float* coeffs,
+    const int*   tableIndex,
+    const float* table,
+    const half*  in,
+    float*       out,
+    size_t       n)
+{
+    activeCurve.load (std::memory_order_relaxed) (
+        coeffs,
+        tableIndex,
+        table,
+        reinterpret_cast<const imath_half_bits_t*> (in),
+        out,
+        n);
+}
+
+IMATH_INTERNAL_NAMESPACE_SOURCE_EXIT
+
 //---------------------
 // Stream I/O operators
 //---------------------
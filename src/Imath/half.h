@@ -185,6 +185,7 @@
 #    include <immintrin.h>
 #endif
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdio.h>
 
@@ -283,11 +284,17 @@ static inline float
 imath_half_to_float (imath_half_bits_t h)
 {
 #if defined(__F16C__)
-    // NB: The intel implementation does seem to treat NaN slightly
-    // different than the original toFloat table does (i.e. where the
-    // 1 bits are, meaning the signalling or not bits). This seems
-    // benign, given that the original library didn't really deal with
-    // signalling vs non-signalling NaNs
+    // NB: The intel implementation quiets signalling NaNs, whereas the
+    // lookup table, the arithmetic conversion and the bulk conversion
+    // functions keep the NaN payload as it is. Convert NaNs here the
+    // same way, so that the result does not depend on the build flags.
+    if (IMATH_UNLIKELY ((h & 0x7fff) > 0x7c00))
+    {
+        imath_half_uif_t v;
+        v.i = ((uint32_t) (h >> 15) << 31) | 0x7f800000 |
+              ((uint32_t) (h & 0x03ff) << 13);
+        return v.f;
+    }
 #    ifdef _MSC_VER
     /* msvc does not seem to have cvtsh_ss :( */
     return _mm_cvtss_f32 (_mm_cvtph_ps (_mm_set1_epi16 (h)));
@@ -355,6 +362,42 @@ imath_half_to_float (imath_half_bits_t h)
 #endif
 }
 
+///
+/// Convert half to float without the lookup table
+///
+/// This is a branch-free arithmetic conversion that never touches
+/// ``imath_half_to_float_table``, so it leaves the cache to the
+/// caller's working set, and loops over it vectorize well. The
+/// result is identical to the lookup table, including NaN payloads.
+///
+
+static inline float
+imath_half_to_float_no_table (imath_half_bits_t h)
+{
+    imath_half_uif_t v, d, magic;
+
+    // The selects below are done with masks rather than conditionals,
+    // which lets compilers vectorize loops over this function.
+
+    uint32_t em     = (uint32_t) (h & 0x7fff) << 13;
+    uint32_t exp    = em & 0x0f800000;
+    uint32_t infnan = 0u - (uint32_t) (exp == 0x0f800000);
+    uint32_t denorm = 0u - (uint32_t) (exp == 0);
+
+    // rebias the exponent; infinity and nan get all exponent bits set
+    v.i = em + 0x38000000 + (infnan & 0x38000000);
+
+    // zero or denormal: renormalize by subtracting 2^-14, which the
+    // float represents exactly since its exponent range is wider
+    magic.i = 113 << 23;
+    d.i     = v.i + 0x00800000;
+    d.f -= magic.f;
+    v.i = (d.i & denorm) | (v.i & ~denorm);
+
+    v.i |= (uint32_t) (h & 0x8000) << 16;
+    return v.f;
+}
+
 ///
 /// Convert half to float
 ///
@@ -434,6 +477,60 @@ imath_float_to_half (float f)
 #endif
 }
 
+///
+/// @{
+/// @name Bulk conversion
+///
+/// Convert ``n`` values from ``src`` to ``dst``. These are
+/// implemented in the compiled library, which selects F16C, AVX2 or
+/// AVX-512 kernels once, when the library is loaded, if the host
+/// processor supports them, and falls back to the scalar conversion
+/// otherwise. A library built for baseline x86-64 therefore still
+/// uses the hardware conversion instructions where available.
+///
+/// None of the implementations uses the lookup table. The result is
+/// identical, bit for bit, to the lookup table conversion and to
+/// ``imath_float_to_half()`` on each element; in particular, NaN
+/// payloads are preserved rather than quieted by the hardware.
+///
+/// ``src`` and ``dst`` must not overlap. No alignment is required.
+
+/// The implementations of the bulk conversion
+typedef enum imath_half_conversion_impl_e
+{
+    IMATH_HALF_CONVERSION_SCALAR = 0, ///< per-element conversion
+    IMATH_HALF_CONVERSION_F16C   = 1, ///< F16C, 8 values at a time
+    IMATH_HALF_CONVERSION_AVX2   = 2, ///< F16C with AVX2, 16 at a time
+    IMATH_HALF_CONVERSION_AVX512 = 3  ///< AVX-512, 16 values at a time
+} imath_half_conversion_impl_t;
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+/// Return the implementation used by the bulk conversion functions
+IMATH_EXPORT imath_half_conversion_impl_t imath_half_conversion_impl (void);
+
+/// Override the implementation selected at load time, e.g. for
+/// testing or benchmarking. Return 1 on success, or 0, leaving the
+/// current selection unchanged, if the host does not support ``impl``.
+IMATH_EXPORT int
+imath_half_set_conversion_impl (imath_half_conversion_impl_t impl);
+
+/// Convert an array of half to float
+IMATH_EXPORT void imath_half_to_float_array (
+    const imath_half_bits_t* src, float* dst, size_t n);
+
+/// Convert an array of float to half
+IMATH_EXPORT void imath_float_to_half_array (
+    const float* src, imath_half_bits_t* dst, size_t n);
+
+#if defined(__cplusplus)
+} // extern "C"
+#endif
+
+/// @}
+
 ////////////////////////////////////////
 
 #ifdef __cplusplus
@@ -523,6 +620,13 @@ public:
     /// Conversion to float
     operator float () const IMATH_NOEXCEPT;
 
+    /// Conversion to float that does not use the lookup table,
+    /// regardless of ``IMATH_HALF_USE_LOOKUP_TABLE``. Use this where
+    /// conversions are interleaved with other work, so the 256 KB
+    /// table does not evict that work's data from the cache. Uses
+    /// the F16C instruction when compiled with F16C enabled.
+    float toFloatNoTable () const IMATH_NOEXCEPT;
+
     /// @{
     /// @name Basic Algebra
 
@@ -661,6 +765,16 @@ inline half::operator float () const IMATH_NOEXCEPT
     return imath_half_to_float (_h);
 }
 
+inline float
+half::toFloatNoTable () const IMATH_NOEXCEPT
+{
+#    if defined(__F16C__)
+    return imath_half_to_float (_h);
+#    else
+    return imath_half_to_float_no_table (_h);
+#    endif
+}
+
 //-------------------------
 // Round to n-bit precision
 //-------------------------
@@ -880,6 +994,37 @@ half::setBits (uint16_t bits) IMATH_NOEXCEPT
     _h = bits;
 }
 
+/// @cond Doxygen_Suppress
+
+//
+// The array evaluation of halfFunction<float>: out[i] is
+// table[in[i].bits()]. It is compiled into the library, which uses
+// AVX2 gathers when the processor has them. Not part of the public
+// interface.
+//
+
+IMATH_EXPORT void
+halfFunctionLookup (const float* table, const half* in, float* out, size_t n);
+
+//
+// The array evaluation of halfCurve<float>. Piece p holds the values
+// whose upper 9 bits are p. If tableIndex[p] is not negative, the
+// value of a half with lower 7 bits m is table[tableIndex[p] + m];
+// otherwise it is the cubic with coefficients coeffs[4p] to
+// coeffs[4p+3], in increasing order, evaluated at m / 64 - 1. Not
+// part of the public interface.
+//
+
+IMATH_EXPORT void halfCurveEvaluate (
+    const float* coeffs,
+    const int*   tableIndex,
+    const float* table,
+    const half*  in,
+    float*       out,
+    size_t       n);
+
+/// @endcond
+
 IMATH_INTERNAL_NAMESPACE_HEADER_EXIT
 
 /// Output h to os, formatted as a float
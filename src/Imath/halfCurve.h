@@ -0,0 +1,366 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+//---------------------------------------------------------------------------
+//
+//	halfCurve<T> -- a compact alternative to halfFunction<T>
+//
+//	A halfFunction stores a table of 64K entries of T, 256 KB for
+//	float, which does not stay in the cache when a program chains
+//	many of them.  A halfCurve approximates the function by a cubic
+//	polynomial over each eighth of the interval between consecutive
+//	powers of two, 512 pieces in all, which take about 10 KB.
+//
+//	The constructor takes the same arguments as the halfFunction
+//	constructor, plus a tolerance:
+//
+//	    halfCurve (function,
+//		       domainMin, domainMax,
+//		       defaultValue,
+//		       posInfValue, negInfValue,
+//		       nanValue,
+//		       tolerance);
+//
+//	It fits the polynomial for each piece to the 128 half values in
+//	the piece, and evaluates the fit at each of them.  If the relative
+//	error of any of them is greater than tolerance, or if the piece
+//	contains infinities or NANs other than as a constant value, the
+//	piece stores the 128 values instead, like a halfFunction.  This
+//	happens at zeros of the function and at the ends of its domain,
+//	so most curves need only a few such pieces.  maxError() returns
+//	the largest relative error of the polynomial pieces, which is at
+//	most tolerance.
+//
+//	The library evaluates arrays of float with its own kernels, which
+//	may round the polynomials differently from operator(), by a few
+//	ulp of the largest of their terms.  The error of each value
+//	includes an allowance for this, so that maxError() bounds both.
+//
+//	The polynomials are evaluated in float, so a tolerance much below
+//	1e-6 stores most pieces as tables.  For halfCurve<half>, the
+//	result is then rounded to half.
+//
+//	Example:
+//
+//	    #include <math.h>
+//	    #include <halfCurve.h>
+//
+//	    float srgb (float x) { return powf (x, 1 / 2.4f); }
+//
+//	    halfCurve<half> hsrgb (srgb, 0, 1);
+//
+//	    half x = hsrgb (0.5);
+//
+//	    hsrgb (in, out, n);	// evaluate an array
+//
+//---------------------------------------------------------------------------
+
+#ifndef _HALF_CURVE_H_
+#define _HALF_CURVE_H_
+
+/// @cond Doxygen_Suppress
+
+#include "half.h"
+
+#include <cmath>
+#include <limits>
+#include <stddef.h>
+#include <vector>
+
+template <class T> class halfCurve
+{
+public:
+    //------------
+    // Constructor
+    //------------
+
+    template <class Function>
+    halfCurve (
+        Function f,
+        half     domainMin    = -HALF_MAX,
+        half     domainMax    = HALF_MAX,
+        T        defaultValue = 0,
+        T        posInfValue  = 0,
+        T        negInfValue  = 0,
+        T        nanValue     = 0,
+        double   tolerance    = 1e-5);
+
+    //-----------
+    // Evaluation
+    //-----------
+
+    T operator() (half x) const;
+
+    void operator() (const half* in, T* out, size_t n) const;
+
+    //-----------
+    // Properties
+    //-----------
+
+    double maxError () const { return _maxError; }
+    int    numTablePieces () const { return int (_table.size () >> 7); }
+
+private:
+    static const int _numPieces = 1 << 9;
+
+    //
+    // The coefficients of piece i, in increasing order, are
+    // _coeffs[4 * i] to _coeffs[4 * i + 3], in u = m / 64 - 1, where m
+    // is the value of the low 7 bits of the half.  If _tableIndex[i]
+    // is not negative, the piece is stored as 128 values starting at
+    // _table[_tableIndex[i]] instead.
+    //
+
+    float          _coeffs[4 * _numPieces];
+    int            _tableIndex[_numPieces];
+    std::vector<T> _table;
+    double         _maxError;
+
+    static float evaluate (const float* c, float u)
+    {
+        return ((c[3] * u + c[2]) * u + c[1]) * u + c[0];
+    }
+
+    static double relativeError (float p, double v);
+
+    static double roundingError (const float* c, float u, double v);
+
+    static bool fit (const double* v, float* c);
+};
+
+//---------------
+// Implementation
+//---------------
+
+template <class T>
+template <class Function>
+halfCurve<T>::halfCurve (
+    Function f,
+    half     domainMin,
+    half     domainMax,
+    T        defaultValue,
+    T        posInfValue,
+    T        negInfValue,
+    T        nanValue,
+    double   tolerance)
+    : _maxError (0)
+{
+    for (int i = 0; i < _numPieces; i++)
+    {
+        T      value[128];
+        double v[128];
+        bool   constant = true;
+        bool   finite   = true;
+
+        for (int j = 0; j < 128; j++)
+        {
+            half x;
+            x.setBits ((i << 7) | j);
+
+            if (x.isNan ())
+                v[j] = double (value[j] = nanValue);
+            else if (x.isInfinity ())
+                v[j] = double (value[j] = x.isNegative () ? negInfValue
+                                                          : posInfValue);
+            else if (x < domainMin || x > domainMax)
+                v[j] = double (value[j] = defaultValue);
+            else
+            {
+                v[j]     = double (f (x));
+                value[j] = T (v[j]);
+            }
+
+            bool nans = std::isnan (v[j]) && std::isnan (v[0]);
+
+            constant = constant && (v[j] == v[0] || nans);
+            finite   = finite && std::isfinite (v[j]);
+        }
+
+        float* c = _coeffs + 4 * i;
+
+        if (constant)
+        {
+            //
+            // A constant piece, which may be infinite or a NAN, is
+            // stored as a polynomial if the value is a float.
+            //
+
+            c[0] = float (v[0]);
+            c[1] = c[2] = c[3] = 0;
+
+            if (double (c[0]) == v[0] || std::isnan (v[0]))
+            {
+                _tableIndex[i] = -1;
+                continue;
+            }
+        }
+
+        double error = tolerance + 1;
+
+        if (finite && fit (v, c))
+        {
+            error = 0;
+
+            for (int j = 0; j < 128; j++)
+            {
+                float  u = j / 64.0f - 1;
+                double e = relativeError (evaluate (c, u), v[j]) +
+                           roundingError (c, u, v[j]);
+                error = e > error ? e : error;
+            }
+        }
+
+        if (finite && error <= tolerance)
+        {
+            _tableIndex[i] = -1;
+            _maxError      = error > _maxError ? error : _maxError;
+        }
+        else
+        {
+            //
+            // The coefficients of a table piece are zero, since the
+            // array kernels evaluate them before they look at
+            // _tableIndex.
+            //
+
+            c[0] = c[1] = c[2] = c[3] = 0;
+
+            _tableIndex[i] = int (_table.size ());
+            _table.insert (_table.end (), value, value + 128);
+        }
+    }
+}
+
+template <class T>
+double
+halfCurve<T>::relativeError (float p, double v)
+{
+    if (double (p) == v) return 0;
+
+    return std::fabs (p - v) / std::fabs (v);
+}
+
+//
+// A bound of the difference, relative to v, between two evaluations of
+// the cubic c at u, with and without fused multiply-adds.  Each is
+// within 3 float epsilons of the sum of the magnitudes of the terms.
+//
+
+template <class T>
+double
+halfCurve<T>::roundingError (const float* c, float u, double v)
+{
+    double a = std::fabs (u);
+    double s = std::fabs (c[3]);
+
+    for (int k = 2; k >= 0; k--)
+        s = s * a + std::fabs (c[k]);
+
+    if (s == 0) return 0;
+
+    return 6 * std::numeric_limits<float>::epsilon () * s / std::fabs (v);
+}
+
+//
+// Fit a cubic to the 128 values of a piece, minimizing the sum of the
+// squares of the relative errors, by solving the normal equations.
+// Return false if they are singular.
+//
+
+template <class T>
+bool
+halfCurve<T>::fit (const double* v, float* c)
+{
+    double a[4][5] = {};
+
+    for (int j = 0; j < 128; j++)
+    {
+        double u    = j / 64.0 - 1;
+        double w    = v[j] != 0 ? 1 / (v[j] * v[j]) : 1;
+        double p[4] = {1, u, u * u, u * u * u};
+
+        for (int r = 0; r < 4; r++)
+        {
+            for (int s = 0; s < 4; s++)
+                a[r][s] += w * p[r] * p[s];
+
+            a[r][4] += w * p[r] * v[j];
+        }
+    }
+
+    for (int k = 0; k < 4; k++)
+    {
+        int pivot = k;
+
+        for (int r = k + 1; r < 4; r++)
+            if (std::fabs (a[r][k]) > std::fabs (a[pivot][k])) pivot = r;
+
+        if (a[pivot][k] == 0) return false;
+
+        for (int s = 0; s < 5; s++)
+        {
+            double t    = a[k][s];
+            a[k][s]     = a[pivot][s];
+            a[pivot][s] = t;
+        }
+
+        for (int r = k + 1; r < 4; r++)
+        {
+            double m = a[r][k] / a[k][k];
+
+            for (int s = k; s < 5; s++)
+                a[r][s] -= m * a[k][s];
+        }
+    }
+
+    for (int k = 3; k >= 0; k--)
+    {
+        double x = a[k][4];
+
+        for (int s = k + 1; s < 4; s++)
+            x -= a[k][s] * c[s];
+
+        c[k] = float (x / a[k][k]);
+    }
+
+    return true;
+}
+
+template <class T>
+inline T
+halfCurve<T>::operator() (half x) const
+{
+    int b = x.bits ();
+    int i = b >> 7;
+
+    if (_tableIndex[i] >= 0) return _table[_tableIndex[i] + (b & 127)];
+
+    return T (evaluate (_coeffs + 4 * i, (b & 127) * (1 / 64.0f) - 1));
+}
+
+template <class T>
+inline void
+halfCurve<T>::operator() (const half* in, T* out, size_t n) const
+{
+    for (size_t i = 0; i < n; i++)
+        out[i] = (*this) (in[i]);
+}
+
+//
+// For float, the library evaluates eight polynomials at a time with
+// AVX2 if the processor supports it.
+//
+
+template <>
+inline void
+halfCurve<float>::operator() (const half* in, float* out, size_t n) const
+{
+    IMATH_INTERNAL_NAMESPACE::halfCurveEvaluate (
+        _coeffs, _tableIndex, _table.data (), in, out, n);
+}
+
+/// @endcond
+
+#endif
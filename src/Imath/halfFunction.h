@@ -44,6 +44,31 @@
 //	    half x = hsin (1);
 //	    half y = hsqrt (3.5);
 //
+//	A table can also be evaluated for an array of half values at once:
+//
+//	    hsin (in, out, n);
+//
+//	The table takes 64K entries of T, so programs that use the same
+//	function in several places can share one table:
+//
+//	    std::shared_ptr<const halfFunction<half>> hsqrt =
+//		halfFunction<half>::shared (sqrt, 0, HALF_MAX);
+//
+//	shared() returns the existing table for the same function, domain
+//	and special values if there is one still in use, and builds a new
+//	one otherwise.  The function is identified by its type and, for a
+//	function pointer, its value, so it must be a function pointer or a
+//	functor without state, such as a lambda that captures nothing.
+//	The special values are compared with ==, except that for float,
+//	double and half, 0 and -0 are different values and all NANs are
+//	the same.
+//
+//	Both the constructor and shared() take an optional executor, which
+//	is called as executor (numTasks, task) and must call task (i) for
+//	every i in [0, numTasks), in any order and possibly concurrently,
+//	before returning.  The table is then filled in 16 tasks of 4096
+//	entries each, so the function must be safe to call concurrently.
+//
 //---------------------------------------------------------------------------
 
 #ifndef _HALF_FUNCTION_H_
@@ -59,7 +84,16 @@
 #else
 #endif
 
+#include <cmath>
 #include <float.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
 
 template <class T> class halfFunction
 {
@@ -78,6 +112,17 @@ public:
         T        negInfValue  = 0,
         T        nanValue     = 0);
 
+    template <class Function, class Executor>
+    halfFunction (
+        Function        f,
+        half            domainMin,
+        half            domainMax,
+        T               defaultValue,
+        T               posInfValue,
+        T               negInfValue,
+        T               nanValue,
+        const Executor& executor);
+
 #ifndef IMATH_HAVE_LARGE_STACK
     ~halfFunction () { delete[] _lut; }
     halfFunction (const halfFunction&) = delete;
@@ -92,7 +137,75 @@ public:
 
     T operator() (half x) const;
 
+    void operator() (const half* in, T* out, size_t n) const;
+
+    //-------------
+    // Shared table
+    //-------------
+
+    template <class Function>
+    static std::shared_ptr<const halfFunction> shared (
+        Function f,
+        half     domainMin    = -HALF_MAX,
+        half     domainMax    = HALF_MAX,
+        T        defaultValue = 0,
+        T        posInfValue  = 0,
+        T        negInfValue  = 0,
+        T        nanValue     = 0);
+
+    template <class Function, class Executor>
+    static std::shared_ptr<const halfFunction> shared (
+        Function        f,
+        half            domainMin,
+        half            domainMax,
+        T               defaultValue,
+        T               posInfValue,
+        T               negInfValue,
+        T               nanValue,
+        const Executor& executor);
+
 private:
+    static const int _taskSize = 1 << 12;
+
+    template <class Function>
+    void fill (
+        Function f,
+        half     domainMin,
+        half     domainMax,
+        T        defaultValue,
+        T        posInfValue,
+        T        negInfValue,
+        T        nanValue,
+        int      begin,
+        int      end);
+
+    template <class Function>
+    static std::string key (Function f, half domainMin, half domainMax);
+
+    typedef std::pair<std::type_index, std::string> Key;
+
+    struct Entry
+    {
+        T                                 values[4];
+        std::weak_ptr<const halfFunction> table;
+    };
+
+    struct Registry
+    {
+        std::mutex                mutex;
+        std::multimap<Key, Entry> tables;
+    };
+
+    static Registry& registry ();
+
+    static bool sameValues (const T* a, const T* b);
+    static bool sameValue (const T& a, const T& b, std::false_type);
+    static bool sameValue (const T& a, const T& b, std::true_type);
+
+    template <class Function, class Make>
+    static std::shared_ptr<const halfFunction>
+    findOrMake (const std::string& key, const T* values, Make make);
+
 #ifdef IMATH_HAVE_LARGE_STACK
     T _lut[1 << 16];
 #else
@@ -119,7 +232,65 @@ halfFunction<T>::halfFunction (
     _lut = new T[1 << 16];
 #endif
 
-    for (int i = 0; i < (1 << 16); i++)
+    fill (
+        f,
+        domainMin,
+        domainMax,
+        defaultValue,
+        posInfValue,
+        negInfValue,
+        nanValue,
+        0,
+        1 << 16);
+}
+
+template <class T>
+template <class Function, class Executor>
+halfFunction<T>::halfFunction (
+    Function        f,
+    half            domainMin,
+    half            domainMax,
+    T               defaultValue,
+    T               posInfValue,
+    T               negInfValue,
+    T               nanValue,
+    const Executor& executor)
+{
+#ifndef IMATH_HAVE_LARGE_STACK
+    _lut = new T[1 << 16];
+#endif
+
+    executor ((1 << 16) / _taskSize, [&] (size_t task) {
+        int begin = int (task) * _taskSize;
+
+        fill (
+            f,
+            domainMin,
+            domainMax,
+            defaultValue,
+            posInfValue,
+            negInfValue,
+            nanValue,
+            begin,
+            begin + _taskSize);
+    });
+}
+
+template <class T>
+template <class Function>
+void
+halfFunction<T>::fill (
+    Function f,
+    half     domainMin,
+    half     domainMax,
+    T        defaultValue,
+    T        posInfValue,
+    T        negInfValue,
+    T        nanValue,
+    int      begin,
+    int      end)
+{
+    for (int i = begin; i < end; i++)
     {
         half x;
         x.setBits (i);
@@ -142,6 +313,230 @@ halfFunction<T>::operator() (half x) const
     return _lut[x.bits ()];
 }
 
+template <class T>
+inline void
+halfFunction<T>::operator() (const half* in, T* out, size_t n) const
+{
+    for (size_t i = 0; i < n; i++)
+        out[i] = _lut[in[i].bits ()];
+}
+
+//
+// For float, the library looks up eight values per AVX2 gather if the
+// processor supports it.
+//
+
+template <>
+inline void
+halfFunction<float>::operator() (const half* in, float* out, size_t n) const
+{
+    IMATH_INTERNAL_NAMESPACE::halfFunctionLookup (&_lut[0], in, out, n);
+}
+
+template <class T>
+template <class Function>
+std::shared_ptr<const halfFunction<T>>
+halfFunction<T>::shared (
+    Function f,
+    half     domainMin,
+    half     domainMax,
+    T        defaultValue,
+    T        posInfValue,
+    T        negInfValue,
+    T        nanValue)
+{
+    T values[4] = {defaultValue, posInfValue, negInfValue, nanValue};
+
+    return findOrMake<Function> (
+        key (f, domainMin, domainMax), values, [&] () {
+            return std::make_shared<halfFunction> (
+                f,
+                domainMin,
+                domainMax,
+                defaultValue,
+                posInfValue,
+                negInfValue,
+                nanValue);
+        });
+}
+
+template <class T>
+template <class Function, class Executor>
+std::shared_ptr<const halfFunction<T>>
+halfFunction<T>::shared (
+    Function        f,
+    half            domainMin,
+    half            domainMax,
+    T               defaultValue,
+    T               posInfValue,
+    T               negInfValue,
+    T               nanValue,
+    const Executor& executor)
+{
+    T values[4] = {defaultValue, posInfValue, negInfValue, nanValue};
+
+    return findOrMake<Function> (
+        key (f, domainMin, domainMax), values, [&] () {
+            return std::make_shared<halfFunction> (
+                f,
+                domainMin,
+                domainMax,
+                defaultValue,
+                posInfValue,
+                negInfValue,
+                nanValue,
+                executor);
+        });
+}
+
+//
+// The bytes that identify a shared table, apart from the type of the
+// function and the special values: the function pointer, if any, and
+// the domain.
+//
+
+template <class T>
+template <class Function>
+std::string
+halfFunction<T>::key (Function f, half domainMin, half domainMax)
+{
+    static_assert (
+        std::is_pointer<Function>::value || std::is_empty<Function>::value,
+        "halfFunction::shared() requires a function pointer or a "
+        "functor without state");
+
+    std::string k;
+
+    if (std::is_pointer<Function>::value)
+        k.append (reinterpret_cast<const char*> (&f), sizeof (f));
+
+    unsigned short domain[2] = {domainMin.bits (), domainMax.bits ()};
+
+    k.append (reinterpret_cast<const char*> (domain), sizeof (domain));
+    return k;
+}
+
+//
+// Whether two sets of special values give the same table. Floating
+// point values are compared by their sign too, since the table of f
+// for -0 returns -0, and all NANs are the same; other types are
+// compared with ==.
+//
+
+template <class T>
+bool
+halfFunction<T>::sameValues (const T* a, const T* b)
+{
+    typedef std::integral_constant<
+        bool,
+        std::is_floating_point<T>::value || std::is_same<T, half>::value>
+        IsFloat;
+
+    for (int i = 0; i < 4; i++)
+        if (!sameValue (a[i], b[i], IsFloat ())) return false;
+
+    return true;
+}
+
+template <class T>
+bool
+halfFunction<T>::sameValue (const T& a, const T& b, std::false_type)
+{
+    return a == b;
+}
+
+template <class T>
+bool
+halfFunction<T>::sameValue (const T& a, const T& b, std::true_type)
+{
+    typedef typename std::conditional<std::is_same<T, half>::value, float, T>::
+        type F;
+
+    F x = F (a);
+    F y = F (b);
+
+    if (std::isnan (x) || std::isnan (y))
+        return std::isnan (x) && std::isnan (y);
+
+    return x == y && std::signbit (x) == std::signbit (y);
+}
+
+//
+// The shared tables of type T, by function type and key, each with
+// its special values.
+//
+
+template <class T>
+typename halfFunction<T>::Registry&
+halfFunction<T>::registry ()
+{
+    static Registry r;
+    return r;
+}
+
+//
+// Return the table registered under the function type, key and special
+// values, or register and return the one that make() builds. Tables
+// are held weakly, so each is freed once the last user releases it.
+// make() runs without the lock, so that tables for different functions
+// can be built concurrently; if two threads build the same table, the
+// first one registered wins.
+//
+
+template <class T>
+template <class Function, class Make>
+std::shared_ptr<const halfFunction<T>>
+halfFunction<T>::findOrMake (const std::string& key, const T* values, Make make)
+{
+    Registry& r = registry ();
+    Key       k (std::type_index (typeid (Function)), key);
+
+    auto find = [&] () -> std::shared_ptr<const halfFunction> {
+        auto range = r.tables.equal_range (k);
+
+        for (auto i = range.first; i != range.second; ++i)
+        {
+            if (sameValues (i->second.values, values))
+            {
+                if (std::shared_ptr<const halfFunction> p =
+                        i->second.table.lock ())
+                    return p;
+            }
+        }
+
+        return nullptr;
+    };
+
+    {
+        std::lock_guard<std::mutex> lock (r.mutex);
+
+        if (std::shared_ptr<const halfFunction> p = find ()) return p;
+    }
+
+    std::shared_ptr<const halfFunction> made = make ();
+
+    std::lock_guard<std::mutex> lock (r.mutex);
+
+    for (auto i = r.tables.begin (); i != r.tables.end ();)
+    {
+        if (i->second.table.expired ())
+            i = r.tables.erase (i);
+        else
+            ++i;
+    }
+
+    if (std::shared_ptr<const halfFunction> p = find ()) return p;
+
+    Entry entry;
+
+    for (int i = 0; i < 4; i++)
+        entry.values[i] = values[i];
+
+    entry.table = made;
+    r.tables.insert (std::make_pair (k, entry));
+    return made;
+}
+
 /// @endcond
 
 #endif
@@ -0,0 +1,1431 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+//
+// ImathBench -- timings of the performance-critical Imath operations.
+//
+// Each benchmark runs a loop of operations over arrays of random
+// inputs. After some untimed warmup repetitions, each timed
+// repetition yields one ns/op sample; the report lists percentiles of
+// those samples and the throughput at the median. With --json, the
+// results are also written in a machine-readable form, so that runs
+// of two releases can be compared.
+//
+// usage: ImathBench [--filter substring] [--json file] [--reps n]
+//                   [--warmup n] [--size n]
+//
+
+#include <ImathBVH.h>
+#include <ImathBoxAlgo.h>
+#include <ImathColorAlgo.h>
+#include <ImathConfig.h>
+#include <ImathDualQuat.h>
+#include <ImathEuler.h>
+#include <ImathFrustum.h>
+#include <ImathFrustumTest.h>
+#include <ImathMatrix.h>
+#include <ImathMath.h>
+#include <ImathMatrixAlgo.h>
+#include <ImathQuat.h>
+#include <ImathRandom.h>
+#include <ImathSphere.h>
+#include <ImathVec.h>
+#include <ImathVecArray.h>
+#include <half.h>
+#include <halfCurve.h>
+#include <halfFunction.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+using namespace IMATH_NAMESPACE;
+using namespace std;
+
+namespace
+{
+
+struct Options
+{
+    string filter;
+    string json;
+    int    reps   = 15;
+    int    warmup = 3;
+    size_t size   = 1 << 14;
+};
+
+struct Result
+{
+    string         name;
+    size_t         ops;     // operations per repetition
+    vector<double> nsPerOp; // one sample per timed repetition, sorted
+};
+
+//
+// Keep the compiler from discarding computations whose results are
+// otherwise unused.
+//
+
+volatile double sink;
+
+template <class T>
+void
+consume (const T* p, size_t bytes)
+{
+    const unsigned char* c = reinterpret_cast<const unsigned char*> (p);
+    sink = sink + c[0] + c[bytes / 2] + c[bytes - 1];
+}
+
+double
+percentile (const vector<double>& sorted, double p)
+{
+    // nearest rank
+    size_t rank = static_cast<size_t> (ceil (p / 100.0 * sorted.size ()));
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+class Bench
+{
+public:
+    explicit Bench (const Options& options) : _options (options) {}
+
+    size_t size () const { return _options.size; }
+
+    //
+    // Time body(), which performs ops operations, and record one
+    // ns/op sample per repetition.
+    //
+
+    template <class F> void run (const char* name, size_t ops, F body)
+    {
+        if (!_options.filter.empty () &&
+            strstr (name, _options.filter.c_str ()) == nullptr)
+            return;
+
+        for (int i = 0; i < _options.warmup; ++i)
+            body ();
+
+        Result r;
+        r.name = name;
+        r.ops  = ops;
+
+        for (int i = 0; i < _options.reps; ++i)
+        {
+            auto st = chrono::steady_clock::now ();
+            body ();
+            auto et = chrono::steady_clock::now ();
+
+            double ns = chrono::duration<double, nano> (et - st).count ();
+            r.nsPerOp.push_back (ns / static_cast<double> (ops));
+        }
+
+        sort (r.nsPerOp.begin (), r.nsPerOp.end ());
+        print (r);
+        _results.push_back (r);
+    }
+
+    bool writeJson () const;
+
+private:
+    static void print (const Result& r)
+    {
+        double median = percentile (r.nsPerOp, 50);
+        printf (
+            "%-36s %10.3f %10.3f %10.3f %10.3f %12.4g\n",
+            r.name.c_str (),
+            r.nsPerOp.front (),
+            median,
+            percentile (r.nsPerOp, 90),
+            r.nsPerOp.back (),
+            1e9 / median);
+    }
+
+    const Options& _options;
+    vector<Result> _results;
+};
+
+bool
+Bench::writeJson () const
+{
+    FILE* f = fopen (_options.json.c_str (), "w");
+    if (!f)
+    {
+        fprintf (
+            stderr, "Cannot open '%s' for writing\n", _options.json.c_str ());
+        return false;
+    }
+
+    fprintf (f, "{\n");
+    fprintf (f, "  \"imath_version\": \"%s\",\n", IMATH_VERSION_STRING);
+    fprintf (f, "  \"reps\": %d,\n", _options.reps);
+    fprintf (f, "  \"warmup\": %d,\n", _options.warmup);
+    fprintf (f, "  \"size\": %zu,\n", _options.size);
+    fprintf (f, "  \"benchmarks\": [");
+
+    for (size_t i = 0; i < _results.size (); ++i)
+    {
+        const Result& r = _results[i];
+
+        double mean = 0;
+        for (double s: r.nsPerOp)
+            mean += s;
+        mean /= r.nsPerOp.size ();
+
+        double var = 0;
+        for (double s: r.nsPerOp)
+            var += (s - mean) * (s - mean);
+        double stddev = sqrt (var / r.nsPerOp.size ());
+
+        double median = percentile (r.nsPerOp, 50);
+
+        fprintf (f, "%s\n    {\n", i ? "," : "");
+        fprintf (f, "      \"name\": \"%s\",\n", r.name.c_str ());
+        fprintf (f, "      \"ops_per_rep\": %zu,\n", r.ops);
+        fprintf (f, "      \"ns_per_op\": {\n");
+        fprintf (f, "        \"min\": %.6g,\n", r.nsPerOp.front ());
+        fprintf (f, "        \"p10\": %.6g,\n", percentile (r.nsPerOp, 10));
+        fprintf (f, "        \"median\": %.6g,\n", median);
+        fprintf (f, "        \"p90\": %.6g,\n", percentile (r.nsPerOp, 90));
+        fprintf (f, "        \"max\": %.6g,\n", r.nsPerOp.back ());
+        fprintf (f, "        \"mean\": %.6g,\n", mean);
+        fprintf (f, "        \"stddev\": %.6g\n", stddev);
+        fprintf (f, "      },\n");
+        fprintf (f, "      \"ops_per_sec\": %.6g\n", 1e9 / median);
+        fprintf (f, "    }");
+    }
+
+    fprintf (f, "\n  ]\n}\n");
+
+    bool ok = !ferror (f);
+    fclose (f);
+    return ok;
+}
+
+//
+// Random inputs
+//
+
+template <class T>
+Vec3<T>
+randomVec (Rand48& r, T lo, T hi)
+{
+    return Vec3<T> (
+        T (r.nextf (lo, hi)), T (r.nextf (lo, hi)), T (r.nextf (lo, hi)));
+}
+
+template <class T>
+Quat<T>
+randomQuat (Rand48& r)
+{
+    Quat<T> q (
+        T (r.nextf (-1, 1)),
+        T (r.nextf (-1, 1)),
+        T (r.nextf (-1, 1)),
+        T (r.nextf (-1, 1)));
+    return q.normalize ();
+}
+
+// A rotation, non-uniform scale and translation
+template <class T>
+Matrix44<T>
+randomTransform (Rand48& r)
+{
+    Matrix44<T> m = randomQuat<T> (r).toMatrix44 ();
+    m.scale (randomVec<T> (r, T (0.5), T (2)));
+    m.translate (randomVec<T> (r, T (-10), T (10)));
+    return m;
+}
+
+template <class T>
+Matrix44<T>
+randomMatrix (Rand48& r)
+{
+    Matrix44<T> m;
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            m[i][j] = T (r.nextf (-1, 1));
+    return m;
+}
+
+template <class T>
+Matrix33<T>
+randomMatrix33 (Rand48& r)
+{
+    Matrix33<T> m;
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            m[i][j] = T (r.nextf (-1, 1));
+    return m;
+}
+
+//
+// Benchmarks
+//
+
+void
+benchHalf (Bench& bench)
+{
+    size_t           n = bench.size ();
+    Rand48           r (1);
+    vector<uint16_t> h (n);
+    vector<float>    f (n);
+
+    for (size_t i = 0; i < n; ++i)
+        h[i] = imath_float_to_half (float (r.nextf (-1000, 1000)));
+
+    bench.run ("half/toFloat", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            f[i] = imath_half_to_float (h[i]);
+        consume (f.data (), n * sizeof (float));
+    });
+
+    bench.run ("half/toFloatNoTable", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            f[i] = imath_half_to_float_no_table (h[i]);
+        consume (f.data (), n * sizeof (float));
+    });
+
+    bench.run ("half/toFloatArray", n, [&] () {
+        imath_half_to_float_array (h.data (), f.data (), n);
+        consume (f.data (), n * sizeof (float));
+    });
+
+    bench.run ("half/fromFloat", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            h[i] = imath_float_to_half (f[i]);
+        consume (h.data (), n * sizeof (uint16_t));
+    });
+
+    bench.run ("half/fromFloatArray", n, [&] () {
+        imath_float_to_half_array (f.data (), h.data (), n);
+        consume (h.data (), n * sizeof (uint16_t));
+    });
+
+    halfFunction<float> square ([] (float x) { return x * x; });
+    const half*         hx = reinterpret_cast<const half*> (h.data ());
+
+    bench.run ("half/halfFunction", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            f[i] = square (hx[i]);
+        consume (f.data (), n * sizeof (float));
+    });
+
+    bench.run ("half/halfFunctionArray", n, [&] () {
+        square (hx, f.data (), n);
+        consume (f.data (), n * sizeof (float));
+    });
+
+    bench.run ("half/halfFunction build", 1 << 16, [&] () {
+        halfFunction<float> g ([] (float x) { return x * x; });
+        consume (&g, sizeof (float));
+    });
+
+    halfCurve<float> curve ([] (float x) { return x * x; });
+
+    bench.run ("half/halfCurve", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            f[i] = curve (hx[i]);
+        consume (f.data (), n * sizeof (float));
+    });
+
+    bench.run ("half/halfCurveArray", n, [&] () {
+        curve (hx, f.data (), n);
+        consume (f.data (), n * sizeof (float));
+    });
+}
+
+void
+benchRandom (Bench& bench)
+{
+    size_t         n = bench.size ();
+    Rand32         r32 (1);
+    Rand48         r48 (1);
+    vector<float>  f (n);
+    vector<double> d (n);
+
+    bench.run ("Random/Rand32 nextf", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            f[i] = r32.nextf ();
+        consume (f.data (), n * sizeof (float));
+    });
+
+    bench.run ("Random/Rand32 fill", n, [&] () {
+        r32.fill (f.data (), n);
+        consume (f.data (), n * sizeof (float));
+    });
+
+    bench.run ("Random/Rand48 nextf", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            d[i] = r48.nextf ();
+        consume (d.data (), n * sizeof (double));
+    });
+
+    bench.run ("Random/Rand48 fill", n, [&] () {
+        r48.fill (d.data (), n);
+        consume (d.data (), n * sizeof (double));
+    });
+
+    bench.run ("Random/Rand48 fill float", n, [&] () {
+        r48.fill (f.data (), n);
+        consume (f.data (), n * sizeof (float));
+    });
+}
+
+template <class T>
+void
+benchMatrix44 (Bench& bench, const char* suffix)
+{
+    size_t                 n = bench.size ();
+    Rand48                 r (2);
+    vector<Matrix44<T>>    a (n), b (n), c (n);
+    vector<Vec3<T>>        p (n), q (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = randomMatrix<T> (r);
+        b[i] = randomTransform<T> (r);
+        p[i] = randomVec<T> (r, T (-100), T (100));
+    }
+
+    string name;
+
+    name = string ("M44") + suffix + "/multiply";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i] = a[i] * b[i];
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("M44") + suffix + "/inverse";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i] = a[i].inverse ();
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("M44") + suffix + "/inverse (affine)";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i] = b[i].inverse ();
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("M44") + suffix + "/gjInverse";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i] = a[i].gjInverse ();
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("M44") + suffix + "/inverseAffine array";
+    bench.run (name.c_str (), n, [&] () {
+        inverseAffine (b.data (), c.data (), n);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("M44") + suffix + "/inverseRigid array";
+    bench.run (name.c_str (), n, [&] () {
+        inverseRigid (b.data (), c.data (), n);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("M44") + suffix + "/multVecMatrix";
+    bench.run (name.c_str (), n, [&] () {
+        const Matrix44<T>& m = b[0];
+        for (size_t i = 0; i < n; ++i)
+            m.multVecMatrix (p[i], q[i]);
+        consume (q.data (), n * sizeof (q[0]));
+    });
+
+    name = string ("M44") + suffix + "/multDirMatrix";
+    bench.run (name.c_str (), n, [&] () {
+        const Matrix44<T>& m = b[0];
+        for (size_t i = 0; i < n; ++i)
+            m.multDirMatrix (p[i], q[i]);
+        consume (q.data (), n * sizeof (q[0]));
+    });
+
+    name = string ("M44") + suffix + "/multVecMatrix array";
+    bench.run (name.c_str (), n, [&] () {
+        b[0].multVecMatrix (p.data (), q.data (), n);
+        consume (q.data (), n * sizeof (q[0]));
+    });
+
+    name = string ("M44") + suffix + "/multVecMatrix array projective";
+    bench.run (name.c_str (), n, [&] () {
+        a[0].multVecMatrix (p.data (), q.data (), n);
+        consume (q.data (), n * sizeof (q[0]));
+    });
+
+    vector<T> x (n), y (n), z (n), dx (n), dy (n), dz (n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        x[i] = p[i].x;
+        y[i] = p[i].y;
+        z[i] = p[i].z;
+    }
+
+    name = string ("M44") + suffix + "/multVecMatrix SoA";
+    bench.run (name.c_str (), n, [&] () {
+        b[0].multVecMatrix (
+            x.data (),
+            y.data (),
+            z.data (),
+            dx.data (),
+            dy.data (),
+            dz.data (),
+            n);
+        consume (dx.data (), n * sizeof (dx[0]));
+    });
+
+    name = string ("M44") + suffix + "/multDirMatrix array";
+    bench.run (name.c_str (), n, [&] () {
+        b[0].multDirMatrix (p.data (), q.data (), n);
+        consume (q.data (), n * sizeof (q[0]));
+    });
+
+    vector<Vec3A<T>> pa (p.begin (), p.end ()), qa (n);
+
+    name = string ("M44") + suffix + "/multVecMatrix varying";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            a[i].multVecMatrix (p[i], q[i]);
+        consume (q.data (), n * sizeof (q[0]));
+    });
+
+    name = string ("M44") + suffix + "/multVecMatrix Vec3A varying";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            a[i].multVecMatrix (pa[i], qa[i]);
+        consume (qa.data (), n * sizeof (qa[0]));
+    });
+
+    name = string ("M44") + suffix + "/multVecMatrix Vec3A array";
+    bench.run (name.c_str (), n, [&] () {
+        b[0].multVecMatrix (pa.data (), qa.data (), n);
+        consume (qa.data (), n * sizeof (qa[0]));
+    });
+
+    name = string ("M44") + suffix + "/multVecMatrix Vec3A array projective";
+    bench.run (name.c_str (), n, [&] () {
+        a[0].multVecMatrix (pa.data (), qa.data (), n);
+        consume (qa.data (), n * sizeof (qa[0]));
+    });
+
+    name = string ("M44") + suffix + "/multDirMatrix Vec3A array";
+    bench.run (name.c_str (), n, [&] () {
+        b[0].multDirMatrix (pa.data (), qa.data (), n);
+        consume (qa.data (), n * sizeof (qa[0]));
+    });
+
+    name = string ("M44") + suffix + "/extractSHRT";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vec3<T> s, h, rot;
+            extractSHRT (b[i], s, h, rot, q[i], false);
+        }
+        consume (q.data (), n * sizeof (q[0]));
+    });
+}
+
+template <class T>
+void
+benchVecArray (Bench& bench, const char* suffix)
+{
+    size_t          n = bench.size ();
+    Rand48          r (9);
+    vector<Vec3<T>> a (n), b (n), c (n);
+    vector<T>       d (n);
+    Matrix44<T>     m = randomTransform<T> (r);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = randomVec<T> (r, T (-1), T (1));
+        b[i] = randomVec<T> (r, T (-1), T (1));
+    }
+
+    Vec3Array<T> sa (a.data (), n), sb (b.data (), n), sc (n);
+
+    string name;
+
+    name = string ("VecArray") + suffix + "/dot aos";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            d[i] = a[i].dot (b[i]);
+        consume (d.data (), n * sizeof (d[0]));
+    });
+
+    name = string ("VecArray") + suffix + "/dot soa";
+    bench.run (name.c_str (), n, [&] () {
+        dot (sa, sb, d.data ());
+        consume (d.data (), n * sizeof (d[0]));
+    });
+
+    name = string ("VecArray") + suffix + "/cross aos";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i] = a[i].cross (b[i]);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("VecArray") + suffix + "/cross soa";
+    bench.run (name.c_str (), n, [&] () {
+        cross (sa, sb, sc);
+        consume (sc.x (), n * sizeof (T));
+    });
+
+    name = string ("VecArray") + suffix + "/length aos";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            d[i] = a[i].length ();
+        consume (d.data (), n * sizeof (d[0]));
+    });
+
+    name = string ("VecArray") + suffix + "/length soa";
+    bench.run (name.c_str (), n, [&] () {
+        length (sa, d.data ());
+        consume (d.data (), n * sizeof (d[0]));
+    });
+
+    c  = a;
+    sc = sa;
+
+    name = string ("VecArray") + suffix + "/normalize aos";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i].normalize ();
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("VecArray") + suffix + "/normalize soa";
+    bench.run (name.c_str (), n, [&] () {
+        normalize (sc);
+        consume (sc.x (), n * sizeof (T));
+    });
+
+    name = string ("VecArray") + suffix + "/multVecMatrix aos";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            m.multVecMatrix (a[i], c[i]);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("VecArray") + suffix + "/multVecMatrix soa";
+    bench.run (name.c_str (), n, [&] () {
+        multVecMatrix (m, sa, sc);
+        consume (sc.x (), n * sizeof (T));
+    });
+}
+
+void
+benchColor (Bench& bench)
+{
+    size_t      n = bench.size ();
+    Rand48      r (3);
+    vector<C4f> a (n), b (n);
+    vector<C3f> a3 (n), b3 (n);
+    vector<C4h> ah (n), bh (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = C4f (
+            float (r.nextf ()),
+            float (r.nextf ()),
+            float (r.nextf ()),
+            float (r.nextf ()));
+        a3[i] = C3f (a[i].r, a[i].g, a[i].b);
+        ah[i] = C4h (a[i].r, a[i].g, a[i].b, a[i].a);
+    }
+
+    bench.run ("Color/hsv2rgb C4f", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            b[i] = hsv2rgb (a[i]);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    bench.run ("Color/hsv2rgb C4f array", n, [&] () {
+        hsv2rgb (a.data (), b.data (), n);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    bench.run ("Color/hsv2rgb C3f array", n, [&] () {
+        hsv2rgb (a3.data (), b3.data (), n);
+        consume (b3.data (), n * sizeof (b3[0]));
+    });
+
+    bench.run ("Color/hsv2rgb C4h", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            bh[i] = hsv2rgb (ah[i]);
+        consume (bh.data (), n * sizeof (bh[0]));
+    });
+
+    bench.run ("Color/hsv2rgb C4h array", n, [&] () {
+        hsv2rgb (ah.data (), bh.data (), n);
+        consume (bh.data (), n * sizeof (bh[0]));
+    });
+
+    bench.run ("Color/rgb2hsv C4f", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            b[i] = rgb2hsv (a[i]);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    bench.run ("Color/rgb2hsv C4f array", n, [&] () {
+        rgb2hsv (a.data (), b.data (), n);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    bench.run ("Color/rgb2hsv C3f array", n, [&] () {
+        rgb2hsv (a3.data (), b3.data (), n);
+        consume (b3.data (), n * sizeof (b3[0]));
+    });
+
+    bench.run ("Color/rgb2hsv C4h", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            bh[i] = rgb2hsv (ah[i]);
+        consume (bh.data (), n * sizeof (bh[0]));
+    });
+
+    bench.run ("Color/rgb2hsv C4h array", n, [&] () {
+        rgb2hsv (ah.data (), bh.data (), n);
+        consume (bh.data (), n * sizeof (bh[0]));
+    });
+
+    vector<PackedColor> p (n);
+
+    bench.run ("Color/rgb2packed C4f", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            p[i] = rgb2packed (a[i]);
+        consume (p.data (), n * sizeof (p[0]));
+    });
+
+    bench.run ("Color/rgb2packed C4f array", n, [&] () {
+        rgb2packed (a.data (), p.data (), n);
+        consume (p.data (), n * sizeof (p[0]));
+    });
+
+    bench.run ("Color/rgb2packed C4f array dither", n, [&] () {
+        rgb2packed (a.data (), p.data (), n, PACKED_DITHER);
+        consume (p.data (), n * sizeof (p[0]));
+    });
+
+    bench.run ("Color/rgb2packed C4f array srgb", n, [&] () {
+        rgb2packed (a.data (), p.data (), n, PACKED_SRGB);
+        consume (p.data (), n * sizeof (p[0]));
+    });
+
+    bench.run ("Color/rgb2packed C4h array", n, [&] () {
+        rgb2packed (ah.data (), p.data (), n);
+        consume (p.data (), n * sizeof (p[0]));
+    });
+
+    bench.run ("Color/packed2rgb C4f", n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            packed2rgb (p[i], b[i]);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    bench.run ("Color/packed2rgb C4f array", n, [&] () {
+        packed2rgb (p.data (), b.data (), n);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    bench.run ("Color/packed2rgb C4f array srgb", n, [&] () {
+        packed2rgb (p.data (), b.data (), n, PACKED_SRGB);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    bench.run ("Color/packed2rgb C4h array", n, [&] () {
+        packed2rgb (p.data (), bh.data (), n);
+        consume (bh.data (), n * sizeof (bh[0]));
+    });
+}
+
+template <class T>
+void
+benchQuat (Bench& bench, const char* suffix)
+{
+    size_t          n = bench.size ();
+    Rand48          r (3);
+    vector<Quat<T>> a (n), b (n), c (n);
+    vector<T>       t (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        a[i] = randomQuat<T> (r);
+        b[i] = randomQuat<T> (r);
+        t[i] = T (r.nextf ());
+    }
+
+    string name;
+
+    name = string ("Quat") + suffix + "/slerp";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i] = slerp (a[i], b[i], t[i]);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("Quat") + suffix + "/slerpShortestArc";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i] = slerpShortestArc (a[i], b[i], t[i]);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("Quat") + suffix + "/slerpApprox";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i] = slerpApprox (a[i], b[i], t[i]);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    vector<SlerpKey<T>> keys (n);
+
+    for (size_t i = 0; i < n; ++i)
+        keys[i] = SlerpKey<T> (a[i], b[i], true);
+
+    name = string ("Quat") + suffix + "/slerp SlerpKey array";
+    bench.run (name.c_str (), n, [&] () {
+        slerp (keys.data (), t.data (), c.data (), n);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("Quat") + suffix + "/slerpApprox SlerpKey array";
+    bench.run (name.c_str (), n, [&] () {
+        slerpApprox (keys.data (), t.data (), c.data (), n);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    vector<Matrix44<T>> m (n);
+    vector<TRS<T>>      trs (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        m[i]   = randomTransform<T> (r);
+        trs[i] = TRS<T> (a[i], randomVec<T> (r, T (-10), T (10)));
+    }
+
+    name = string ("Quat") + suffix + "/toMatrix44";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            m[i] = a[i].toMatrix44 ();
+        consume (m.data (), n * sizeof (m[0]));
+    });
+
+    name = string ("Quat") + suffix + "/toMatrix44 array";
+    bench.run (name.c_str (), n, [&] () {
+        toMatrix44 (a.data (), m.data (), n);
+        consume (m.data (), n * sizeof (m[0]));
+    });
+
+    name = string ("Quat") + suffix + "/extractQuat";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            c[i] = extractQuat (m[i]);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("Quat") + suffix + "/extractQuat array";
+    bench.run (name.c_str (), n, [&] () {
+        extractQuat (m.data (), c.data (), n);
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("Quat") + suffix + "/TRS toMatrix44 array";
+    bench.run (name.c_str (), n, [&] () {
+        toMatrix44 (trs.data (), m.data (), n);
+        consume (m.data (), n * sizeof (m[0]));
+    });
+
+    name = string ("Quat") + suffix + "/extractTRS array";
+    bench.run (name.c_str (), n, [&] () {
+        extractTRS (m.data (), trs.data (), n);
+        consume (trs.data (), n * sizeof (trs[0]));
+    });
+}
+
+template <class T>
+void
+benchTrig (Bench& bench, const char* suffix)
+{
+    size_t    n = bench.size ();
+    Rand48    r (6);
+    vector<T> x (n), y (n), s (n), c (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        x[i] = T (r.nextf (-M_PI, M_PI));
+        y[i] = T (r.nextf (-1, 1));
+    }
+
+    string name;
+
+    name = string ("Trig") + suffix + "/sincos";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            sincos (x[i], s[i], c[i]);
+        consume (s.data (), n * sizeof (s[0]));
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("Trig") + suffix + "/sincosApprox";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            sincosApprox (x[i], s[i], c[i]);
+        consume (s.data (), n * sizeof (s[0]));
+        consume (c.data (), n * sizeof (c[0]));
+    });
+
+    name = string ("Trig") + suffix + "/atan2";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            s[i] = std::atan2 (y[i], x[i]);
+        consume (s.data (), n * sizeof (s[0]));
+    });
+
+    name = string ("Trig") + suffix + "/atan2Approx";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            s[i] = atan2Approx (y[i], x[i]);
+        consume (s.data (), n * sizeof (s[0]));
+    });
+}
+
+template <class T>
+void
+benchEuler (Bench& bench, const char* suffix)
+{
+    size_t              n = bench.size ();
+    Rand48              r (5);
+    vector<Euler<T>>    e (n), x (n);
+    vector<Matrix44<T>> m (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        e[i] = Euler<T> (randomVec<T> (r, T (-M_PI), T (M_PI)), Euler<T>::ZXY);
+        x[i] = Euler<T> (Euler<T>::ZXY);
+    }
+
+    string name;
+
+    name = string ("Euler") + suffix + "/toMatrix44";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            m[i] = e[i].toMatrix44 ();
+        consume (m.data (), n * sizeof (m[0]));
+    });
+
+    name = string ("Euler") + suffix + "/toMatrix44 array";
+    bench.run (name.c_str (), n, [&] () {
+        toMatrix44 (e.data (), m.data (), n);
+        consume (m.data (), n * sizeof (m[0]));
+    });
+
+    name = string ("Euler") + suffix + "/extract";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            x[i].extract (m[i]);
+        consume (x.data (), n * sizeof (x[0]));
+    });
+
+    name = string ("Euler") + suffix + "/extractEuler array";
+    bench.run (name.c_str (), n, [&] () {
+        extractEuler (m.data (), x.data (), n);
+        consume (x.data (), n * sizeof (x[0]));
+    });
+}
+
+// Skinning with 4 influences per vertex out of 64 bones, by blending
+// matrices and by blending dual quaternions.
+template <class T>
+void
+benchDualQuat (Bench& bench, const char* suffix)
+{
+    const int           numBones = 64, influences = 4;
+    size_t              n        = bench.size ();
+    Rand48              r (4);
+    vector<Matrix44<T>> mBones (numBones);
+    vector<DualQuat<T>> dqBones (numBones);
+
+    for (int i = 0; i < numBones; ++i)
+    {
+        dqBones[i] = DualQuat<T> (
+            randomQuat<T> (r), randomVec<T> (r, T (-10), T (10)));
+        mBones[i] = dqBones[i].toMatrix44 ();
+    }
+
+    vector<uint32_t> indices (n * influences);
+    vector<T>        weights (n * influences);
+    vector<Vec3<T>>  p (n), result (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        for (int k = 0; k < influences; ++k)
+        {
+            indices[i * influences + k] = r.nexti () % numBones;
+            weights[i * influences + k] = T (0.25);
+        }
+        p[i] = randomVec<T> (r, T (-10), T (10));
+    }
+
+    string name;
+
+    name = string ("DualQuat") + suffix + "/skin Matrix44 blend";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const uint32_t* b = &indices[i * influences];
+            const T*        w = &weights[i * influences];
+            Matrix44<T>     m = mBones[b[0]] * w[0];
+            for (int k = 1; k < influences; ++k)
+                m += mBones[b[k]] * w[k];
+
+            const Vec3<T>& v = p[i];
+            result[i]        = Vec3<T> (
+                v.x * m[0][0] + v.y * m[1][0] + v.z * m[2][0] + m[3][0],
+                v.x * m[0][1] + v.y * m[1][1] + v.z * m[2][1] + m[3][1],
+                v.x * m[0][2] + v.y * m[1][2] + v.z * m[2][2] + m[3][2]);
+        }
+        consume (result.data (), n * sizeof (result[0]));
+    });
+
+    name = string ("DualQuat") + suffix + "/skin";
+    bench.run (name.c_str (), n, [&] () {
+        skin (
+            dqBones.data (),
+            indices.data (),
+            weights.data (),
+            influences,
+            p.data (),
+            result.data (),
+            n);
+        consume (result.data (), n * sizeof (result[0]));
+    });
+}
+
+template <class T>
+void
+benchMatrixAlgo (Bench& bench, const char* suffix)
+{
+    // These are much slower per operation, so use fewer of them
+    size_t              n = std::max<size_t> (bench.size () / 16, 1);
+    Rand48              r (4);
+    vector<Matrix33<T>> a3 (n), s3 (n), u3 (n), v3 (n);
+    vector<Matrix44<T>> a4 (n), s4 (n), u4 (n), v4 (n);
+    vector<Vec3<T>>     w3 (n);
+    vector<Vec4<T>>     w4 (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        a3[i] = randomMatrix33<T> (r);
+        a4[i] = randomMatrix<T> (r);
+
+        // symmetric inputs for the eigensolver
+        s3[i] = a3[i] * a3[i].transposed ();
+        s4[i] = a4[i] * a4[i].transposed ();
+    }
+
+    string name;
+
+    name = string ("M33") + suffix + "/jacobiSVD";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            jacobiSVD (a3[i], u3[i], w3[i], v3[i]);
+        consume (w3.data (), n * sizeof (w3[0]));
+    });
+
+    name = string ("M44") + suffix + "/jacobiSVD";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            jacobiSVD (a4[i], u4[i], w4[i], v4[i]);
+        consume (w4.data (), n * sizeof (w4[0]));
+    });
+
+    name = string ("M33") + suffix + "/jacobiEigenSolver";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+        {
+            Matrix33<T> A = s3[i];
+            jacobiEigenSolver (A, w3[i], v3[i]);
+        }
+        consume (w3.data (), n * sizeof (w3[0]));
+    });
+
+    name = string ("M44") + suffix + "/jacobiEigenSolver";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+        {
+            Matrix44<T> A = s4[i];
+            jacobiEigenSolver (A, w4[i], v4[i]);
+        }
+        consume (w4.data (), n * sizeof (w4[0]));
+    });
+
+    {
+        // Point sets for the Procrustes solvers
+        size_t          np = bench.size ();
+        Matrix44<T>     m  = randomMatrix<T> (r);
+        vector<Vec3<T>> from (np), to (np);
+        vector<T>       weights (np);
+        for (size_t i = 0; i < np; ++i)
+        {
+            from[i]    = randomVec<T> (r, T (-10), T (10));
+            to[i]      = from[i] * m;
+            weights[i] = T (r.nextf (0.5, 1.5));
+        }
+
+        name = string ("V3") + suffix + "/procrustesRotationAndTranslation";
+        bench.run (name.c_str (), np, [&] () {
+            M44d x = procrustesRotationAndTranslation (
+                from.data (), to.data (), weights.data (), np, true);
+            consume (&x, sizeof (x));
+        });
+
+        name = string ("V3") + suffix + "/ProcrustesAccumulator";
+        bench.run (name.c_str (), np, [&] () {
+            ProcrustesAccumulator acc;
+            acc.add (from.data (), to.data (), weights.data (), np);
+            M44d x = acc.solve (true);
+            consume (&x, sizeof (x));
+        });
+    }
+
+    name = string ("M33") + suffix + "/jacobiSVD array";
+    bench.run (name.c_str (), n, [&] () {
+        jacobiSVD (a3.data (), u3.data (), w3.data (), v3.data (), n);
+        consume (w3.data (), n * sizeof (w3[0]));
+    });
+
+    name = string ("M44") + suffix + "/jacobiSVD array";
+    bench.run (name.c_str (), n, [&] () {
+        jacobiSVD (a4.data (), u4.data (), w4.data (), v4.data (), n);
+        consume (w4.data (), n * sizeof (w4[0]));
+    });
+
+    name = string ("M33") + suffix + "/jacobiEigenSolver array";
+    bench.run (name.c_str (), n, [&] () {
+        jacobiEigenSolver (s3.data (), w3.data (), v3.data (), n);
+        consume (w3.data (), n * sizeof (w3[0]));
+    });
+
+    name = string ("M44") + suffix + "/jacobiEigenSolver array";
+    bench.run (name.c_str (), n, [&] () {
+        jacobiEigenSolver (s4.data (), w4.data (), v4.data (), n);
+        consume (w4.data (), n * sizeof (w4[0]));
+    });
+}
+
+template <class T>
+void
+benchBox (Bench& bench, const char* suffix)
+{
+    size_t                n = bench.size ();
+    Rand48                r (5);
+    vector<Box<Vec3<T>>>  a (n), b (n);
+    vector<Matrix44<T>>   m (n);
+    vector<Sphere3<T>>    s (n);
+    vector<unsigned char> visible (n);
+    vector<size_t>        indices (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec3<T> c = randomVec<T> (r, T (-1000), T (1000));
+        Vec3<T> e = randomVec<T> (r, T (0), T (10));
+        a[i]      = Box<Vec3<T>> (c - e, c + e);
+        m[i]      = randomTransform<T> (r);
+        s[i]      = Sphere3<T> (c, e.x);
+    }
+
+    string name;
+
+    name = string ("Box3") + suffix + "/transform";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            b[i] = transform (a[i], m[i]);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    name = string ("Box3") + suffix + "/affineTransform";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            b[i] = affineTransform (a[i], m[i]);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    name = string ("Box3") + suffix + "/transform array";
+    bench.run (name.c_str (), n, [&] () {
+        transform (a.data (), m.data (), b.data (), n);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    name = string ("Box3") + suffix + "/affineTransform array";
+    bench.run (name.c_str (), n, [&] () {
+        affineTransform (a.data (), m.data (), b.data (), n);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    name = string ("Box3") + suffix + "/transform array, one matrix";
+    bench.run (name.c_str (), n, [&] () {
+        transform (a.data (), m[0], b.data (), n);
+        consume (b.data (), n * sizeof (b[0]));
+    });
+
+    Frustum<T>     frustum (T (1), T (1000), T (1.2), T (0), T (1.5));
+    Matrix44<T>    camera;
+    FrustumTest<T> frustumTest (frustum, camera);
+
+    name = string ("Box3") + suffix + "/FrustumTest::isVisible";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            visible[i] = frustumTest.isVisible (a[i]);
+        consume (visible.data (), n);
+    });
+
+    name = string ("Sphere3") + suffix + "/FrustumTest::isVisible";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+            visible[i] = frustumTest.isVisible (s[i]);
+        consume (visible.data (), n);
+    });
+
+    name = string ("Box3") + suffix + "/FrustumTest::isVisible array";
+    bench.run (name.c_str (), n, [&] () {
+        frustumTest.isVisible (a.data (), n, visible.data ());
+        consume (visible.data (), n);
+    });
+
+    name = string ("Sphere3") + suffix + "/FrustumTest::isVisible array";
+    bench.run (name.c_str (), n, [&] () {
+        frustumTest.isVisible (s.data (), n, visible.data ());
+        consume (visible.data (), n);
+    });
+
+    name = string ("Box3") + suffix + "/FrustumTest::visibleIndices";
+    bench.run (name.c_str (), n, [&] () {
+        size_t count =
+            frustumTest.visibleIndices (a.data (), n, indices.data ());
+        consume (indices.data (), count * sizeof (indices[0]));
+    });
+
+    //
+    // Rays aimed near the boxes, eight per box; the packet versions
+    // test one box against eight rays, and one ray against eight boxes.
+    //
+
+    const int               N  = 8;
+    size_t                  np = n / N;
+    vector<Line3<T>>        rays (n);
+    vector<RayPacket<T, N>> rayPackets (np);
+    vector<BoxPacket<T, N>> boxPackets (np);
+    vector<T>               tEntry (np * N);
+    vector<uint32_t>        masks (np);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec3<T> c = a[i / N].center ();
+        rays[i]   = Line3<T> (
+            c + randomVec<T> (r, T (-50), T (50)),
+            c + randomVec<T> (r, T (-10), T (10)));
+    }
+
+    for (size_t j = 0; j < np; ++j)
+    {
+        for (int k = 0; k < N; ++k)
+        {
+            rayPackets[j].set (k, rays[j * N + k]);
+            boxPackets[j].set (k, a[j * N + k]);
+        }
+    }
+
+    name = string ("Box3") + suffix + "/intersects ray";
+    bench.run (name.c_str (), np * N, [&] () {
+        for (size_t i = 0; i < np * N; ++i)
+            visible[i] = intersects (a[i / N], rays[i]);
+        consume (visible.data (), np * N);
+    });
+
+    name = string ("Box3") + suffix + "/intersects RayPacket8";
+    bench.run (name.c_str (), np * N, [&] () {
+        for (size_t j = 0; j < np; ++j)
+            masks[j] = intersects (a[j], rayPackets[j], &tEntry[j * N]);
+        consume (masks.data (), np * sizeof (masks[0]));
+    });
+
+    name = string ("Box3") + suffix + "/intersects BoxPacket8";
+    bench.run (name.c_str (), np * N, [&] () {
+        for (size_t j = 0; j < np; ++j)
+            masks[j] = intersects (boxPackets[j], rays[j * N], &tEntry[j * N]);
+        consume (masks.data (), np * sizeof (masks[0]));
+    });
+}
+
+template <class T>
+void
+benchBVH (Bench& bench, const char* suffix)
+{
+    //
+    // A few thousand boxes, as in picking and collision queries, with
+    // one query per box.
+    //
+
+    size_t                n = 4096;
+    Rand48                r (9);
+    vector<Box<Vec3<T>>>  boxes (n);
+    vector<Line3<T>>      rays (n);
+    vector<Vec3<T>>       points (n);
+    vector<size_t>        hits (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec3<T> c = randomVec<T> (r, T (-100), T (100));
+        Vec3<T> e = randomVec<T> (r, T (0), T (2));
+        boxes[i]  = Box<Vec3<T>> (c - e, c + e);
+        rays[i]   = Line3<T> (
+            randomVec<T> (r, T (-200), T (200)),
+            randomVec<T> (r, T (-50), T (50)));
+        points[i] = randomVec<T> (r, T (-100), T (100));
+    }
+
+    string name;
+    BVH<T> bvh;
+
+    name = string ("BVH") + suffix + "/build";
+    bench.run (name.c_str (), n, [&] () {
+        bvh.build (boxes.data (), n);
+        consume (bvh.nodes (), bvh.numNodes () * sizeof (bvh.nodes ()[0]));
+    });
+
+    bvh.build (boxes.data (), n);
+
+    name = string ("BVH") + suffix + "/intersect";
+    bench.run (name.c_str (), n, [&] () {
+        T t;
+        for (size_t i = 0; i < n; ++i)
+            hits[i] = bvh.intersect (rays[i], t);
+        consume (hits.data (), n * sizeof (hits[0]));
+    });
+
+    name = string ("BVH") + suffix + "/intersect brute force";
+    bench.run (name.c_str (), n, [&] () {
+        for (size_t i = 0; i < n; ++i)
+        {
+            T      tBest = numeric_limits<T>::max ();
+            size_t best  = BVH<T>::npos;
+
+            for (size_t j = 0; j < n; ++j)
+            {
+                Vec3<T> ip (0);
+                if (!intersects (boxes[j], rays[i], ip)) continue;
+
+                T t = (ip - rays[i].pos).length ();
+                if (t < tBest)
+                {
+                    tBest = t;
+                    best  = j;
+                }
+            }
+
+            hits[i] = best;
+        }
+        consume (hits.data (), n * sizeof (hits[0]));
+    });
+
+    name = string ("BVH") + suffix + "/nearest";
+    bench.run (name.c_str (), n, [&] () {
+        T d;
+        for (size_t i = 0; i < n; ++i)
+            hits[i] = bvh.nearest (points[i], d);
+        consume (hits.data (), n * sizeof (hits[0]));
+    });
+}
+
+void
+usage (const char* argv0)
+{
+    fprintf (
+        stderr,
+        "usage: %s [--filter substring] [--json file] [--reps n]\n"
+        "       [--warmup n] [--size n]\n",
+        argv0);
+}
+
+} // namespace
+
+int
+main (int argc, char* argv[])
+{
+    Options options;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        bool hasValue = i + 1 < argc;
+
+        if (!strcmp (argv[i], "--filter") && hasValue)
+            options.filter = argv[++i];
+        else if (!strcmp (argv[i], "--json") && hasValue)
+            options.json = argv[++i];
+        else if (!strcmp (argv[i], "--reps") && hasValue)
+            options.reps = atoi (argv[++i]);
+        else if (!strcmp (argv[i], "--warmup") && hasValue)
+            options.warmup = atoi (argv[++i]);
+        else if (!strcmp (argv[i], "--size") && hasValue)
+            options.size = strtoul (argv[++i], nullptr, 10);
+        else
+        {
+            usage (argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.reps < 1 || options.warmup < 0 || options.size < 1)
+    {
+        usage (argv[0]);
+        return 1;
+    }
+
+    printf (
+        "%-36s %10s %10s %10s %10s %12s\n",
+        "benchmark (ns/op)",
+        "min",
+        "median",
+        "p90",
+        "max",
+        "ops/s");
+
+    Bench bench (options);
+
+    benchHalf (bench);
+    benchRandom (bench);
+    benchMatrix44<float> (bench, "f");
+    benchMatrix44<double> (bench, "d");
+    benchVecArray<float> (bench, "f");
+    benchVecArray<double> (bench, "d");
+    benchColor (bench);
+    benchQuat<float> (bench, "f");
+    benchQuat<double> (bench, "d");
+    benchTrig<float> (bench, "f");
+    benchTrig<double> (bench, "d");
+    benchEuler<float> (bench, "f");
+    benchEuler<double> (bench, "d");
+    benchDualQuat<float> (bench, "f");
+    benchDualQuat<double> (bench, "d");
+    benchMatrixAlgo<float> (bench, "f");
+    benchMatrixAlgo<double> (bench, "d");
+    benchBox<float> (bench, "f");
+    benchBox<double> (bench, "d");
+    benchBVH<float> (bench, "f");
+    benchBVH<double> (bench, "d");
+
+    if (!options.json.empty () && !bench.writeJson ()) return 1;
+
+    return 0;
+}
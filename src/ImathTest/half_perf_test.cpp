@@ -356,6 +356,126 @@ perf_test_float_to_half (uint16_t* halfs, const float* floats, int numentries)
         ((long long) (onanos - nnanos)));
 }
 
+//
+// Compare the half-to-float paths, both on their own and with a
+// working set of pressureBytes touched between batches of
+// conversions, which evicts the lookup table from the cache the way
+// an application's own data would. Only the conversions are timed.
+//
+
+static const char* const conversion_impl_names[] = {
+    "scalar", "f16c", "avx2", "avx512"};
+
+static volatile uint32_t pressure_sink;
+
+static void
+apply_cache_pressure (uint32_t* working, size_t count)
+{
+    uint32_t sum = 0;
+    for (size_t i = 0; i < count; i += 16) // one touch per cache line
+    {
+        working[i] += 1;
+        sum += working[i];
+    }
+    pressure_sink = sum;
+}
+
+template <class Convert>
+static double
+time_half_to_float (
+    Convert         convert,
+    float*          floats,
+    const uint16_t* halfs,
+    int             numentries,
+    uint32_t*       working,
+    size_t          workingCount)
+{
+    const int batch = 4096;
+    int64_t   nanos = 0;
+
+    for (int b = 0; b < numentries; b += batch)
+    {
+        int n = (numentries - b < batch) ? numentries - b : batch;
+
+        if (workingCount) apply_cache_pressure (working, workingCount);
+
+        int64_t st = get_ticks ();
+        convert (floats + b, halfs + b, n);
+        nanos += get_ticks () - st;
+    }
+
+    return (double) nanos / (double) numentries;
+}
+
+void
+perf_test_half_to_float_paths (
+    const char*     data,
+    float*          floats,
+    const uint16_t* halfs,
+    int             numentries,
+    size_t          pressureBytes)
+{
+    size_t    workingCount = pressureBytes / sizeof (uint32_t);
+    uint32_t* working      = new uint32_t[workingCount + 1];
+    memset (working, 0, (workingCount + 1) * sizeof (uint32_t));
+
+    auto table = [] (float* f, const uint16_t* h, int n) {
+        for (int i = 0; i < n; ++i)
+            f[i] = imath_half_to_float_table[h[i]].f;
+    };
+
+    auto arithmetic = [] (float* f, const uint16_t* h, int n) {
+        for (int i = 0; i < n; ++i)
+            f[i] = imath_half_to_float_no_table (h[i]);
+    };
+
+    auto bulk = [] (float* f, const uint16_t* h, int n) {
+        imath_half_to_float_array (h, f, (size_t) n);
+    };
+
+    fprintf (
+        stderr,
+        "half -> float paths, %s, ns/value (cache pressure: %zu KB between "
+        "batches of 4096)\n",
+        data,
+        pressureBytes / 1024);
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        size_t      wc    = pass ? workingCount : 0;
+        const char* label = pass ? "pressure" : "warm";
+
+        fprintf (
+            stderr,
+            "  %-8s table: %6.3f  arithmetic: %6.3f\n",
+            label,
+            time_half_to_float (table, floats, halfs, numentries, working, wc),
+            time_half_to_float (
+                arithmetic, floats, halfs, numentries, working, wc));
+
+        imath_half_conversion_impl_t best = imath_half_conversion_impl ();
+        for (int impl = IMATH_HALF_CONVERSION_SCALAR;
+             impl <= IMATH_HALF_CONVERSION_AVX512;
+             ++impl)
+        {
+            if (!imath_half_set_conversion_impl (
+                    (imath_half_conversion_impl_t) impl))
+                continue;
+
+            fprintf (
+                stderr,
+                "  %-8s bulk %-6s: %6.3f\n",
+                label,
+                conversion_impl_names[impl],
+                time_half_to_float (
+                    bulk, floats, halfs, numentries, working, wc));
+        }
+        imath_half_set_conversion_impl (best);
+    }
+
+    delete[] working;
+}
+
 int
 main (int argc, char* argv[])
 {
@@ -386,6 +506,14 @@ main (int argc, char* argv[])
                 floats[i] = imath_half_to_float (halfs[i]);
             }
             perf_test_half_to_float (floats, halfs, numentries);
+            perf_test_half_to_float_paths (
+                "all bit patterns", floats, halfs, numentries, 4 << 20);
+
+            // image-like data: finite values only
+            for (int i = 0; i < numentries; ++i)
+                halfs[i] = imath_float_to_half (float (r.nextf (-1, 1)));
+            perf_test_half_to_float_paths (
+                "finite values", floats, halfs, numentries, 4 << 20);
 
             // test float -> half with real-world values
             for (int i = 0; i < numentries; ++i)
@@ -11,8 +11,10 @@
 #include "testBitPatterns.h"
 #include "testBox.h"
 #include "testBoxAlgo.h"
+#include "testBVH.h"
 #include "testClassification.h"
 #include "testColor.h"
+#include "testDualQuat.h"
 #include "testError.h"
 #include "testExtractEuler.h"
 #include "testExtractSHRT.h"
@@ -20,6 +22,8 @@
 #include "testFrustumTest.h"
 #include "testFun.h"
 #include "testFunction.h"
+#include "testHalfArray.h"
+#include "testHalfCurve.h"
 #include "testInterop.h"
 #include "testInterval.h"
 #include "testInvert.h"
@@ -38,7 +42,9 @@
 #include "testSize.h"
 #include "testTinySVD.h"
 #include "testToFloat.h"
+#include "testTrig.h"
 #include "testVec.h"
+#include "testVecArray.h"
 
 #include <iostream>
 #include <string.h>
@@ -52,6 +58,7 @@ main (int argc, char* argv[])
     // NB: If you add a test here, make sure to enumerate it in the
     // CMakeLists.txt so it runs as part of the test suite
     TEST (testToFloat);
+    TEST (testHalfArray);
     TEST (testSize);
     TEST (testArithmetic);
     TEST (testNormalizedConversionError);
@@ -62,13 +69,16 @@ main (int argc, char* argv[])
     TEST (testLimits);
     TEST (testHalfLimits);
     TEST (testFunction);
+    TEST (testHalfCurve);
     TEST (testVec);
+    TEST (testVecArray);
     TEST (testColor);
     TEST (testShear);
     TEST (testMatrix);
     TEST (testMiscMatrixAlgo);
     TEST (testRoots);
     TEST (testFun);
+    TEST (testTrig);
     TEST (testInvert);
     TEST (testInterval);
     TEST (testFrustum);
@@ -78,9 +88,11 @@ main (int argc, char* argv[])
     TEST (testQuat);
     TEST (testQuatSetRotation);
     TEST (testQuatSlerp);
+    TEST (testDualQuat);
     TEST (testLineAlgo);
     TEST (testBoxAlgo);
     TEST (testBox);
+    TEST (testBVH);
     TEST (testProcrustes);
     TEST (testTinySVD);
     TEST (testJacobiEigenSolver);
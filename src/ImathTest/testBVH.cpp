@@ -0,0 +1,361 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+#ifdef NDEBUG
+#    undef NDEBUG
+#endif
+
+#include "testBVH.h"
+#include <ImathBVH.h>
+#include <ImathBoxAlgo.h>
+#include <ImathRandom.h>
+#include <algorithm>
+#include <assert.h>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+using namespace IMATH_INTERNAL_NAMESPACE;
+
+namespace
+{
+
+template <class T>
+Vec3<T>
+randomPoint (Rand48& random, T lo, T hi)
+{
+    return Vec3<T> (
+        T (random.nextf (lo, hi)),
+        T (random.nextf (lo, hi)),
+        T (random.nextf (lo, hi)));
+}
+
+//
+// Boxes of widely varying size, with some empty ones and some exact
+// duplicates, so that the build sees coincident centroids.
+//
+
+template <class T>
+vector<Box<Vec3<T>>>
+randomBoxes (Rand48& random, size_t n)
+{
+    vector<Box<Vec3<T>>> boxes (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (i % 53 == 7) continue;
+
+        if (i % 41 == 3 && i > 10)
+        {
+            boxes[i] = boxes[i - 10];
+            continue;
+        }
+
+        Vec3<T> c = randomPoint<T> (random, -100, 100);
+        Vec3<T> e = randomPoint<T> (random, 0, i % 5 ? 2 : 20);
+        boxes[i]  = Box<Vec3<T>> (c - e, c + e);
+    }
+
+    return boxes;
+}
+
+//
+// Check the structure of the tree: every node's bounds enclose its
+// children, leaves respect the size limit, and each non-empty box is in
+// exactly one leaf.
+//
+
+template <class T>
+void
+validate (
+    const BVH<T>& bvh, const vector<Box<Vec3<T>>>& boxes, int maxLeafSize)
+{
+    typedef typename BVH<T>::Node Node;
+
+    size_t numNonEmpty = 0;
+    for (size_t i = 0; i < boxes.size (); ++i)
+        if (!boxes[i].isEmpty ()) ++numNonEmpty;
+
+    assert (bvh.numPrimitives () == boxes.size ());
+
+    if (numNonEmpty == 0)
+    {
+        assert (bvh.numNodes () == 0);
+        assert (bvh.bounds ().isEmpty ());
+        return;
+    }
+
+    vector<int> seen (boxes.size (), 0);
+    size_t      numLeaves = 0;
+
+    for (size_t n = 0; n < bvh.numNodes (); ++n)
+    {
+        const Node& node = bvh.nodes ()[n];
+
+        if (node.isLeaf ())
+        {
+            assert (node.count <= uint32_t (maxLeafSize));
+            ++numLeaves;
+
+            for (uint32_t k = node.index; k < node.index + node.count; ++k)
+            {
+                uint32_t i = bvh.primitiveIndices ()[k];
+                assert (i < boxes.size ());
+                assert (!boxes[i].isEmpty ());
+                assert (node.bounds.intersects (boxes[i].min));
+                assert (node.bounds.intersects (boxes[i].max));
+                ++seen[i];
+            }
+        }
+        else
+        {
+            assert (node.index > n + 1 && node.index < bvh.numNodes ());
+
+            const Node& c0 = bvh.nodes ()[n + 1];
+            const Node& c1 = bvh.nodes ()[node.index];
+            Box<Vec3<T>> u = c0.bounds;
+            u.extendBy (c1.bounds);
+            assert (u == node.bounds);
+        }
+    }
+
+    assert (bvh.numNodes () == 2 * numLeaves - 1);
+
+    for (size_t i = 0; i < boxes.size (); ++i)
+        assert (seen[i] == (boxes[i].isEmpty () ? 0 : 1));
+}
+
+template <class T>
+void
+testQueries (const BVH<T>& bvh, const vector<Box<Vec3<T>>>& boxes)
+{
+    Rand48  random (19);
+    const T e = std::numeric_limits<T>::epsilon () * 1000;
+
+    for (int r = 0; r < 300; ++r)
+    {
+        //
+        // Rays from outside and from inside the scene.
+        //
+
+        T        range = r % 2 ? 100 : 300;
+        Vec3<T>  from  = randomPoint<T> (random, -range, range);
+        Vec3<T>  to    = randomPoint<T> (random, -50, 50);
+        Line3<T> ray (from, to);
+
+        vector<size_t> expected;
+        T              nearestDist = std::numeric_limits<T>::max ();
+
+        for (size_t i = 0; i < boxes.size (); ++i)
+        {
+            Vec3<T> ip (0);
+            if (!intersects (boxes[i], ray, ip)) continue;
+
+            expected.push_back (i);
+            nearestDist = min (nearestDist, (ip - ray.pos).length ());
+        }
+
+        vector<size_t> hits;
+        assert (bvh.intersectAll (ray, hits) == expected.size ());
+        sort (hits.begin (), hits.end ());
+        assert (hits == expected);
+
+        T      t;
+        size_t hit = bvh.intersect (ray, t);
+
+        if (expected.empty ())
+        {
+            assert (hit == BVH<T>::npos);
+            continue;
+        }
+
+        assert (binary_search (expected.begin (), expected.end (), hit));
+        assert (equalWithAbsError (t, nearestDist, e * (1 + nearestDist)));
+
+        //
+        // Nothing is hit if the ray stops short of the first box.
+        //
+
+        if (t > 1)
+        {
+            T tMax = t * T (0.99);
+            assert (bvh.intersect (ray, t, tMax) == BVH<T>::npos);
+
+            hits.clear ();
+            bvh.intersectAll (ray, hits, tMax);
+            assert (hits.empty ());
+        }
+    }
+
+    for (int q = 0; q < 300; ++q)
+    {
+        Vec3<T>      c = randomPoint<T> (random, -120, 120);
+        Vec3<T>      s = randomPoint<T> (random, 0, q % 3 ? 5 : 30);
+        Box<Vec3<T>> query (c - s, c + s);
+
+        vector<size_t> expected;
+        for (size_t i = 0; i < boxes.size (); ++i)
+            if (boxes[i].intersects (query)) expected.push_back (i);
+
+        vector<size_t> found (1, BVH<T>::npos);
+        assert (bvh.overlapping (query, found) == expected.size ());
+        assert (found[0] == BVH<T>::npos);
+        found.erase (found.begin ());
+        sort (found.begin (), found.end ());
+        assert (found == expected);
+
+        T minDist = std::numeric_limits<T>::max ();
+        for (size_t i = 0; i < boxes.size (); ++i)
+        {
+            if (boxes[i].isEmpty ()) continue;
+            T d     = (closestPointInBox (c, boxes[i]) - c).length ();
+            minDist = min (minDist, d);
+        }
+
+        T      distance = -1;
+        size_t index    = bvh.nearest (c, distance);
+        assert (index != BVH<T>::npos);
+        assert (equalWithAbsError (distance, minDist, e * (1 + minDist)));
+
+        if (minDist == 0)
+            assert (boxes[index].intersects (c));
+        else
+        {
+            T d = (closestPointInBox (c, boxes[index]) - c).length ();
+            assert (equalWithAbsError (d, minDist, e * (1 + minDist)));
+        }
+    }
+}
+
+template <class T>
+void
+testEmpty ()
+{
+    BVH<T>         bvh;
+    T              t = 7;
+    Line3<T>       ray (Vec3<T> (0), Vec3<T> (1, 0, 0));
+    Box<Vec3<T>>   unit (Vec3<T> (-1), Vec3<T> (1));
+    vector<size_t> result;
+
+    assert (bvh.numNodes () == 0 && bvh.numPrimitives () == 0);
+    assert (bvh.bounds ().isEmpty ());
+    assert (bvh.intersect (ray, t) == BVH<T>::npos && t == 7);
+    assert (bvh.intersectAll (ray, result) == 0);
+    assert (bvh.overlapping (unit, result) == 0);
+    assert (bvh.nearest (Vec3<T> (0), t) == BVH<T>::npos);
+    assert (result.empty ());
+
+    vector<Box<Vec3<T>>> empties (10);
+    bvh.build (empties.data (), empties.size ());
+    validate (bvh, empties, 4);
+    assert (bvh.intersect (ray, t) == BVH<T>::npos);
+
+    //
+    // A single box, hit from outside and from inside.
+    //
+
+    Box<Vec3<T>> box (Vec3<T> (2, -1, -1), Vec3<T> (4, 1, 1));
+    bvh.build (&box, 1);
+    validate (bvh, vector<Box<Vec3<T>>> (1, box), 4);
+    assert (bvh.bounds () == box);
+    assert (bvh.intersect (ray, t) == 0 && t == 2);
+
+    Line3<T> inside (Vec3<T> (3, 0, 0), Vec3<T> (3, 1, 0));
+    assert (bvh.intersect (inside, t) == 0 && t == 0);
+
+    Line3<T> away (Vec3<T> (0), Vec3<T> (-1, 0, 0));
+    assert (bvh.intersect (away, t) == BVH<T>::npos);
+
+    assert (bvh.nearest (Vec3<T> (0, 0, 3), t) == 0);
+    assert (equalWithAbsError (t, T (std::sqrt (T (8))), T (1e-6)));
+
+    bvh.clear ();
+    assert (bvh.numNodes () == 0 && bvh.numPrimitives () == 0);
+
+    //
+    // Identical boxes: all are reported and ties go to the lowest index.
+    //
+
+    vector<Box<Vec3<T>>> same (37, box);
+    bvh.build (same.data (), same.size (), 2);
+    validate (bvh, same, 2);
+    assert (bvh.intersect (ray, t) == 0);
+    assert (bvh.nearest (Vec3<T> (0), t) == 0);
+    result.clear ();
+    assert (bvh.intersectAll (ray, result) == same.size ());
+}
+
+//
+// An executor that runs the tasks in reverse order, to check that the
+// tree does not depend on the order in which the subtrees are built.
+//
+
+void
+reverseExecutor (size_t n, const std::function<void (size_t)>& task)
+{
+    for (size_t i = n; i > 0; --i)
+        task (i - 1);
+}
+
+template <class T>
+void
+testBVHType (const char* type)
+{
+    cout << "  BVH<" << type << ">" << endl;
+
+    testEmpty<T> ();
+
+    Rand48 random (7);
+
+    for (int maxLeafSize: {1, 4, 8})
+    {
+        vector<Box<Vec3<T>>> boxes = randomBoxes<T> (random, 2000);
+        BVH<T>               bvh (boxes.data (), boxes.size (), maxLeafSize);
+
+        validate (bvh, boxes, maxLeafSize);
+        testQueries (bvh, boxes);
+    }
+
+    //
+    // Building through an executor gives the same tree.
+    //
+
+    vector<Box<Vec3<T>>> boxes = randomBoxes<T> (random, 50000);
+    BVH<T>               serial (boxes.data (), boxes.size ());
+    BVH<T> parallel (boxes.data (), boxes.size (), 4, reverseExecutor);
+
+    validate (parallel, boxes, 4);
+    assert (serial.numNodes () == parallel.numNodes ());
+
+    for (size_t n = 0; n < serial.numNodes (); ++n)
+    {
+        assert (serial.nodes ()[n].bounds == parallel.nodes ()[n].bounds);
+        assert (serial.nodes ()[n].index == parallel.nodes ()[n].index);
+        assert (serial.nodes ()[n].count == parallel.nodes ()[n].count);
+    }
+
+    size_t numNonEmpty = 0;
+    for (size_t i = 0; i < boxes.size (); ++i)
+        if (!boxes[i].isEmpty ()) ++numNonEmpty;
+
+    assert (equal (
+        serial.primitiveIndices (),
+        serial.primitiveIndices () + numNonEmpty,
+        parallel.primitiveIndices ()));
+}
+
+} // namespace
+
+void
+testBVH ()
+{
+    cout << "Testing BVH" << endl;
+
+    testBVHType<float> ("float");
+    testBVHType<double> ("double");
+
+    cout << "ok\n" << endl;
+}
@@ -12,7 +12,10 @@
 #include <ImathRandom.h>
 #include <algorithm>
 #include <assert.h>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 using namespace std;
 using namespace IMATH_INTERNAL_NAMESPACE;
@@ -904,6 +907,292 @@ pointInAndOnBox ()
     assert (closestPointInBox (V3f (3, 3, 4.5), box) == V3f (3, 3, 4.5));
 }
 
+template <class T>
+Vec3<T>
+randomPoint (Rand48& random, T lo, T hi)
+{
+    return Vec3<T> (
+        T (random.nextf (lo, hi)),
+        T (random.nextf (lo, hi)),
+        T (random.nextf (lo, hi)));
+}
+
+//
+// Compare the result of one lane of a packet test with the scalar
+// intersects().
+//
+
+template <class T>
+void
+checkPacketLane (
+    const Box<Vec3<T>>& box,
+    const Line3<T>&     ray,
+    bool                hit,
+    T                   tEntry,
+    T                   tMax)
+{
+    Vec3<T> ip (0);
+    bool    expected = intersects (box, ray, ip);
+    T       t        = 0;
+
+    if (expected)
+    {
+        t        = (ip - ray.pos).length ();
+        expected = t <= tMax;
+    }
+
+    assert (hit == expected);
+
+    if (hit)
+    {
+        T e = std::numeric_limits<T>::epsilon () * 100;
+        assert (equalWithAbsError (tEntry, t, e * (1 + t)));
+    }
+    else
+        assert (tEntry == std::numeric_limits<T>::infinity ());
+}
+
+template <class T, int N>
+void
+rayPacketsType (Rand48& random)
+{
+    for (int n = 0; n < 500; ++n)
+    {
+        //
+        // One box and N rays aimed near it from outside and inside,
+        // some limited in length.
+        //
+
+        Vec3<T>      c = randomPoint<T> (random, -10, 10);
+        Vec3<T>      e = randomPoint<T> (random, T (0.1), 5);
+        Box<Vec3<T>> box (c - e, c + e);
+
+        Line3<T>        rays[N];
+        RayPacket<T, N> packet;
+
+        for (int i = 0; i < N; ++i)
+        {
+            T range = i % 3 ? 20 : 3;
+            rays[i] = Line3<T> (
+                c + randomPoint<T> (random, -range, range),
+                c + randomPoint<T> (random, -6, 6));
+            packet.set (i, rays[i]);
+        }
+
+        T        tMax = n % 2 ? std::numeric_limits<T>::max () : T (15);
+        T        tEntry[N];
+        uint32_t mask = intersects (box, packet, tEntry, tMax);
+
+        for (int i = 0; i < N; ++i)
+            checkPacketLane (box, rays[i], (mask >> i) & 1, tEntry[i], tMax);
+
+        assert (intersects (Box<Vec3<T>> (), packet, tEntry) == 0);
+
+        for (int i = 0; i < N; ++i)
+            assert (tEntry[i] == std::numeric_limits<T>::infinity ());
+
+        //
+        // One ray and N boxes around it, some of them empty.
+        //
+
+        Line3<T>        ray (randomPoint<T> (random, -20, 20), c);
+        Box<Vec3<T>>    boxes[N];
+        BoxPacket<T, N> boxPacket;
+
+        for (int i = 0; i < N; ++i)
+        {
+            if (i % 5 != 4)
+            {
+                Vec3<T> bc = c + randomPoint<T> (random, -8, 8);
+                Vec3<T> be = randomPoint<T> (random, T (0.1), 4);
+                boxes[i]   = Box<Vec3<T>> (bc - be, bc + be);
+            }
+
+            boxPacket.set (i, boxes[i]);
+        }
+
+        mask = intersects (boxPacket, ray, tEntry, tMax);
+
+        for (int i = 0; i < N; ++i)
+            checkPacketLane (boxes[i], ray, (mask >> i) & 1, tEntry[i], tMax);
+    }
+}
+
+void
+rayPackets ()
+{
+    cout << "  ray packets" << endl;
+
+    //
+    // Axis-aligned rays, whose reciprocal directions are infinite,
+    // starting outside, inside and on the face of the box.
+    //
+
+    Box3f       box (V3f (1, 2, 3), V3f (5, 4, 6));
+    RayPacket4f rays;
+    float       tEntry[4];
+
+    rays.set (0, Line3f (V3f (0, 3, 4), V3f (1, 3, 4)));
+    rays.set (1, Line3f (V3f (2, 3, 4), V3f (2, 3, 5)));
+    rays.set (2, Line3f (V3f (0, 5, 4), V3f (1, 5, 4)));
+    rays.set (3, Line3f (V3f (3, 3, 0), V3f (3, 3, -1)));
+
+    assert (intersects (box, rays, tEntry) == 0x3);
+    assert (tEntry[0] == 1 && tEntry[1] == 0);
+    assert (tEntry[2] == std::numeric_limits<float>::infinity ());
+
+    assert (intersects (box, rays, tEntry, 0.5f) == 0x2);
+
+    BoxPacket4f boxes;
+    boxes.set (0, box);
+    boxes.set (1, Box3f (V3f (7, 2, 3), V3f (9, 4, 6)));
+    boxes.set (2, Box3f ());
+    boxes.set (3, Box3f (V3f (-3, 2, 3), V3f (-1, 4, 6)));
+
+    Line3f ray (V3f (0, 3, 4), V3f (1, 3, 4));
+    assert (intersects (boxes, ray, tEntry) == 0x3);
+    assert (tEntry[0] == 1 && tEntry[1] == 7);
+
+    Rand48 random (17);
+    rayPacketsType<float, 4> (random);
+    rayPacketsType<float, 8> (random);
+    rayPacketsType<float, 16> (random);
+    rayPacketsType<double, 4> (random);
+}
+
+template <class T>
+Matrix44<T>
+randomMatrix (Rand48& random, bool affine)
+{
+    Matrix44<T> m;
+
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            m[i][j] = T (random.nextf (-2, 2));
+
+    if (affine)
+    {
+        m[0][3] = m[1][3] = m[2][3] = 0;
+        m[3][3]                     = 1;
+    }
+
+    return m;
+}
+
+//
+// An executor that runs the tasks in reverse order.
+//
+
+void
+reverseExecutor (size_t n, const std::function<void (size_t)>& task)
+{
+    for (size_t i = n; i > 0; --i)
+        task (i - 1);
+}
+
+template <class T>
+void
+boxArrayTransformType (Rand48& random)
+{
+    //
+    // Enough boxes for several tasks and a partial last block, some of
+    // them empty or infinite, and some projective matrices.
+    //
+
+    const size_t n = 9000 + 17;
+
+    vector<Box<Vec3<T>>> boxes (n), result (n), expected (n);
+    vector<Matrix44<T>>  m (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (i % 97 == 5)
+            boxes[i].makeInfinite ();
+        else if (i % 89 != 3)
+        {
+            Vec3<T> c = randomPoint<T> (random, -100, 100);
+            Vec3<T> e = randomPoint<T> (random, 0, 10);
+            boxes[i]  = Box<Vec3<T>> (c - e, c + e);
+        }
+
+        m[i] = randomMatrix<T> (random, i % 13 != 0);
+    }
+
+    //
+    // The array functions match the single-box functions exactly.
+    //
+
+    for (size_t i = 0; i < n; ++i)
+        expected[i] = transform (boxes[i], m[i]);
+
+    transform (boxes.data (), m.data (), result.data (), n);
+    assert (result == expected);
+
+    result.assign (n, Box<Vec3<T>> ());
+    transform (boxes.data (), m.data (), result.data (), n, reverseExecutor);
+    assert (result == expected);
+
+    result = boxes;
+    transform (result.data (), m.data (), result.data (), n);
+    assert (result == expected);
+
+    for (size_t i = 0; i < n; ++i)
+        m[i] = randomMatrix<T> (random, true);
+
+    for (size_t i = 0; i < n; ++i)
+        expected[i] = affineTransform (boxes[i], m[i]);
+
+    affineTransform (boxes.data (), m.data (), result.data (), n);
+    assert (result == expected);
+
+    result.assign (n, Box<Vec3<T>> ());
+    affineTransform (
+        boxes.data (), m.data (), result.data (), n, reverseExecutor);
+    assert (result == expected);
+
+    //
+    // One matrix for all boxes, affine and projective.
+    //
+
+    for (bool affine: {true, false})
+    {
+        Matrix44<T> mb = randomMatrix<T> (random, affine);
+
+        for (size_t i = 0; i < n; ++i)
+            expected[i] = transform (boxes[i], mb);
+
+        transform (boxes.data (), mb, result.data (), n);
+        assert (result == expected);
+
+        result.assign (n, Box<Vec3<T>> ());
+        transform (boxes.data (), mb, result.data (), n, reverseExecutor);
+        assert (result == expected);
+
+        if (!affine) continue;
+
+        affineTransform (boxes.data (), mb, result.data (), n);
+        assert (result == expected);
+
+        result = boxes;
+        affineTransform (
+            result.data (), mb, result.data (), n, reverseExecutor);
+        assert (result == expected);
+    }
+
+    transform (boxes.data (), m.data (), result.data (), 0);
+    transform (boxes.data (), m.data (), result.data (), 0, reverseExecutor);
+}
+
+void
+boxArrayTransform ()
+{
+    cout << "  transform arrays of boxes" << endl;
+
+    Rand48 random (23);
+    boxArrayTransformType<float> (random);
+    boxArrayTransformType<double> (random);
+}
+
 } // namespace
 
 void
@@ -917,6 +1206,8 @@ testBoxAlgo ()
     rayBoxIntersection2 ();
     boxMatrixTransform ();
     pointInAndOnBox ();
+    rayPackets ();
+    boxArrayTransform ();
 
     cout << "ok\n" << endl;
 }
@@ -11,13 +11,311 @@
 #include <ImathColor.h>
 #include <ImathColorAlgo.h>
 #include <ImathMath.h>
+#include <ImathRandom.h>
 #include <assert.h>
+#include <functional>
 #include <iostream>
+#include <vector>
 
 // Include ImathForward *after* other headers to validate forward declarations
 #include <ImathForward.h>
 
 using namespace std;
+using namespace IMATH_INTERNAL_NAMESPACE;
+
+namespace
+{
+
+//
+// An executor that runs the tasks in reverse order.
+//
+
+void
+reverseExecutor (size_t n, const std::function<void (size_t)>& task)
+{
+    for (size_t i = n; i > 0; --i)
+        task (i - 1);
+}
+
+bool
+equalWithAbsError (const C4f& a, const C4f& b, float e)
+{
+    return std::fabs (a.r - b.r) <= e && std::fabs (a.g - b.g) <= e &&
+           std::fabs (a.b - b.b) <= e && a.a == b.a;
+}
+
+//
+// Hues are compared modulo 1.
+//
+
+bool
+equalHsv (const C4f& a, const C4f& b, float e)
+{
+    float dh = std::fabs (a.r - b.r);
+
+    return std::min (dh, 1 - dh) <= e && std::fabs (a.g - b.g) <= e &&
+           std::fabs (a.b - b.b) <= e && a.a == b.a;
+}
+
+C3f
+rgb (const C4f& c)
+{
+    return C3f (c.r, c.g, c.b);
+}
+
+//
+// The batch conversions agree with the single-color conversions, and
+// give the same results in place, with an executor, and for half
+// colors as for float colors rounded to half.
+//
+
+void
+testBatchHsv ()
+{
+    cout << "batch hsv2rgb and rgb2hsv" << endl;
+
+    const size_t n = 40000;
+    const float  e = 1e-5f;
+    Rand48       random (7);
+    vector<C4f>  hsv (n), rgba (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        hsv[i] = C4f (
+            float (random.nextf ()),
+            float (random.nextf ()),
+            float (random.nextf ()),
+            float (random.nextf ()));
+
+        rgba[i] = C4f (
+            float (random.nextf ()),
+            float (random.nextf ()),
+            float (random.nextf ()),
+            float (random.nextf ()));
+
+        //
+        // Sextant boundaries, unsaturated and black colors, and
+        // colors with two equal channels.
+        //
+
+        if (i % 7 == 0) hsv[i].r = float (i / 7 % 7) / 6;
+        if (i % 11 == 0) hsv[i].g = 0;
+        if (i % 13 == 0) hsv[i].b = 0;
+        if (i % 5 == 0) rgba[i].g = rgba[i].r;
+        if (i % 9 == 0) rgba[i].b = rgba[i].g;
+        if (i % 17 == 0) rgba[i] = C4f (0, 0, 0, rgba[i].a);
+    }
+
+    vector<C4f> a (n), b (n);
+    vector<C3f> c (n), d (n);
+
+    hsv2rgb (hsv.data (), a.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        c[i] = rgb (hsv[i]);
+        assert (equalWithAbsError (a[i], hsv2rgb (hsv[i]), e));
+    }
+
+    hsv2rgb (c.data (), d.data (), n);
+    hsv2rgb (c.data (), c.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (d[i] == rgb (a[i]) && c[i] == d[i]);
+
+    hsv2rgb (hsv.data (), b.data (), n, reverseExecutor);
+    assert (b == a);
+
+    rgb2hsv (rgba.data (), a.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        c[i] = rgb (rgba[i]);
+        assert (equalHsv (a[i], rgb2hsv (rgba[i]), e));
+    }
+
+    rgb2hsv (c.data (), d.data (), n);
+    rgb2hsv (c.data (), c.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (d[i] == rgb (a[i]) && c[i] == d[i]);
+
+    b = rgba;
+    rgb2hsv (b.data (), b.data (), n, reverseExecutor);
+    assert (b == a);
+
+    //
+    // Half colors
+    //
+
+    vector<C4h> h (n), k (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        h[i] = C4h (hsv[i].r, hsv[i].g, hsv[i].b, hsv[i].a);
+        a[i] = C4f (h[i].r, h[i].g, h[i].b, h[i].a);
+    }
+
+    hsv2rgb (a.data (), a.data (), n);
+    hsv2rgb (h.data (), k.data (), n);
+    hsv2rgb (h.data (), h.data (), n, reverseExecutor);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (
+            k[i] == C4h (a[i].r, a[i].g, a[i].b, a[i].a) && h[i] == k[i]);
+
+    rgb2hsv (h.data (), k.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+        a[i] = C4f (h[i].r, h[i].g, h[i].b, h[i].a);
+
+    rgb2hsv (a.data (), a.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (k[i] == C4h (a[i].r, a[i].g, a[i].b, a[i].a));
+}
+
+//
+// The packed value of a color channel, clamped and rounded, or encoded
+// with the sRGB transfer function, in units of the quantization step.
+//
+
+double
+packedChannel (float c, bool srgb)
+{
+    double v = c < 0 ? 0 : (c > 1 ? 1 : c);
+
+    if (srgb)
+        v = v <= 0.0031308 ? 12.92 * v : 1.055 * std::pow (v, 1 / 2.4) - 0.055;
+
+    return v * 255;
+}
+
+unsigned int
+channel (PackedColor p, int shift)
+{
+    return (p >> shift) & 0xFF;
+}
+
+bool
+packedNear (PackedColor p, int shift, float c, bool srgb, double e)
+{
+    return std::fabs (channel (p, shift) - packedChannel (c, srgb)) <= e;
+}
+
+void
+testBatchPacked ()
+{
+    cout << "batch rgb2packed and packed2rgb" << endl;
+
+    const size_t n = 1000;
+    Rand48       random (11);
+    vector<C4f>  c (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        c[i] = C4f (
+            float (random.nextf (-0.1, 1.1)),
+            float (random.nextf ()),
+            float (random.nextf (0, 0.01)),
+            float (random.nextf ()));
+    }
+
+    vector<PackedColor> p (n), q (n);
+    vector<C4f>         d (n);
+
+    for (int srgb = 0; srgb < 2; ++srgb)
+    {
+        int flags = srgb ? PACKED_SRGB : PACKED_RGBA;
+
+        rgb2packed (c.data (), p.data (), n, flags);
+        rgb2packed (c.data (), q.data (), n, flags | PACKED_BGRA);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            assert (packedNear (p[i], 0, c[i].r, srgb, 0.6));
+            assert (packedNear (p[i], 8, c[i].g, srgb, 0.6));
+            assert (packedNear (p[i], 16, c[i].b, srgb, 0.6));
+            assert (packedNear (p[i], 24, c[i].a, false, 0.5));
+
+            assert (
+                channel (q[i], 0) == channel (p[i], 16) &&
+                channel (q[i], 8) == channel (p[i], 8) &&
+                channel (q[i], 16) == channel (p[i], 0) &&
+                channel (q[i], 24) == channel (p[i], 24));
+        }
+
+        //
+        // Unpacking and packing again gives the original bytes.
+        //
+
+        packed2rgb (q.data (), d.data (), n, flags | PACKED_BGRA);
+        rgb2packed (d.data (), q.data (), n, flags);
+        assert (q == p);
+
+        if (!srgb)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                C4f e;
+                packed2rgb (p[i], e);
+                assert (d[i] == e);
+            }
+        }
+    }
+
+    //
+    // Dithering a constant color preserves its average value over each
+    // 4x4 tile to within a 32nd of a quantization step.
+    //
+
+    for (int k = 0; k < 50; ++k)
+    {
+        float       v = float (random.nextf ());
+        vector<C4f> row (200, C4f (v, v, v, 1));
+        double      sum = 0;
+
+        for (int y = 2; y < 6; ++y)
+        {
+            rgb2packed (row.data (), p.data (), 200, PACKED_DITHER, 3, y);
+
+            for (int x = 1; x < 5; ++x)
+            {
+                sum += channel (p[x], 0);
+                assert (p[x] == p[x + 4] && p[x] == p[x + 160]);
+            }
+        }
+
+        assert (std::fabs (sum / 16 - v * 255.0) <= 1 / 32.0 + 1e-3);
+    }
+
+    //
+    // Half colors give the same results as float colors of the same
+    // values.
+    //
+
+    vector<C4h> h (n), g (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        h[i] = C4h (c[i].r, c[i].g, c[i].b, c[i].a);
+        c[i] = C4f (h[i].r, h[i].g, h[i].b, h[i].a);
+    }
+
+    int flags = PACKED_SRGB | PACKED_DITHER | PACKED_BGRA;
+
+    rgb2packed (c.data (), p.data (), n, flags, 5, 7);
+    rgb2packed (h.data (), q.data (), n, flags, 5, 7);
+    assert (q == p);
+
+    packed2rgb (p.data (), d.data (), n, flags);
+    packed2rgb (p.data (), g.data (), n, flags);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (g[i] == C4h (d[i].r, d[i].g, d[i].b, d[i].a));
+}
+
+} // namespace
 
 void
 testColor ()
@@ -179,5 +477,8 @@ testColor ()
         std::fabs ((X.b / Y.b) - tmp.b) <= 1e-5f &&
         std::fabs ((X.a / Y.a) - tmp.a) <= 1e-5f);
 
+    testBatchHsv ();
+    testBatchPacked ();
+
     cout << "ok\n" << endl;
 }
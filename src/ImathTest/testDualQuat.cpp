@@ -0,0 +1,330 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+#ifdef NDEBUG
+#    undef NDEBUG
+#endif
+
+#include "testDualQuat.h"
+#include <ImathDualQuat.h>
+#include <ImathRandom.h>
+#include <assert.h>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+// Include ImathForward *after* other headers to validate forward declarations
+#include <ImathForward.h>
+
+using namespace std;
+using namespace IMATH_INTERNAL_NAMESPACE;
+
+namespace
+{
+
+template <class T>
+Vec3<T>
+randomVec (Rand48& random, T lo, T hi)
+{
+    return Vec3<T> (
+        T (random.nextf (lo, hi)),
+        T (random.nextf (lo, hi)),
+        T (random.nextf (lo, hi)));
+}
+
+template <class T>
+Quat<T>
+randomQuat (Rand48& random)
+{
+    Quat<T> q (
+        T (random.nextf (-1, 1)),
+        T (random.nextf (-1, 1)),
+        T (random.nextf (-1, 1)),
+        T (random.nextf (-1, 1)));
+    return q.normalize ();
+}
+
+template <class T>
+DualQuat<T>
+randomDualQuat (Rand48& random)
+{
+    return DualQuat<T> (randomQuat<T> (random), randomVec<T> (random, -10, 10));
+}
+
+template <class T>
+bool
+equalVec (const Vec3<T>& a, const Vec3<T>& b, T e)
+{
+    return a.equalWithAbsError (b, e * (1 + b.length ()));
+}
+
+template <class T>
+bool
+equalMatrix (const Matrix44<T>& a, const Matrix44<T>& b, T e)
+{
+    return a.equalWithAbsError (b, e * 10);
+}
+
+template <class T>
+void
+testDualQuatType (const char* type)
+{
+    cout << "  DualQuat<" << type << ">" << endl;
+
+    const T e = 100 * std::numeric_limits<T>::epsilon ();
+    Rand48  random (5);
+
+    assert (sizeof (DualQuat<T>) == 8 * sizeof (T));
+
+    //
+    // Identity and construction from a rotation and translation.
+    //
+
+    {
+        DualQuat<T> dq;
+        assert (dq == DualQuat<T>::identity ());
+        assert (dq.r == Quat<T> () && dq.d == Quat<T> (0, 0, 0, 0));
+        assert (dq.toMatrix44 () == Matrix44<T> ());
+        assert (dq.transformPoint (Vec3<T> (1, 2, 3)) == Vec3<T> (1, 2, 3));
+
+        DualQuat<T> t (Quat<T> (), Vec3<T> (1, 2, 3));
+        assert (t.translation () == Vec3<T> (1, 2, 3));
+        assert (t.transformPoint (Vec3<T> (1)) == Vec3<T> (2, 3, 4));
+        assert (t.transformDirection (Vec3<T> (1)) == Vec3<T> (1));
+        assert (t != dq);
+
+        DualQuat<float> f (t);
+        assert (DualQuat<T> (f) == t);
+    }
+
+    for (int i = 0; i < 500; ++i)
+    {
+        Quat<T>     q  = randomQuat<T> (random);
+        Vec3<T>     t  = randomVec<T> (random, -10, 10);
+        DualQuat<T> dq (q, t);
+
+        assert (dq.rotation () == q);
+        assert (equalVec (dq.translation (), t, e));
+
+        Matrix44<T> m = q.toMatrix44 () * Matrix44<T> ().setTranslation (t);
+        assert (equalMatrix (dq.toMatrix44 (), m, e));
+
+        //
+        // Points and directions are transformed like the matrix does,
+        // whether or not the dual quaternion is normalized.
+        //
+
+        Vec3<T> p = randomVec<T> (random, -10, 10);
+        Vec3<T> mp, mv;
+        m.multVecMatrix (p, mp);
+        m.multDirMatrix (p, mv);
+
+        assert (equalVec (dq.transformPoint (p), mp, e));
+        assert (equalVec (dq.transformDirection (p), mv, e));
+        assert (equalVec ((dq * T (3)).transformPoint (p), mp, e));
+        assert (equalVec ((T (-0.5) * dq).transformDirection (p), mv, e));
+
+        DualQuat<T> n = (dq * T (3)).normalize ();
+        assert (equalVec (n.translation (), t, e));
+        assert (equalVec ((dq * T (2)).normalized ().translation (), t, e));
+
+        //
+        // The product applies its right operand first.
+        //
+
+        DualQuat<T> dq2 = randomDualQuat<T> (random);
+        DualQuat<T> c   = dq2 * dq;
+        assert (equalMatrix (c.toMatrix44 (), m * dq2.toMatrix44 (), e));
+
+        DualQuat<T> c2 = dq2;
+        c2 *= dq;
+        assert (c2 == c);
+
+        assert (equalVec (
+            c.transformPoint (p), dq2.transformPoint (dq.transformPoint (p)),
+            e));
+
+        //
+        // inverse()
+        //
+
+        DualQuat<T> inv = dq.inverse ();
+        assert (equalVec (inv.transformPoint (mp), p, e));
+        assert (equalMatrix (
+            (inv * dq).toMatrix44 (), Matrix44<T> (), e));
+
+        DualQuat<T> inv2 = dq;
+        inv2.invert ();
+        assert (inv2 == inv);
+
+        //
+        // extractDualQuat() removes scale and shear.
+        //
+
+        Vec3<T>     s (
+            T (random.nextf (0.1, 10)),
+            T (random.nextf (0.1, 10)),
+            T (random.nextf (0.1, 10)));
+        Matrix44<T> sm;
+        sm.setScale (s);
+        sm.shear (Vec3<T> (0.5, 0, 0));
+
+        DualQuat<T> x = extractDualQuat (sm * m);
+        assert (equalVec (x.translation (), t, e));
+        assert (equalVec (x.transformDirection (p), mv, e));
+
+        assert (equalMatrix (extractDualQuat (m).toMatrix44 (), m, e));
+    }
+
+    //
+    // blend()
+    //
+
+    {
+        DualQuat<T> a = randomDualQuat<T> (random);
+        DualQuat<T> b = randomDualQuat<T> (random);
+        DualQuat<T> ab[] = {a, b};
+        DualQuat<T> aNegB[] = {a, -b};
+        T           w[]  = {0.25, 0.75};
+
+        DualQuat<T> x = blend (ab, w, 2);
+        DualQuat<T> y = blend (aNegB, w, 2);
+        assert (equalVec (x.translation (), y.translation (), e));
+        assert (equalVec (
+            x.transformPoint (Vec3<T> (1)), y.transformPoint (Vec3<T> (1)),
+            e));
+        assert (equalWithAbsError (x.r.length (), T (1), e));
+
+        T one[] = {2};
+        DualQuat<T> single = blend (&a, one, 1);
+        assert (equalVec (single.translation (), a.translation (), e));
+
+        //
+        // Two rotations about the same axis, through the same point,
+        // blend to the rotation halfway between them.
+        //
+
+        Vec3<T>     axis (0, 0, 1);
+        Vec3<T>     center (1, 2, 3);
+        DualQuat<T> toCenter (Quat<T> (), center);
+        DualQuat<T> fromCenter (Quat<T> (), -center);
+        DualQuat<T> r[2];
+        for (int k = 0; k < 2; ++k)
+        {
+            Quat<T> q;
+            q.setAxisAngle (axis, T (k ? 1.2 : 0.2));
+            r[k] = toCenter * DualQuat<T> (q, Vec3<T> (0)) * fromCenter;
+        }
+
+        T       half[] = {0.5, 0.5};
+        Quat<T> mid;
+        mid.setAxisAngle (axis, T (0.7));
+        DualQuat<T> expected =
+            toCenter * DualQuat<T> (mid, Vec3<T> (0)) * fromCenter;
+
+        Vec3<T> p (4, -1, 7);
+        assert (equalVec (
+            blend (r, half, 2).transformPoint (p),
+            expected.transformPoint (p),
+            e));
+    }
+
+    //
+    // skin() matches blend() and transformPoint(), and works in place.
+    //
+
+    {
+        const int    numBones = 20, influences = 4;
+        const size_t n = 1000;
+
+        vector<DualQuat<T>> bones (numBones);
+        for (int i = 0; i < numBones; ++i)
+            bones[i] = randomDualQuat<T> (random);
+
+        vector<uint32_t> indices (n * influences);
+        vector<T>        weights (n * influences);
+        vector<Vec3<T>>  positions (n), normals (n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            T sum = 0;
+            for (int k = 0; k < influences; ++k)
+            {
+                indices[i * influences + k] = random.nexti () % numBones;
+                weights[i * influences + k] =
+                    k == 3 && i % 2 ? T (0) : T (random.nextf (0, 1));
+                sum += weights[i * influences + k];
+            }
+            for (int k = 0; k < influences; ++k)
+                weights[i * influences + k] /= sum;
+
+            positions[i] = randomVec<T> (random, -10, 10);
+            normals[i]   = randomVec<T> (random, -1, 1).normalize ();
+        }
+
+        vector<Vec3<T>> sp (n), sn (n);
+        skin (
+            bones.data (),
+            indices.data (),
+            weights.data (),
+            influences,
+            positions.data (),
+            normals.data (),
+            sp.data (),
+            sn.data (),
+            n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            DualQuat<T> b[influences];
+            for (int k = 0; k < influences; ++k)
+                b[k] = bones[indices[i * influences + k]];
+
+            DualQuat<T> dq = blend (b, &weights[i * influences], influences);
+            assert (equalVec (sp[i], dq.transformPoint (positions[i]), e));
+            assert (equalVec (sn[i], dq.transformDirection (normals[i]), e));
+        }
+
+        vector<Vec3<T>> inPlace = positions;
+        skin (
+            bones.data (),
+            indices.data (),
+            weights.data (),
+            influences,
+            inPlace.data (),
+            inPlace.data (),
+            n);
+        assert (inPlace == sp);
+
+        //
+        // Without influences, the vertices are copied unchanged.
+        //
+
+        skin (
+            bones.data (),
+            indices.data (),
+            weights.data (),
+            0,
+            positions.data (),
+            normals.data (),
+            sp.data (),
+            sn.data (),
+            n);
+        assert (sp == positions && sn == normals);
+    }
+}
+
+} // namespace
+
+void
+testDualQuat ()
+{
+    cout << "Testing DualQuat" << endl;
+
+    testDualQuatType<float> ("float");
+    testDualQuatType<double> ("double");
+
+    cout << "ok\n" << endl;
+}
@@ -14,6 +14,7 @@
 #include <ImathRandom.h>
 #include <assert.h>
 #include <iostream>
+#include <vector>
 
 using namespace std;
 using namespace IMATH_INTERNAL_NAMESPACE;
@@ -48,6 +49,17 @@ matrixEulerMatrix_2 (const M44f& M, Eulerf::Order order)
     return f.toMatrix44 ();
 }
 
+M44f
+matrixEulerMatrix_3 (const M44f& M, Eulerf::Order order)
+{
+    Eulerf f (order);
+    extractEuler (&M, &f, 1);
+
+    M44f N;
+    toMatrix44 (&f, &N, 1);
+    return N;
+}
+
 void
 testMatrix (
     const M44f M,
@@ -200,6 +212,99 @@ testRandomAngles33 ()
     }
 }
 
+//
+// The array conversions match Euler's, for arrays that mix all orders.
+//
+
+template <class T>
+void
+testArrays ()
+{
+    typedef Euler<T> E;
+
+    const typename E::Order orders[] = {
+        E::XYZ,  E::XZY,  E::YZX,  E::YXZ,  E::ZXY,  E::ZYX,
+        E::XZX,  E::XYX,  E::YXY,  E::YZY,  E::ZYZ,  E::ZXZ,
+        E::XYZr, E::XZYr, E::YZXr, E::YXZr, E::ZXYr, E::ZYXr,
+        E::XZXr, E::XYXr, E::YXYr, E::YZYr, E::ZYZr, E::ZXZr};
+
+    const T   eps = 100 * std::numeric_limits<T>::epsilon ();
+    Rand48    r (1);
+    vector<E> e (2000);
+
+    for (int i = 0; i < 2000; ++i)
+    {
+        //
+        // Runs of varying length, including multiples of 90 degrees.
+        //
+
+        typename E::Order order = orders[(i / 7 + i % 3) % 24];
+        T                 a[3];
+        for (int k = 0; k < 3; ++k)
+            a[k] = i % 5 == 0 ? T (M_PI / 2 * int (r.nextf (-4, 4)))
+                              : T (r.nextf (-M_PI, M_PI));
+
+        e[i] = E (a[0], a[1], a[2], order);
+    }
+
+    size_t              n = e.size ();
+    vector<Matrix33<T>> m33 (n);
+    vector<Matrix44<T>> m44 (n);
+
+    toMatrix33 (e.data (), m33.data (), n);
+    toMatrix44 (e.data (), m44.data (), n);
+
+    //
+    // The results agree with the member functions to within rounding;
+    // the compiler may contract a multiply and an add into a fused
+    // multiply-add in one and not the other.
+    //
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert (m33[i].equalWithAbsError (e[i].toMatrix33 (), eps));
+        assert (m44[i].equalWithAbsError (e[i].toMatrix44 (), eps));
+    }
+
+    vector<E> x33 (n), x44 (n);
+    for (size_t i = 0; i < n; ++i)
+        x33[i] = x44[i] = E (e[i].order ());
+
+    extractEuler (m33.data (), x33.data (), n);
+    extractEuler (m44.data (), x44.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        E ref (e[i].order ());
+        ref.extract (m44[i]);
+
+        assert (x33[i].order () == e[i].order ());
+        assert (x44[i].order () == e[i].order ());
+        assert (x33[i].toMatrix44 ().equalWithAbsError (m44[i], eps));
+        assert (x44[i].toMatrix44 ().equalWithAbsError (
+            ref.toMatrix44 (), eps));
+        assert (x44[i].toMatrix44 ().equalWithAbsError (m44[i], eps));
+    }
+
+    //
+    // The approximations of the trig functions can be chosen
+    // explicitly, whether or not IMATH_USE_APPROX_TRIG is defined.
+    //
+
+    vector<Matrix44<T>> a44 (n);
+    toMatrix44<T, true> (e.data (), a44.data (), n);
+    extractEuler<T, true> (a44.data (), x44.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert (a44[i].equalWithAbsError (m44[i], eps));
+        assert (x44[i].toMatrix44 ().equalWithAbsError (m44[i], eps));
+    }
+
+    toMatrix44 (e.data (), m44.data (), 0);
+    extractEuler (m44.data (), x44.data (), 0);
+}
+
 } // namespace
 
 void
@@ -245,5 +350,15 @@ testExtractEuler ()
     test (matrixEulerMatrix_2, Eulerf::ZYZr);
     test (matrixEulerMatrix_2, Eulerf::ZXZr);
 
+    cout << "extractEuler() and toMatrix44() arrays" << endl;
+    test (matrixEulerMatrix_3, Eulerf::XYZ);
+    test (matrixEulerMatrix_3, Eulerf::ZXY);
+    test (matrixEulerMatrix_3, Eulerf::YZY);
+    test (matrixEulerMatrix_3, Eulerf::YXZr);
+    test (matrixEulerMatrix_3, Eulerf::ZXZr);
+
+    testArrays<float> ();
+    testArrays<double> ();
+
     cout << "ok\n" << endl;
 }
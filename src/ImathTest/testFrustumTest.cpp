@@ -11,15 +11,114 @@
 #include <ImathBox.h>
 #include <ImathFrustum.h>
 #include <ImathFrustumTest.h>
+#include <ImathRandom.h>
 #include <ImathSphere.h>
 #include <assert.h>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 // Include ImathForward *after* other headers to validate forward declarations
 #include <ImathForward.h>
 
 using namespace std;
 
+namespace
+{
+
+template <class T>
+void
+testBatchVisibility ()
+{
+    using namespace IMATH_INTERNAL_NAMESPACE;
+
+    Frustum<T>  frustum (T (1.7), T (567), T (-3.5), T (2), T (0.9), T (-1.3));
+    Matrix44<T> cameraMat;
+    cameraMat.setEulerAngles (Vec3<T> (T (0.3), T (-0.7), T (1.1)));
+    cameraMat.translate (Vec3<T> (T (100), T (200), T (300)));
+
+    FrustumTest<T> frustumTest (frustum, cameraMat);
+
+    //
+    // Random primitives scattered around the frustum, with a sprinkling
+    // of empty boxes and NaNs. Use an odd count so that the final
+    // block is partial.
+    //
+
+    Rand32               rand (17);
+    const size_t         n = 1003;
+    vector<Sphere3<T>>   spheres (n);
+    vector<Box<Vec3<T>>> boxes (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec3<T> c (
+            T (rand.nextf (-400, 400)),
+            T (rand.nextf (-400, 400)),
+            T (rand.nextf (-400, 400)));
+        c = c * cameraMat;
+
+        Vec3<T> e (
+            T (rand.nextf (0, 50)),
+            T (rand.nextf (0, 50)),
+            T (rand.nextf (0, 50)));
+
+        spheres[i] = Sphere3<T> (c, T (rand.nextf (0, 50)));
+        boxes[i]   = Box<Vec3<T>> (c - e, c + e);
+
+        if (i % 37 == 0) boxes[i].makeEmpty ();
+
+        if (i % 101 == 0)
+        {
+            spheres[i].radius = numeric_limits<T>::quiet_NaN ();
+            boxes[i].max.y    = numeric_limits<T>::quiet_NaN ();
+        }
+    }
+
+    for (size_t len = 0; len <= n; len += (len < 20 ? 1 : 97))
+    {
+        vector<uint8_t> mask (len + 1, 2);
+        vector<size_t>  indices (len + 1, n);
+
+        size_t numVisible =
+            frustumTest.isVisible (spheres.data (), len, mask.data ());
+        size_t numIndices =
+            frustumTest.visibleIndices (spheres.data (), len, indices.data ());
+
+        size_t expected = 0;
+        for (size_t i = 0; i < len; ++i)
+        {
+            bool visible = frustumTest.isVisible (spheres[i]);
+            assert (mask[i] == (visible ? 1 : 0));
+            if (visible) assert (indices[expected++] == i);
+        }
+        assert (mask[len] == 2);
+        assert (numVisible == expected);
+        assert (numIndices == expected);
+
+        mask.assign (len + 1, 2);
+        numVisible = frustumTest.isVisible (boxes.data (), len, mask.data ());
+        numIndices =
+            frustumTest.visibleIndices (boxes.data (), len, indices.data ());
+
+        expected = 0;
+        for (size_t i = 0; i < len; ++i)
+        {
+            bool visible = frustumTest.isVisible (boxes[i]);
+            assert (mask[i] == (visible ? 1 : 0));
+            if (visible) assert (indices[expected++] == i);
+        }
+        assert (mask[len] == 2);
+        assert (numVisible == expected);
+        assert (numIndices == expected);
+
+        // Both kinds of result should be non-trivial for the full set.
+        if (len == n) assert (expected > 0 && expected < n);
+    }
+}
+
+} // namespace
+
 void
 testFrustumTest ()
 {
@@ -142,5 +241,11 @@ testFrustumTest ()
         IMATH_INTERNAL_NAMESPACE::Sphere3<float> (outsideVec_up, tinyRadius)));
     cout << "passed Sphere\n";
 
+    /////////////////////////////////////////////////////
+    // Test arrays of Boxes and Spheres
+    testBatchVisibility<float> ();
+    testBatchVisibility<double> ();
+    cout << "passed arrays\n";
+
     cout << "\nok\n\n";
 }
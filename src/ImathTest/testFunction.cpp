@@ -10,7 +10,12 @@
 #include "testFunction.h"
 #include "halfFunction.h"
 #include <assert.h>
+#include <cmath>
 #include <iostream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
 
 using namespace std;
 
@@ -30,6 +35,162 @@ struct timesN
     float n;
 };
 
+float
+square (float x)
+{
+    return x * x;
+}
+
+//
+// An executor that runs the tasks in reverse order, to check that the
+// table does not depend on the order in which the chunks are filled.
+//
+
+void
+reverseExecutor (size_t n, const std::function<void (size_t)>& task)
+{
+    for (size_t i = n; i > 0; --i)
+        task (i - 1);
+}
+
+void
+testBatchAndShared ()
+{
+    cout << "halfFunction<T> batch evaluation and shared tables\n";
+
+    //
+    // Evaluating an array gives the same results as evaluating each
+    // value, for all half values and for every remainder of the length.
+    //
+
+    vector<half>  in (1 << 16);
+    vector<float> out (1 << 16);
+    vector<half>  hout (1 << 16);
+
+    for (int i = 0; i < (1 << 16); i++)
+        in[i].setBits (i);
+
+    halfFunction<float> sq (square, -100, 100, -1, 1, 2, 3);
+    halfFunction<half>  t3 (timesN (3));
+
+    t3 (in.data (), hout.data (), in.size ());
+
+    for (int i = 0; i < (1 << 16); i++)
+        assert (hout[i].bits () == t3 (in[i]).bits ());
+
+    //
+    // The library evaluates arrays of float with AVX2 gathers if the
+    // bulk conversion uses the AVX2 or AVX-512 kernels, and with a
+    // loop otherwise.
+    //
+
+    imath_half_conversion_impl_t best = imath_half_conversion_impl ();
+
+    const imath_half_conversion_impl_t impls[] = {
+        IMATH_HALF_CONVERSION_SCALAR, IMATH_HALF_CONVERSION_AVX2};
+
+    for (imath_half_conversion_impl_t impl: impls)
+    {
+        if (!imath_half_set_conversion_impl (impl)) continue;
+
+        sq (in.data (), out.data (), in.size ());
+
+        for (int i = 0; i < (1 << 16); i++)
+            assert (out[i] == sq (in[i]));
+
+        for (size_t n = 0; n < 20; n++)
+        {
+            vector<float> o (n + 1, 42);
+            sq (in.data () + 15360, o.data (), n);
+
+            for (size_t i = 0; i < n; i++)
+                assert (o[i] == sq (in[15360 + i]));
+
+            assert (o[n] == 42);
+        }
+    }
+
+    assert (imath_half_set_conversion_impl (best));
+
+    //
+    // A table built with an executor is the same as one built without.
+    //
+
+    halfFunction<float> psq (
+        square, -100, 100, -1, 1, 2, 3, reverseExecutor);
+
+    for (int i = 0; i < (1 << 16); i++)
+        assert (psq (in[i]) == sq (in[i]));
+
+    //
+    // Tables are shared for the same function, domain and special
+    // values, and not otherwise.
+    //
+
+    auto a = halfFunction<float>::shared (square, -100, 100, -1, 1, 2, 3);
+    auto b = halfFunction<float>::shared (
+        square, -100, 100, -1, 1, 2, 3, reverseExecutor);
+    auto c = halfFunction<float>::shared (square, -100, 100, -1, 1, 2, 4);
+    auto d = halfFunction<float>::shared (divideByTwo, -100, 100, -1, 1, 2, 3);
+    auto e = halfFunction<half>::shared (square, -100, 100, -1, 1, 2, 3);
+
+    assert (a == b);
+    assert (a != c && a != d);
+    assert ((*c) (half::qNan ()) == 4);
+    assert ((*d) (2) == 1);
+    assert ((*e) (3) == 9);
+
+    for (int i = 0; i < (1 << 16); i++)
+        assert ((*a) (in[i]) == sq (in[i]));
+
+    //
+    // 0 and -0 are different special values, and all NANs are the
+    // same.
+    //
+
+    float nan1 = std::numeric_limits<float>::quiet_NaN ();
+    float nan2 = -std::numeric_limits<float>::quiet_NaN ();
+
+    auto p = halfFunction<float>::shared (square, -100, 100, 0, 1, 2, nan1);
+    auto q = halfFunction<float>::shared (square, -100, 100, -0.0f, 1, 2, nan1);
+    auto r = halfFunction<float>::shared (square, -100, 100, 0, 1, 2, nan2);
+    auto s = halfFunction<half>::shared (square, -100, 100, 0, 1, 2, 0);
+    auto t = halfFunction<half>::shared (square, -100, 100, -0.0f, 1, 2, 0);
+
+    assert (p != q && p == r && s != t);
+    assert (!std::signbit ((*p) (-200)) && std::signbit ((*q) (-200)));
+    assert (std::signbit (float ((*t) (-200))));
+
+    //
+    // Functors without state are identified by their type.
+    //
+
+    auto cube = [] (float x) { return x * x * x; };
+    auto f    = halfFunction<float>::shared (cube);
+    auto g    = halfFunction<float>::shared (cube);
+    auto h    = halfFunction<float>::shared ([] (float x) { return -x; });
+
+    assert (f == g && f != h);
+    assert ((*f) (2) == 8 && (*h) (2) == -2);
+
+    //
+    // A table is freed once it is no longer used, and the next request
+    // builds it again.
+    //
+
+    std::weak_ptr<const halfFunction<float>> w = a;
+
+    a.reset ();
+    assert (!w.expired ());
+    b.reset ();
+    assert (w.expired ());
+
+    a = halfFunction<float>::shared (square, -100, 100, -1, 1, 2, 3);
+    assert ((*a) (3) == 9);
+
+    cout << "ok\n\n" << flush;
+}
+
 } // namespace
 
 void
@@ -72,4 +233,6 @@ testFunction ()
     assert (t5 (half::qNan ()).isNan ());
 
     cout << "ok\n\n" << flush;
+
+    testBatchAndShared ();
 }
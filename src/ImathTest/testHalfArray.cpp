@@ -0,0 +1,148 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+#ifdef NDEBUG
+#    undef NDEBUG
+#endif
+
+#include "testHalfArray.h"
+#include "half.h"
+#include <algorithm>
+#include <assert.h>
+#include <iostream>
+#include <string.h>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+
+uint32_t
+floatBits (float f)
+{
+    uint32_t i;
+    memcpy (&i, &f, sizeof (i));
+    return i;
+}
+
+float
+bitsFloat (uint32_t i)
+{
+    float f;
+    memcpy (&f, &i, sizeof (f));
+    return f;
+}
+
+void
+testHalfToFloatArray ()
+{
+    cout << "half to float array\n";
+
+    vector<uint16_t> h (1 << 16);
+    for (size_t i = 0; i < h.size (); ++i)
+        h[i] = static_cast<uint16_t> (i);
+
+    //
+    // Convert every half, starting at a few different offsets and
+    // with a few different lengths so the unaligned heads and the
+    // partial tails of the vector kernels are exercised.
+    //
+
+    vector<float> f (h.size ());
+
+    for (size_t offset = 0; offset < 20; offset += 3)
+    {
+        size_t n = h.size () - offset * 7;
+        fill (f.begin (), f.end (), 0.0f);
+        imath_half_to_float_array (h.data () + offset, f.data () + offset, n);
+
+        for (size_t i = offset; i < offset + n; ++i)
+            assert (floatBits (f[i]) == floatBits (imath_half_to_float (h[i])));
+    }
+
+    imath_half_to_float_array (h.data (), f.data (), 0);
+}
+
+void
+testFloatToHalfArray ()
+{
+    cout << "float to half array\n";
+
+    //
+    // A sparse sweep of all float bit patterns, which covers zeros,
+    // denormals, the half rounding boundaries, overflow, infinities
+    // and NaNs of both signs.
+    //
+
+    vector<float> f;
+    for (uint64_t i = 0; i <= 0xffffffffULL; i += 4093)
+        f.push_back (bitsFloat (static_cast<uint32_t> (i)));
+
+    for (uint32_t i = 0; i < (1 << 16); ++i)
+    {
+        uint32_t b = floatBits (imath_half_to_float (static_cast<uint16_t> (i)));
+        f.push_back (bitsFloat (b));
+        f.push_back (bitsFloat (b + 0x1000)); // halfway to the next half
+        f.push_back (bitsFloat (b + 0x1001));
+        f.push_back (bitsFloat (b - 0x1000));
+    }
+
+    vector<uint16_t> h (f.size () + 32);
+
+    for (size_t offset = 0; offset < 20; offset += 3)
+    {
+        size_t n = f.size () - offset * 7;
+        fill (h.begin (), h.end (), 0);
+        imath_float_to_half_array (f.data () + offset, h.data () + offset, n);
+
+        for (size_t i = offset; i < offset + n; ++i)
+            assert (h[i] == imath_float_to_half (f[i]));
+    }
+
+    imath_float_to_half_array (f.data (), h.data (), 0);
+}
+
+} // namespace
+
+void
+testHalfArray ()
+{
+    cout << "Testing bulk half conversion\n";
+
+    imath_half_conversion_impl_t best = imath_half_conversion_impl ();
+
+    //
+    // Every implementation the host supports must produce the same
+    // bits as the scalar conversion.
+    //
+
+    const imath_half_conversion_impl_t impls[] = {
+        IMATH_HALF_CONVERSION_SCALAR,
+        IMATH_HALF_CONVERSION_F16C,
+        IMATH_HALF_CONVERSION_AVX2,
+        IMATH_HALF_CONVERSION_AVX512};
+
+    for (imath_half_conversion_impl_t impl: impls)
+    {
+        if (!imath_half_set_conversion_impl (impl))
+        {
+            cout << "implementation " << impl << " not supported\n";
+            assert (imath_half_conversion_impl () != impl);
+            continue;
+        }
+
+        cout << "implementation " << impl << "\n";
+        assert (imath_half_conversion_impl () == impl);
+
+        testHalfToFloatArray ();
+        testFloatToHalfArray ();
+    }
+
+    assert (imath_half_set_conversion_impl (best));
+    assert (imath_half_conversion_impl () == best);
+
+    cout << "ok\n" << endl;
+}
@@ -0,0 +1,208 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+#ifdef NDEBUG
+#    undef NDEBUG
+#endif
+
+#include "testHalfCurve.h"
+#include "halfCurve.h"
+#include "halfFunction.h"
+#include <assert.h>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+
+namespace
+{
+
+float
+srgb (float x)
+{
+    return x <= 0.0031308f ? 12.92f * x : 1.055f * powf (x, 1 / 2.4f) - 0.055f;
+}
+
+float
+expf1 (float x)
+{
+    return expf (x);
+}
+
+float
+logf1 (float x)
+{
+    return logf (x);
+}
+
+//
+// Check that a curve agrees with the table of the same function to
+// within `tolerance`, or exactly where the table has a special value,
+// both for single values and arrays.
+//
+
+template <class T, class Function>
+void
+check (
+    Function f,
+    half     domainMin,
+    half     domainMax,
+    T        defaultValue,
+    T        posInfValue,
+    T        negInfValue,
+    T        nanValue,
+    double   tolerance,
+    int      maxTablePieces)
+{
+    halfFunction<T> table (
+        f,
+        domainMin,
+        domainMax,
+        defaultValue,
+        posInfValue,
+        negInfValue,
+        nanValue);
+
+    halfCurve<T> curve (
+        f,
+        domainMin,
+        domainMax,
+        defaultValue,
+        posInfValue,
+        negInfValue,
+        nanValue,
+        tolerance);
+
+    assert (curve.maxError () <= tolerance);
+    assert (curve.numTablePieces () <= maxTablePieces);
+
+    //
+    // Both are rounded to half, so they may differ by a half ulp.
+    //
+
+    double e = tolerance + (sizeof (T) == 2 ? 1.0 / 1024 : 0);
+
+    vector<half> in (1 << 16);
+    vector<T>    out (1 << 16);
+
+    for (int i = 0; i < (1 << 16); i++)
+        in[i].setBits (i);
+
+    for (int i = 0; i < (1 << 16); i++)
+    {
+        double a = double (table (in[i]));
+        double b = double (curve (in[i]));
+
+        if (std::isnan (a))
+            assert (std::isnan (b));
+        else if (std::isinf (a) || a == 0)
+            assert (a == b);
+        else
+            assert (std::fabs (a - b) <= e * std::fabs (a));
+    }
+
+    //
+    // The library evaluates arrays of float with AVX2 if the bulk
+    // conversion uses the AVX2 or AVX-512 kernels, and with a loop
+    // otherwise. The polynomials agree with those of single values to
+    // within rounding, since the compiler may contract a multiply and
+    // an add into a fused multiply-add in one and not the other.
+    //
+
+    const double r = 4 * std::numeric_limits<float>::epsilon ();
+
+    imath_half_conversion_impl_t best = imath_half_conversion_impl ();
+
+    const imath_half_conversion_impl_t impls[] = {
+        IMATH_HALF_CONVERSION_SCALAR, IMATH_HALF_CONVERSION_AVX2};
+
+    for (imath_half_conversion_impl_t impl: impls)
+    {
+        if (!imath_half_set_conversion_impl (impl)) continue;
+
+        curve (in.data (), out.data (), in.size ());
+
+        for (int i = 0; i < (1 << 16); i++)
+        {
+            double b = double (curve (in[i]));
+            double o = double (out[i]);
+
+            if (std::isnan (b))
+                assert (std::isnan (o));
+            else
+                assert (o == b || std::fabs (o - b) <= r * std::fabs (b));
+
+            //
+            // maxError() allows for that rounding, so the arrays are
+            // within it of the table too.
+            //
+
+            double a = double (table (in[i]));
+
+            if (std::isinf (a) || a == 0)
+                assert (a == o);
+            else if (!std::isnan (a))
+                assert (std::fabs (a - o) <= e * std::fabs (a));
+        }
+    }
+
+    assert (imath_half_set_conversion_impl (best));
+}
+
+} // namespace
+
+void
+testHalfCurve ()
+{
+    cout << "halfCurve<T>\n";
+
+    //
+    // Curves with a few zeros and domain ends need a few table pieces.
+    //
+
+    check<float> (srgb, 0, 1, 0, 1, 0, 0, 1e-5, 4);
+    check<half> (srgb, 0, 1, 0, 1, 0, 0, 1e-5, 4);
+
+    //
+    // exp() changes by a factor of e over the pieces above 8, which a
+    // cubic does not follow to 1e-5, so those are tables too.
+    //
+
+    check<float> (
+        expf1, -10, 10, 0, half::posInf (), 0, half::qNan (), 1e-5, 32);
+
+    check<float> (
+        logf1,
+        0,
+        HALF_MAX,
+        half::qNan (),
+        half::posInf (),
+        half::qNan (),
+        half::qNan (),
+        1e-5,
+        8);
+
+    check<half> (
+        [] (float x) { return 3 * x; },
+        -HALF_MAX,
+        HALF_MAX,
+        0,
+        half::posInf (),
+        half::negInf (),
+        half::qNan (),
+        1e-6,
+        8);
+
+    //
+    // A tolerance that no polynomial meets stores every piece that is
+    // not constant as a table, which reproduces the table exactly.
+    //
+
+    check<float> (srgb, 0, 1, 0, 1, 0, 0, 0, 512);
+
+    cout << "ok\n\n" << flush;
+}
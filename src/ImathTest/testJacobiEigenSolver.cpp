@@ -16,6 +16,7 @@
 #include <iostream>
 #include <limits>
 #include <math.h>
+#include <vector>
 
 using namespace std;
 using namespace IMATH_INTERNAL_NAMESPACE;
@@ -130,6 +131,49 @@ testJacobiEigenSolver (const TM& A)
             assert (abs (A[i][j] - MA[i][j]) < threshold);
 }
 
+template <class TM>
+void
+testJacobiEigenSolverBatch (const std::vector<TM>& A)
+{
+    using std::abs;
+
+    typedef typename TM::BaseType    T;
+    typedef typename TM::BaseVecType TV;
+
+    const size_t    n = A.size ();
+    std::vector<TV> S (n);
+    std::vector<TM> V (n);
+
+    jacobiEigenSolver (A.data (), S.data (), V.data (), n);
+
+    for (size_t m = 0; m < n; ++m)
+    {
+        const T threshold = computeThreshold (A[m]);
+
+        // Same eigenvalues as the single-matrix version
+        TM AA (A[m]);
+        TV s;
+        TM v;
+        jacobiEigenSolver (AA, s, v);
+
+        for (unsigned int i = 0; i < TM::dimensions (); ++i)
+            assert (abs (S[m][i] - s[i]) < threshold);
+
+        verifyOrthonormal (V[m], threshold);
+
+        // A = V * S * V^T
+        TM MS (T (0));
+        for (unsigned int i = 0; i < TM::dimensions (); ++i)
+            MS[i][i] = S[m][i];
+
+        TM MA = V[m] * MS * V[m].transposed ();
+
+        for (unsigned int i = 0; i < TM::dimensions (); ++i)
+            for (unsigned int j = 0; j < TM::dimensions (); ++j)
+                assert (abs (A[m][i][j] - MA[i][j]) < threshold);
+    }
+}
+
 template <class TM>
 void
 testMinMaxEigenValue (const TM& A)
@@ -254,6 +298,30 @@ testJacobiEigenSolverImp ()
     testJacobiEigenSolver (Matrix44<T> (A44_6));
     testJacobiEigenSolver (Matrix44<T> (A44_7));
     testJacobiEigenSolver (Matrix44<T> (A44_8));
+
+    std::vector<Matrix33<T>> A33;
+    A33.push_back (Matrix33<T> (A33_1));
+    A33.push_back (Matrix33<T> (A33_2));
+    A33.push_back (Matrix33<T> (A33_3));
+    A33.push_back (Matrix33<T> (A33_4));
+    A33.push_back (Matrix33<T> (A33_5));
+    A33.push_back (Matrix33<T> (A33_6));
+    A33.push_back (Matrix33<T> (A33_7));
+    A33.push_back (Matrix33<T> (A33_8));
+    A33.push_back (Matrix33<T> (A33_9));
+    testJacobiEigenSolverBatch (A33);
+
+    std::vector<Matrix44<T>> A44;
+    A44.push_back (Matrix44<T> (A44_1));
+    A44.push_back (Matrix44<T> (A44_2));
+    A44.push_back (Matrix44<T> (A44_3));
+    A44.push_back (Matrix44<T> (A44_4));
+    A44.push_back (Matrix44<T> (A44_5));
+    A44.push_back (Matrix44<T> (A44_6));
+    A44.push_back (Matrix44<T> (A44_7));
+    A44.push_back (Matrix44<T> (A44_8));
+    A44.push_back (Matrix44<T> (A44_9));
+    testJacobiEigenSolverBatch (A44);
 }
 
 template <class T>
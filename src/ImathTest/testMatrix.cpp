@@ -16,6 +16,7 @@
 #include <ImathVec.h>
 #include <assert.h>
 #include <iostream>
+#include <vector>
 
 // Include ImathForward *after* other headers to validate forward declarations
 #include <ImathForward.h>
@@ -33,6 +34,302 @@ using IMATH_INTERNAL_NAMESPACE::Int64;
 // or are more convenient to test from C++.
 //
 
+namespace
+{
+
+template <class T>
+bool
+equalVec (
+    const IMATH_INTERNAL_NAMESPACE::Vec3<T>& a,
+    const IMATH_INTERNAL_NAMESPACE::Vec3<T>& b)
+{
+    T e = std::numeric_limits<T>::epsilon () * 4;
+    return a.equalWithRelError (b, e);
+}
+
+//
+// Compare the array versions of multVecMatrix() and multDirMatrix()
+// with the single-vector versions, for a projective matrix and for
+// an affine one, which takes the path without the divide.
+//
+
+template <class T>
+void
+testArrayTransform ()
+{
+    using namespace IMATH_INTERNAL_NAMESPACE;
+
+    const size_t n = 1001;
+    Rand48       rand (17);
+
+    Matrix44<T> projective;
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            projective[i][j] = T (rand.nextf (-1, 1));
+    projective[3][3] = 4;
+
+    Matrix44<T> affine;
+    affine.rotate (Vec3<T> (T (0.1), T (0.2), T (0.3)));
+    affine.scale (Vec3<T> (T (1), T (2), T (3)));
+    affine.translate (Vec3<T> (T (4), T (5), T (6)));
+
+    const Matrix44<T> matrices[] = {projective, affine};
+
+    std::vector<Vec3<T>>  src (n), dst (n), inPlace (n);
+    std::vector<Vec3A<T>> srcA (n), dstA (n);
+    std::vector<T>        x (n), y (n), z (n), dx (n), dy (n), dz (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        src[i] = Vec3<T> (
+            T (rand.nextf (-10, 10)),
+            T (rand.nextf (-10, 10)),
+            T (rand.nextf (-10, 10)));
+        x[i]    = src[i].x;
+        y[i]    = src[i].y;
+        z[i]    = src[i].z;
+        srcA[i] = src[i];
+    }
+
+    for (const Matrix44<T>& m: matrices)
+    {
+        m.multVecMatrix (src.data (), dst.data (), n);
+        m.multVecMatrix (
+            x.data (),
+            y.data (),
+            z.data (),
+            dx.data (),
+            dy.data (),
+            dz.data (),
+            n);
+
+        inPlace = src;
+        m.multVecMatrix (inPlace.data (), inPlace.data (), n);
+
+        //
+        // The compiler may contract the arithmetic into fused
+        // multiply-adds differently in each version, so the results
+        // are compared to within rounding.
+        //
+
+        m.multVecMatrix (srcA.data (), dstA.data (), n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vec3<T> v;
+            m.multVecMatrix (src[i], v);
+            assert (equalVec (dst[i], v));
+            assert (equalVec (inPlace[i], v));
+            assert (equalVec (Vec3<T> (dx[i], dy[i], dz[i]), v));
+
+            Vec3A<T> a;
+            m.multVecMatrix (srcA[i], a);
+            assert (equalVec<T> (a, v) && equalVec<T> (dstA[i], v));
+            assert (equalVec<T> (srcA[i] * m, v));
+        }
+
+        dstA = srcA;
+        m.multVecMatrix (dstA.data (), dstA.data (), n);
+
+        for (size_t i = 0; i < n; ++i)
+            assert (equalVec<T> (dstA[i], src[i] * m));
+
+        m.multDirMatrix (src.data (), dst.data (), n);
+        m.multDirMatrix (
+            x.data (),
+            y.data (),
+            z.data (),
+            dx.data (),
+            dy.data (),
+            dz.data (),
+            n);
+
+        m.multDirMatrix (srcA.data (), dstA.data (), n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            Vec3<T> v;
+            m.multDirMatrix (src[i], v);
+            assert (equalVec (dst[i], v));
+            assert (equalVec (Vec3<T> (dx[i], dy[i], dz[i]), v));
+
+            Vec3A<T> a;
+            m.multDirMatrix (srcA[i], a);
+            assert (equalVec<T> (a, v) && equalVec<T> (dstA[i], v));
+        }
+    }
+
+    // an empty array is a no-op
+    affine.multVecMatrix (src.data (), dst.data (), 0);
+}
+
+//
+// Check the specialized inverses against gjInverse(), singly and over
+// arrays, in place and not.
+//
+
+template <class T>
+void
+testSpecializedInverse ()
+{
+    using namespace IMATH_INTERNAL_NAMESPACE;
+
+    const size_t n = 100;
+    Rand48       rand (23);
+    const T      e = std::numeric_limits<T>::epsilon () * 64;
+
+    std::vector<Matrix44<T>> rigid (n), affine (n), ortho (n), dst (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec3<T> r (
+            T (rand.nextf (-3, 3)),
+            T (rand.nextf (-3, 3)),
+            T (rand.nextf (-3, 3)));
+        Vec3<T> t (
+            T (rand.nextf (-10, 10)),
+            T (rand.nextf (-10, 10)),
+            T (rand.nextf (-10, 10)));
+        Vec3<T> s (
+            T (rand.nextf (0.5, 2)),
+            T (rand.nextf (0.5, 2)),
+            T (rand.nextf (0.5, 2)));
+
+        rigid[i].makeIdentity ();
+        rigid[i].translate (t);
+        rigid[i].rotate (r);
+
+        affine[i] = rigid[i];
+        affine[i].scale (s);
+        affine[i].shear (Vec3<T> (T (0.1), T (0.2), T (0.3)));
+
+        ortho[i].makeIdentity ();
+        ortho[i].rotate (r);
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert (rigid[i].inverseRigid ().equalWithAbsError (
+            rigid[i].gjInverse (), e));
+        assert (affine[i].inverseAffine ().equalWithAbsError (
+            affine[i].gjInverse (), e));
+        assert (affine[i].inverseAffine (true).equalWithAbsError (
+            affine[i].gjInverse (), e));
+        assert (ortho[i].inverseOrthonormal ().equalWithAbsError (
+            ortho[i].gjInverse (), e));
+    }
+
+    //
+    // The array versions call the member functions, but the compiler
+    // may contract them into fused multiply-adds differently when
+    // inlined into a loop, so they are compared to within rounding.
+    //
+
+    inverseRigid (rigid.data (), dst.data (), n);
+    for (size_t i = 0; i < n; ++i)
+        assert (dst[i].equalWithAbsError (rigid[i].inverseRigid (), e));
+
+    inverseAffine (affine.data (), dst.data (), n);
+    for (size_t i = 0; i < n; ++i)
+        assert (dst[i].equalWithAbsError (affine[i].inverseAffine (), e));
+
+    inverseOrthonormal (ortho.data (), dst.data (), n);
+    for (size_t i = 0; i < n; ++i)
+        assert (dst[i] == ortho[i].transposed ());
+
+    dst = rigid;
+    inverseRigid (dst.data (), dst.data (), n);
+    for (size_t i = 0; i < n; ++i)
+        assert (dst[i].equalWithAbsError (rigid[i].inverseRigid (), e));
+
+    dst = affine;
+    inverseAffine (dst.data (), dst.data (), n);
+    for (size_t i = 0; i < n; ++i)
+        assert (dst[i].equalWithAbsError (affine[i].inverseAffine (), e));
+
+    //
+    // A singular affine matrix gives the identity, or throws
+    //
+
+    Matrix44<T> singular;
+    singular.scale (Vec3<T> (1, 0, 1));
+    assert (singular.inverseAffine () == Matrix44<T> ());
+
+    try
+    {
+        singular.inverseAffine (true);
+        assert (false);
+    }
+    catch (const std::invalid_argument&)
+    {}
+}
+
+//
+// Compare matrix products with a plain loop that sums in the same
+// order, as the SIMD kernels enabled by IMATH_ENABLE_SIMD also do.
+//
+
+template <class M>
+M
+loopProduct (const M& a, const M& b)
+{
+    const int d = M::dimensions ();
+    M         c;
+
+    for (int i = 0; i < d; ++i)
+    {
+        for (int j = 0; j < d; ++j)
+        {
+            typename M::BaseType s = a[i][0] * b[0][j];
+            for (int k = 1; k < d; ++k)
+                s += a[i][k] * b[k][j];
+            c[i][j] = s;
+        }
+    }
+
+    return c;
+}
+
+template <class M>
+void
+testProduct ()
+{
+    using namespace IMATH_INTERNAL_NAMESPACE;
+    typedef typename M::BaseType T;
+
+    const int d = M::dimensions ();
+    const T   e = std::numeric_limits<T>::epsilon () * 8;
+    Rand48    rand (5);
+
+    for (int n = 0; n < 100; ++n)
+    {
+        M a, b;
+        for (int i = 0; i < d; ++i)
+        {
+            for (int j = 0; j < d; ++j)
+            {
+                a[i][j] = T (rand.nextf (-10, 10));
+                b[i][j] = T (rand.nextf (-10, 10));
+            }
+        }
+
+        const M p = loopProduct (a, b);
+
+        assert ((a * b).equalWithAbsError (p, e * 300));
+
+        M c = a;
+        c *= b;
+        assert (c.equalWithAbsError (p, e * 300));
+
+        // operands that alias the result
+        c = a;
+        c *= c;
+        assert (c.equalWithAbsError (loopProduct (a, a), e * 300));
+    }
+}
+
+} // namespace
+
 void
 testMatrix ()
 {
@@ -730,5 +1027,36 @@ testMatrix ()
         }
     }
 
+    {
+        cout << "M33 and M44 products" << endl;
+
+        testProduct<IMATH_INTERNAL_NAMESPACE::M33f> ();
+        testProduct<IMATH_INTERNAL_NAMESPACE::M33d> ();
+        testProduct<IMATH_INTERNAL_NAMESPACE::M44f> ();
+        testProduct<IMATH_INTERNAL_NAMESPACE::M44d> ();
+
+#if IMATH_CPLUSPLUS_VERSION >= 20
+        // the SIMD kernels must not get in the way of constant evaluation
+        constexpr IMATH_INTERNAL_NAMESPACE::M44f m (2);
+        constexpr IMATH_INTERNAL_NAMESPACE::M44f mm = m * m;
+        static_assert (mm[0][0] == 16, "constexpr M44f product");
+#endif
+    }
+
+    {
+        cout << "M44 multVecMatrix and multDirMatrix over arrays" << endl;
+
+        testArrayTransform<float> ();
+        testArrayTransform<double> ();
+    }
+
+    {
+        cout << "M44 inverseAffine, inverseRigid and inverseOrthonormal"
+             << endl;
+
+        testSpecializedInverse<float> ();
+        testSpecializedInverse<double> ();
+    }
+
     cout << "ok\n" << endl;
 }
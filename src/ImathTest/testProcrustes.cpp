@@ -288,6 +288,102 @@ testProcrustesWithMatrix (const IMATH_INTERNAL_NAMESPACE::M44d& m)
     std::cout << "OK\n";
 }
 
+// Verify that ProcrustesAccumulator, filled in one piece or in several
+// merged pieces, gives the same result as procrustesRotationAndTranslation.
+template <typename T>
+void
+testProcrustesAccumulator (const IMATH_INTERNAL_NAMESPACE::M44d& m)
+{
+    std::cout << "Testing ProcrustesAccumulator with matrix:\n" << m;
+    typedef IMATH_INTERNAL_NAMESPACE::Vec3<T> V3;
+
+    IMATH_INTERNAL_NAMESPACE::Rand48 random (7051);
+    const size_t                     numPoints = 1000;
+    std::vector<V3>                  from, to;
+    std::vector<T>                   weights;
+
+    // Put the points well away from the origin, where a one-pass
+    // computation of the moments would lose precision.
+    const IMATH_INTERNAL_NAMESPACE::V3d offset (1000, -2000, 500);
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+        const IMATH_INTERNAL_NAMESPACE::V3d a =
+            offset + IMATH_INTERNAL_NAMESPACE::V3d (
+                         random.nextf (), random.nextf (), random.nextf ());
+        const IMATH_INTERNAL_NAMESPACE::V3d b =
+            a * m + IMATH_INTERNAL_NAMESPACE::V3d (
+                        random.nextf (-0.01, 0.01),
+                        random.nextf (-0.01, 0.01),
+                        random.nextf (-0.01, 0.01));
+        from.push_back (V3 (a));
+        to.push_back (V3 (b));
+        weights.push_back (T (random.nextf (0, 2)));
+    }
+    weights[3] = 0;
+
+    const T eps = sizeof (T) == 8 ? T (1e-9) : T (1e-5);
+
+    for (int scale = 0; scale < 2; ++scale)
+    {
+        const IMATH_INTERNAL_NAMESPACE::M44d expected =
+            IMATH_INTERNAL_NAMESPACE::procrustesRotationAndTranslation (
+                &from[0], &to[0], &weights[0], numPoints, scale != 0);
+
+        IMATH_INTERNAL_NAMESPACE::ProcrustesAccumulator acc;
+        for (size_t i = 0; i < numPoints; ++i)
+            acc.add (from[i], to[i], weights[i]);
+        assert (acc.numPoints () == numPoints);
+
+        // Split the data in uneven parts, including an empty one, and
+        // merge them in a different order:
+        IMATH_INTERNAL_NAMESPACE::ProcrustesAccumulator part[4];
+        part[0].add (&from[0], &to[0], &weights[0], 10);
+        part[2].add (&from[10], &to[10], &weights[10], 600);
+        part[3].add (&from[610], &to[610], &weights[610], numPoints - 610);
+
+        IMATH_INTERNAL_NAMESPACE::ProcrustesAccumulator merged;
+        merged.merge (part[3]);
+        merged.merge (part[1]);
+        merged.merge (part[0]);
+        merged.merge (part[2]);
+        assert (merged.numPoints () == numPoints);
+
+        const IMATH_INTERNAL_NAMESPACE::M44d r1 = acc.solve (scale != 0);
+        const IMATH_INTERNAL_NAMESPACE::M44d r2 = merged.solve (scale != 0);
+
+        for (size_t i = 0; i < numPoints; ++i)
+        {
+            const IMATH_INTERNAL_NAMESPACE::V3d a  = from[i];
+            const IMATH_INTERNAL_NAMESPACE::V3d b  = a * expected;
+            assert ((a * r1 - b).length () < eps * b.length ());
+            assert ((a * r2 - b).length () < eps * b.length ());
+        }
+    }
+
+    // Unweighted points give the unweighted solution:
+    IMATH_INTERNAL_NAMESPACE::ProcrustesAccumulator acc;
+    acc.add (&from[0], &to[0], (const T*) 0, numPoints);
+    const IMATH_INTERNAL_NAMESPACE::M44d expected =
+        IMATH_INTERNAL_NAMESPACE::procrustesRotationAndTranslation (
+            &from[0], &to[0], numPoints, true);
+    const IMATH_INTERNAL_NAMESPACE::M44d r = acc.solve (true);
+    for (size_t i = 0; i < numPoints; ++i)
+    {
+        const IMATH_INTERNAL_NAMESPACE::V3d a = from[i];
+        const IMATH_INTERNAL_NAMESPACE::V3d b = a * expected;
+        assert ((a * r - b).length () < eps * b.length ());
+    }
+
+    // No points, or only points with zero weight, give the identity:
+    acc.clear ();
+    assert (acc.solve () == IMATH_INTERNAL_NAMESPACE::M44d ());
+    acc.add (from[0], to[0], T (0));
+    assert (acc.numPoints () == 1 && acc.weightsSum () == 0);
+    assert (acc.solve (true) == IMATH_INTERNAL_NAMESPACE::M44d ());
+
+    std::cout << "  OK\n";
+}
+
 template <typename T>
 void
 testProcrustesImp ()
@@ -409,6 +505,16 @@ testProcrustesImp ()
 
     m.scale (IMATH_INTERNAL_NAMESPACE::Vec3<T> (1, 1, 0));
     testProcrustesWithMatrix<T> (m);
+
+    m.makeIdentity ();
+    testProcrustesAccumulator<T> (m);
+
+    m = rot.toMatrix44 ();
+    m.translate (IMATH_INTERNAL_NAMESPACE::V3d (3.0, 5.0, -0.2));
+    testProcrustesAccumulator<T> (m);
+
+    m.scale (IMATH_INTERNAL_NAMESPACE::V3d (2.0, 2.0, 2.0));
+    testProcrustesAccumulator<T> (m);
 }
 
 void
@@ -12,9 +12,11 @@
 #include <ImathMatrixAlgo.h>
 #include <ImathPlatform.h>
 #include <ImathQuat.h>
+#include <ImathRandom.h>
 #include <cassert>
 #include <cmath>
 #include <iostream>
+#include <vector>
 
 // Include ImathForward *after* other headers to validate forward declarations
 #include <ImathForward.h>
@@ -221,6 +223,166 @@ testQuatT ()
     }
 }
 
+template <class T>
+Quat<T>
+randomQuat (Rand48& random)
+{
+    Quat<T> q (
+        T (random.nextf (-1, 1)),
+        T (random.nextf (-1, 1)),
+        T (random.nextf (-1, 1)),
+        T (random.nextf (-1, 1)));
+    return q.normalize ();
+}
+
+template <class T>
+bool
+equalQuat (const Quat<T>& a, const Quat<T>& b, T e)
+{
+    return equalWithAbsError (a.r, b.r, e) && a.v.equalWithAbsError (b.v, e);
+}
+
+template <class T>
+void
+testQuatArrays ()
+{
+    //
+    // Rotations, matrices that hit each case of extractQuat() exactly,
+    // and matrices that are not rotations at all: the array version
+    // must give exactly the same results as the single-matrix one. The
+    // count is not a multiple of the block size.
+    //
+
+    Rand48              random (3);
+    const size_t        n = 300;
+    vector<Matrix44<T>> m4 (n);
+    vector<Matrix33<T>> m3 (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (i % 3 == 2)
+        {
+            for (int j = 0; j < 4; ++j)
+                for (int k = 0; k < 4; ++k)
+                    m4[i][j][k] = T (random.nextf (-2, 2));
+        }
+        else
+            m4[i] = randomQuat<T> (random).toMatrix44 ();
+    }
+
+    m4[0] = Matrix44<T> ();
+    m4[1] = Matrix44<T> ().setAxisAngle (Vec3<T> (1, 0, 0), T (M_PI));
+    m4[2] = Matrix44<T> ().setAxisAngle (Vec3<T> (0, 1, 0), T (M_PI));
+    m4[3] = Matrix44<T> ().setAxisAngle (Vec3<T> (0, 0, 1), T (M_PI));
+    m4[4] = Matrix44<T> (Matrix33<T> (T (0)), Vec3<T> (0));
+    m4[5] = Matrix44<T> (Matrix33<T> (T (-1)), Vec3<T> (0));
+
+    for (size_t i = 0; i < n; ++i)
+        for (int j = 0; j < 3; ++j)
+            for (int k = 0; k < 3; ++k)
+                m3[i][j][k] = m4[i][j][k];
+
+    vector<Quat<T>> q4 (n), q3 (n);
+    extractQuat (m4.data (), q4.data (), n);
+    extractQuat (m3.data (), q3.data (), n);
+
+    //
+    // The batch results agree with the single-matrix ones to within
+    // rounding; they can differ in the last bit where the compiler
+    // contracts a multiply and an add into a fused multiply-add in one
+    // path and not the other.
+    //
+
+    const T r = T (4) * std::numeric_limits<T>::epsilon ();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert (equalQuat (q4[i], extractQuat (m4[i]), r));
+        assert (q3[i] == q4[i]);
+    }
+
+    vector<Matrix44<T>> r4 (n);
+    vector<Matrix33<T>> r3 (n);
+    toMatrix44 (q4.data (), r4.data (), n);
+    toMatrix33 (q4.data (), r3.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        assert (r4[i].equalWithAbsError (q4[i].toMatrix44 (), r));
+        assert (r3[i].equalWithAbsError (q4[i].toMatrix33 (), r));
+    }
+
+    //
+    // TRS records: the matrix is the product of the scale, rotation and
+    // translation matrices, and extractTRS() recovers the record, up to
+    // the sign of the quaternion. A negative scale on all three axes is
+    // recovered, and a zero scale stays zero.
+    //
+
+    const T        e = T (10) * std::numeric_limits<T>::epsilon ();
+    vector<TRS<T>> trs (n), out (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec3<T> s (
+            T (random.nextf (0.1, 10)),
+            T (random.nextf (0.1, 10)),
+            T (random.nextf (0.1, 10)));
+
+        if (i % 4 == 1) s = -s;
+        if (i % 7 == 3) s.y = 0;
+
+        trs[i] = TRS<T> (
+            randomQuat<T> (random),
+            Vec3<T> (
+                T (random.nextf (-100, 100)),
+                T (random.nextf (-100, 100)),
+                T (random.nextf (-100, 100))),
+            s);
+    }
+
+    toMatrix44 (trs.data (), m4.data (), n);
+    extractTRS (m4.data (), out.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const TRS<T>& x = trs[i];
+        Matrix44<T>   m = Matrix44<T> ().setScale (x.scale) *
+                        x.rotation.toMatrix44 () *
+                        Matrix44<T> ().setTranslation (x.translation);
+
+        assert (m4[i].equalWithAbsError (m, 10 * e));
+        assert (out[i].translation == x.translation);
+
+        if (x.scale.y == 0)
+        {
+            assert (out[i].scale.y == 0);
+            continue;
+        }
+
+        Quat<T> r = out[i].rotation;
+        if ((r ^ x.rotation) < 0) r = -r;
+
+        assert (out[i].scale.equalWithRelError (x.scale, e));
+        assert (equalQuat (r, x.rotation, e));
+    }
+
+    //
+    // A matrix with an odd number of negative scales is a rotation and
+    // a reflection; its decomposition still reproduces it.
+    //
+
+    Matrix44<T> mirror = Matrix44<T> ().setScale (Vec3<T> (2, -3, 4)) *
+                         randomQuat<T> (random).toMatrix44 ();
+    TRS<T>      x;
+    extractTRS (&mirror, &x, 1);
+    assert (x.scale.equalWithRelError (Vec3<T> (-2, -3, -4), e));
+
+    Matrix44<T> back;
+    toMatrix44 (&x, &back, 1);
+    assert (back.equalWithAbsError (mirror, 10 * e));
+}
+
 void
 testQuatConversions ()
 {
@@ -246,6 +408,8 @@ testQuat ()
 
     testQuatT<float> ();
     testQuatT<double> ();
+    testQuatArrays<float> ();
+    testQuatArrays<double> ();
     testQuatConversions ();
 
     cout << "ok\n" << endl;
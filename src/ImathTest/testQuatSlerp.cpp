@@ -13,6 +13,7 @@
 #include <assert.h>
 #include <iostream>
 #include <math.h>
+#include <vector>
 
 using namespace std;
 using namespace IMATH_INTERNAL_NAMESPACE;
@@ -153,6 +154,138 @@ randomRotations ()
     }
 }
 
+//
+// The angle of the rotation from the one represented by q1 to the one
+// represented by q2, computed in double precision.
+//
+
+template <class T>
+double
+rotationError (const Quat<T>& q1, const Quat<T>& q2)
+{
+    Quatd a (q1.r, q1.v.x, q1.v.y, q1.v.z);
+    Quatd b (q2.r, q2.v.x, q2.v.y, q2.v.z);
+
+    if ((a ^ b) < 0) b = -b;
+
+    return 2 * angle4D (a, b);
+}
+
+template <class T>
+void
+slerpKeysType (double maxError)
+{
+    Rand48 rand (17);
+
+    const size_t        n = 1000;
+    vector<SlerpKey<T>> keys (n), shortestArcKeys (n);
+    vector<T>           t (n);
+    vector<Quat<T>>     q1 (n), q2 (n), result (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        q1[i].setAxisAngle (
+            hollowSphereRand<Vec3<T>> (rand), T (rand.nextf (0, M_PI)));
+
+        //
+        // Some pairs far apart, some close together, some identical.
+        //
+
+        T angle = T (i % 3 ? rand.nextf (0, M_PI) : rand.nextf (0, 1e-3));
+        if (i % 37 == 0) angle = 0;
+
+        Quat<T> d;
+        d.setAxisAngle (hollowSphereRand<Vec3<T>> (rand), angle);
+        q2[i] = i % 2 ? q1[i] * d : -(q1[i] * d);
+
+        t[i]               = T (i % 11 ? rand.nextf () : (i % 2));
+        keys[i]            = SlerpKey<T> (q1[i], q2[i]);
+        shortestArcKeys[i] = SlerpKey<T> (q1[i], q2[i], true);
+    }
+
+    //
+    // The array version of slerp() gives identical results.
+    //
+
+    slerp (keys.data (), t.data (), result.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (result[i] == slerp (q1[i], q2[i], t[i]));
+
+    slerp (shortestArcKeys.data (), t.data (), result.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (result[i] == slerpShortestArc (q1[i], q2[i], t[i]));
+
+    //
+    // The approximations are within the documented error when
+    // interpolating along the shortest arc, and return unit
+    // quaternions.
+    //
+
+    slerpApprox (shortestArcKeys.data (), t.data (), result.data (), n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const SlerpKey<T>& k     = shortestArcKeys[i];
+        Quat<T>            exact = slerp (k.q1, k.q2, t[i]);
+
+        assert (rotationError (result[i], exact) <= maxError);
+        assert (equalWithAbsError (result[i].length (), T (1), T (1e-6)));
+
+        Quat<T> q = slerpApprox (k.q1, k.q2, t[i]);
+        assert (rotationError (q, exact) <= maxError);
+        assert (equalWithAbsError (q.length (), T (1), T (1e-6)));
+    }
+
+    //
+    // Away from opposite quaternions, the approximation also follows
+    // slerp() along the longer arc.
+    //
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (angle4D (q1[i], q2[i]) > 0.9 * M_PI) continue;
+
+        Quat<T> exact = slerp (q1[i], q2[i], t[i]);
+        assert (rotationError (slerpApprox (q1[i], q2[i], t[i]), exact) <=
+                10 * maxError);
+    }
+
+    //
+    // An empty array writes nothing.
+    //
+
+    vector<Quat<T>> before = result;
+    slerpApprox (keys.data (), t.data (), result.data (), 0);
+    assert (result == before);
+
+    //
+    // squadApprox() follows squad().
+    //
+
+    for (size_t i = 0; i + 3 < n; i += 4)
+    {
+        Quat<T> qa = intermediate (q1[i], q1[i + 1], q1[i + 2]);
+        Quat<T> qb = intermediate (q1[i + 1], q1[i + 2], q1[i + 3]);
+
+        if ((q1[i + 1] ^ q1[i + 2]) < 0.5 || (qa ^ qb) < 0.5) continue;
+
+        Quat<T> exact = squad (q1[i + 1], qa, qb, q1[i + 2], t[i]);
+        Quat<T> q     = squadApprox (q1[i + 1], qa, qb, q1[i + 2], t[i]);
+        assert (rotationError (q, exact) <= 3 * maxError);
+    }
+}
+
+void
+slerpKeys ()
+{
+    cout << "  slerp keys and approximations" << endl;
+
+    slerpKeysType<float> (4e-7);
+    slerpKeysType<double> (5e-9);
+}
+
 } // namespace
 
 void
@@ -162,6 +295,7 @@ testQuatSlerp ()
 
     specificRotations ();
     randomRotations ();
+    slerpKeys ();
 
     cout << "ok\n" << endl;
 }
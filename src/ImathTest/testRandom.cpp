@@ -12,8 +12,10 @@
 #include <ImathRandom.h>
 #include <ImathVec.h>
 #include <assert.h>
+#include <functional>
 #include <iomanip>
 #include <iostream>
+#include <vector>
 
 // Include ImathForward *after* other headers to validate forward declarations
 #include <ImathForward.h>
@@ -208,6 +210,97 @@ testHollowSphere ()
     }
 }
 
+//
+// An executor that runs the tasks in reverse order, to check that the
+// values do not depend on the order in which the tasks run.
+//
+
+void
+reverseExecutor (size_t n, const std::function<void (size_t)>& task)
+{
+    for (size_t i = n; i > 0; --i)
+        task (i - 1);
+}
+
+//
+// Check that skip() and fill() give the same values as calling nextf(),
+// and leave the generator in the same state.
+//
+
+template <class Rand, class T>
+void
+testSkipAndFill ()
+{
+    for (unsigned long long n: {0ULL, 1ULL, 7ULL, 8ULL, 1000ULL, 123457ULL})
+    {
+        Rand a (17);
+        Rand b (17);
+
+        for (unsigned long long i = 0; i < n; ++i)
+            a.nextf ();
+
+        b.skip (n);
+
+        for (int i = 0; i < 10; ++i)
+            assert (a.nexti () == b.nexti ());
+    }
+
+    for (size_t n: {0, 1, 7, 8, 9, 100, 40003})
+    {
+        Rand      a (3);
+        Rand      b (3);
+        Rand      c (3);
+        vector<T> d (n);
+        vector<T> e (n);
+
+        b.fill (d.data (), n);
+        c.fill (e.data (), n, reverseExecutor);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            //
+            // Float values from Rand48 are truncated to multiples of
+            // 2^-23.
+            //
+
+            double v = a.nextf ();
+            T      f = T (v);
+
+            if (sizeof (T) == 4) f = T (floor (v * 8388608) / 8388608);
+
+            assert (d[i] == f && e[i] == f);
+            assert (d[i] >= 0 && d[i] < 1);
+        }
+
+        for (int i = 0; i < 10; ++i)
+        {
+            long int x = long (a.nexti ());
+            assert (long (b.nexti ()) == x && long (c.nexti ()) == x);
+        }
+    }
+
+    //
+    // Substreams of a seed, skipped by multiples of a block size, are
+    // the blocks of the full sequence.
+    //
+
+    Rand      full (5);
+    vector<T> all (4000);
+    full.fill (all.data (), all.size ());
+
+    for (int block = 3; block >= 0; --block)
+    {
+        Rand      r (5);
+        vector<T> part (1000);
+
+        r.skip (block * 1000);
+        r.fill (part.data (), part.size ());
+
+        for (size_t i = 0; i < part.size (); ++i)
+            assert (part[i] == all[block * 1000 + i]);
+    }
+}
+
 } // namespace
 
 void
@@ -224,6 +317,22 @@ testRandom ()
     cout << "Rand48" << endl;
     testGenerator<IMATH_INTERNAL_NAMESPACE::Rand48> ();
 
+    cout << "skip() and fill()" << endl;
+    testSkipAndFill<IMATH_INTERNAL_NAMESPACE::Rand32, float> ();
+    testSkipAndFill<IMATH_INTERNAL_NAMESPACE::Rand48, double> ();
+    testSkipAndFill<IMATH_INTERNAL_NAMESPACE::Rand48, float> ();
+
+    {
+        IMATH_INTERNAL_NAMESPACE::Rand32 a (9);
+        IMATH_INTERNAL_NAMESPACE::Rand32 b (9);
+        vector<float>                    d (100);
+
+        b.fill (d.data (), d.size (), -2, 3);
+
+        for (size_t i = 0; i < d.size (); ++i)
+            assert (d[i] == a.nextf (-2, 3));
+    }
+
     cout << "solidSphereRand()" << endl;
     testSolidSphere<IMATH_INTERNAL_NAMESPACE::Rand32> ();
 
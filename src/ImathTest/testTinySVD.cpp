@@ -13,6 +13,7 @@
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <vector>
 
 template <typename T>
 void
@@ -160,6 +161,67 @@ verifyTinySVD_4x4 (const IMATH_INTERNAL_NAMESPACE::Matrix44<T>& A)
     }
 }
 
+// Compare the batch SVD of a set of matrices with the SVDs computed one at
+// a time.
+template <typename TM>
+void
+verifyTinySVDBatch (const std::vector<TM>& A)
+{
+    typedef typename TM::BaseType    T;
+    typedef typename TM::BaseVecType TV;
+
+    const int n = int (A.size ());
+    const T   eps = std::numeric_limits<T>::epsilon ();
+
+    for (int p = 0; p < 2; ++p)
+    {
+        const bool posDet = (p == 0);
+
+        std::vector<TM> U (n), V (n);
+        std::vector<TV> S (n);
+        IMATH_INTERNAL_NAMESPACE::jacobiSVD (
+            A.data (), U.data (), S.data (), V.data (), n, eps, posDet);
+
+        for (int m = 0; m < n; ++m)
+        {
+            T maxEntry = 0;
+            for (unsigned int i = 0; i < TM::dimensions (); ++i)
+                for (unsigned int j = 0; j < TM::dimensions (); ++j)
+                    maxEntry = std::max (maxEntry, std::abs (A[m][i][j]));
+
+            // Same tolerances as verifyTinySVD_3x3 and verifyTinySVD_4x4
+            const T valueEps =
+                maxEntry * T (TM::dimensions () == 3 ? 10 : 100) * eps;
+
+            TM u, v;
+            TV s;
+            IMATH_INTERNAL_NAMESPACE::jacobiSVD (A[m], u, s, v, eps, posDet);
+
+            for (unsigned int i = 0; i < TM::dimensions (); ++i)
+                assert (std::abs (S[m][i] - s[i]) <= valueEps);
+
+            TM S_times_Vt;
+            for (unsigned int i = 0; i < TM::dimensions (); ++i)
+                for (unsigned int j = 0; j < TM::dimensions (); ++j)
+                    S_times_Vt[j][i] = S[m][j] * V[m][i][j];
+
+            const TM product = U[m] * S_times_Vt;
+            for (unsigned int i = 0; i < TM::dimensions (); ++i)
+                for (unsigned int j = 0; j < TM::dimensions (); ++j)
+                    assert (std::abs (product[i][j] - A[m][i][j]) <= valueEps);
+
+            if (posDet)
+            {
+                assert (U[m].determinant () > 0.9);
+                assert (V[m].determinant () > 0.9);
+            }
+
+            verifyOrthonormal (U[m]);
+            verifyOrthonormal (V[m]);
+        }
+    }
+}
+
 template <typename T>
 void
 testTinySVD_3x3 (const IMATH_INTERNAL_NAMESPACE::Matrix33<T>& A)
@@ -172,6 +234,10 @@ testTinySVD_3x3 (const IMATH_INTERNAL_NAMESPACE::Matrix33<T>& A)
     verifyTinySVD_3x3 (A);
     verifyTinySVD_3x3 (A.transposed ());
 
+    std::vector<IMATH_INTERNAL_NAMESPACE::Matrix33<T>> batch;
+    batch.push_back (A);
+    batch.push_back (A.transposed ());
+
     // Try all different orderings of the columns of A:
     int cols[3] = {0, 1, 2};
     do
@@ -182,7 +248,10 @@ testTinySVD_3x3 (const IMATH_INTERNAL_NAMESPACE::Matrix33<T>& A)
                 B[i][j] = A[i][cols[j]];
 
         verifyTinySVD_3x3 (B);
+        batch.push_back (B);
     } while (std::next_permutation (cols, cols + 3));
+
+    verifyTinySVDBatch (batch);
 }
 
 template <typename T>
@@ -218,6 +287,10 @@ testTinySVD_4x4 (const IMATH_INTERNAL_NAMESPACE::Matrix44<T>& A)
     verifyTinySVD_4x4 (A);
     verifyTinySVD_4x4 (A.transposed ());
 
+    std::vector<IMATH_INTERNAL_NAMESPACE::Matrix44<T>> batch;
+    batch.push_back (A);
+    batch.push_back (A.transposed ());
+
     // Try all different orderings of the columns of A:
     int cols[4] = {0, 1, 2, 3};
     do
@@ -228,7 +301,10 @@ testTinySVD_4x4 (const IMATH_INTERNAL_NAMESPACE::Matrix44<T>& A)
                 B[i][j] = A[i][cols[j]];
 
         verifyTinySVD_4x4 (B);
+        batch.push_back (B);
     } while (std::next_permutation (cols, cols + 4));
+
+    verifyTinySVDBatch (batch);
 }
 
 template <typename T>
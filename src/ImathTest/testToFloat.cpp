@@ -132,6 +132,20 @@ testToFloat ()
         half::uif uif;
         uif.i = halfToFloat (s);
 
+        //
+        // The table-free conversion must reproduce the table bit
+        // for bit, NaN payloads included.
+        //
+
+        half::uif nt;
+        nt.f = imath_half_to_float_no_table (static_cast<uint16_t> (s));
+        assert (nt.i == uif.i);
+
+#ifndef __F16C__
+        nt.f = hs.toFloatNoTable ();
+        assert (nt.i == uif.i);
+#endif
+
         //
         // Equality operators fail for inf and nan, so handle them
         // specially.
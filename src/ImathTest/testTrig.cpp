@@ -0,0 +1,224 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+#ifdef NDEBUG
+#    undef NDEBUG
+#endif
+
+#include "testTrig.h"
+#include <ImathMath.h>
+#include <ImathRandom.h>
+#include <assert.h>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+using namespace IMATH_INTERNAL_NAMESPACE;
+
+namespace
+{
+
+//
+// The error of an approximation, in ulps of the exact result.
+//
+
+template <class T>
+double
+ulps (T approx, long double exact)
+{
+    T e = std::abs (T (exact));
+    T u = e == 0 ? std::numeric_limits<T>::denorm_min ()
+                 : std::nextafter (e, std::numeric_limits<T>::max ()) - e;
+    return double (std::abs (approx - exact) / u);
+}
+
+template <class T>
+void
+testSincos (Rand48& random, T ulpBound, T largeRange, T absBound)
+{
+    //
+    // sincos() is std::sin() and std::cos().
+    //
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        T x = T (random.nextf (-100, 100));
+        T s, c;
+        sincos (x, s, c);
+        assert (s == std::sin (x) && c == std::cos (x));
+    }
+
+    //
+    // Exact results at and near zero.
+    //
+
+    T s, c;
+    sincosApprox (T (0), s, c);
+    assert (s == 0 && c == 1);
+    sincosApprox (T (-0.0), s, c);
+    assert (s == 0 && c == 1);
+
+    T tiny = std::numeric_limits<T>::min ();
+    sincosApprox (tiny, s, c);
+    assert (s == tiny && c == 1);
+
+    //
+    // Outside the valid range, and for infinities and NaNs, the
+    // results are NaNs.
+    //
+
+    const T outside[] = {
+        T (1.71e9),
+        T (-1.71e9),
+        std::numeric_limits<T>::max (),
+        -std::numeric_limits<T>::infinity (),
+        std::numeric_limits<T>::quiet_NaN ()};
+
+    for (T x: outside)
+    {
+        sincosApprox (x, s, c);
+        assert (std::isnan (s) && std::isnan (c));
+    }
+
+    //
+    // The error bounds in the documentation. Every quadrant, and the
+    // points where the reduction switches quadrants, are covered.
+    //
+
+    double maxUlps = 0, maxAbs = 0;
+
+    for (int i = 0; i < 200000; ++i)
+    {
+        T x = i % 8 ? T (random.nextf (-M_PI, M_PI))
+                    : T (M_PI / 4 * (int (random.nextf (-8, 8)) | 1) +
+                         random.nextf (-1e-5, 1e-5));
+
+        sincosApprox (x, s, c);
+        long double lx = x;
+        maxUlps        = max (maxUlps, ulps (s, sinl (lx)));
+        maxUlps        = max (maxUlps, ulps (c, cosl (lx)));
+
+        x  = T (random.nextf (-largeRange, largeRange));
+        lx = x;
+        sincosApprox (x, s, c);
+        maxAbs = max (maxAbs, double (std::abs (s - sinl (lx))));
+        maxAbs = max (maxAbs, double (std::abs (c - cosl (lx))));
+    }
+
+    cout << "    sincosApprox: " << maxUlps << " ulp, " << maxAbs
+         << " absolute" << endl;
+
+    assert (maxUlps <= ulpBound);
+    assert (maxAbs <= absBound);
+}
+
+template <class T>
+void
+testAtan2 (Rand48& random, T ulpBound)
+{
+    //
+    // Zeros and the axes give the same results as std::atan2().
+    //
+
+    const T values[] = {0, T (-0.0), 1, -1, T (0.5), -3};
+
+    for (T y: values)
+        for (T x: values)
+        {
+            T a = atan2Approx (y, x);
+            T b = std::atan2 (y, x);
+            assert (std::signbit (a) == std::signbit (b));
+            assert (ulps (a, b) <= ulpBound);
+        }
+
+    double maxUlps = 0;
+
+    for (int i = 0; i < 200000; ++i)
+    {
+        T y = T (random.nextf (-10, 10));
+        T x = T (random.nextf (-10, 10));
+
+        //
+        // Points near the diagonals and the axes, and the reduction
+        // threshold in between.
+        //
+
+        if (i % 4 == 1)
+            x = std::copysign (y, x) * T (random.nextf (0.99, 1.01));
+        else if (i % 4 == 2)
+            x *= T (1e-4);
+        else if (i % 4 == 3)
+            x = y * T (random.nextf (0.4, 0.7));
+
+        T a     = atan2Approx (y, x);
+        maxUlps = max (maxUlps, ulps (a, atan2l (y, x)));
+    }
+
+    cout << "    atan2Approx: " << maxUlps << " ulp" << endl;
+
+    assert (maxUlps <= ulpBound);
+}
+
+//
+// A loop over arrays, as in the array rotation functions, gives the
+// same results as the scalar calls.
+//
+
+template <class T>
+void
+testArrays (Rand48& random)
+{
+    const size_t n = 1001;
+    vector<T>    x (n), y (n), s (n), c (n), a (n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        x[i] = T (random.nextf (-10, 10));
+        y[i] = T (random.nextf (-10, 10));
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        sincosApprox (x[i], s[i], c[i]);
+        a[i] = atan2Approx (y[i], x[i]);
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        T si, ci;
+        sincosApprox (x[i], si, ci);
+        assert (s[i] == si && c[i] == ci);
+        assert (a[i] == atan2Approx (y[i], x[i]));
+    }
+}
+
+template <class T>
+void
+testTrigType (
+    const char* type, T ulpBound, T largeRange, T absBound, T atanUlpBound)
+{
+    cout << "  " << type << endl;
+
+    Rand48 random (17);
+
+    testSincos (random, ulpBound, largeRange, absBound);
+    testAtan2 (random, atanUlpBound);
+    testArrays<T> (random);
+}
+
+} // namespace
+
+void
+testTrig ()
+{
+    cout << "Testing sincos and approximate trig functions" << endl;
+
+    testTrigType<float> ("float", 1.6f, 8192, 1e-7f, 2.9f);
+    testTrigType<double> ("double", 1.6, 1e6, 1e-15, 1.7);
+
+    cout << "ok\n" << endl;
+}
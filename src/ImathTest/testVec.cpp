@@ -12,6 +12,7 @@
 #include <ImathVec.h>
 #include <cassert>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 
 // Include ImathForward *after* other headers to validate forward declarations
@@ -248,6 +249,59 @@ testLength4T ()
     assert (IMATH_INTERNAL_NAMESPACE::equal (v.normalized ().length (), 1, e));
 }
 
+//
+// Vec3A is padded to four elements and aligned to their size, and
+// gives the same results as Vec3.
+//
+
+template <class T>
+void
+testVec3AT ()
+{
+    static_assert (sizeof (Vec3A<T>) == 4 * sizeof (T), "Vec3A size");
+    static_assert (alignof (Vec3A<T>) == 4 * sizeof (T), "Vec3A alignment");
+
+    const Vec3<T> u (T (1.5), T (-2), T (3.25));
+    const Vec3<T> v (T (-0.5), T (4), T (0.125));
+
+    Vec3A<T> a = u;
+    Vec3A<T> b (v.x, v.y, v.z);
+    Vec3<T>  w = a;
+
+    assert (w == u && a[0] == u.x && a[1] == u.y && a[2] == u.z);
+    assert (a == Vec3A<T> (u) && a != b);
+    assert (Vec3A<T> (T (2)) == Vec3<T> (T (2)));
+
+    assert (a.dot (b) == u.dot (v));
+    assert (a.cross (b) == u.cross (v));
+    assert (a + b == u + v && a - b == u - v && -a == -u);
+    assert (a * b == u * v && a / b == u / v);
+    assert (a * T (3) == u * T (3) && T (3) * a == T (3) * u);
+    assert (a / T (3) == u / T (3));
+    assert (a.length () == u.length () && a.length2 () == u.length2 ());
+    assert (a.normalized () == u.normalized ());
+
+    Vec3A<T> c = a;
+    c += b;
+    assert (c == u + v);
+    c -= b;
+    c *= b;
+    assert (c == u * v);
+    c /= b;
+    c *= T (2);
+    c /= T (2);
+    assert (c == (u * v / v * T (2) / T (2)));
+    c.normalize ();
+    assert (c == Vec3<T> (u * v / v * T (2) / T (2)).normalize ());
+
+    Vec3A<T> z (T (0));
+    z.normalize ();
+    assert (z == Vec3<T> (0));
+
+    Vec3A<T> arr[3];
+    assert (reinterpret_cast<uintptr_t> (&arr[1]) % alignof (Vec3A<T>) == 0);
+}
+
 } // namespace
 
 void
@@ -261,6 +315,8 @@ testVec ()
     testLength3T<double> ();
     testLength4T<float> ();
     testLength4T<double> ();
+    testVec3AT<float> ();
+    testVec3AT<double> ();
 
     cout << "ok\n" << endl;
 }
@@ -0,0 +1,322 @@
+//
+// SPDX-License-Identifier: BSD-3-Clause
+// Copyright Contributors to the OpenEXR Project.
+//
+
+#ifdef NDEBUG
+#    undef NDEBUG
+#endif
+
+#include "testVecArray.h"
+#include <ImathFun.h>
+#include <ImathRandom.h>
+#include <ImathVecArray.h>
+#include <assert.h>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+using namespace std;
+using namespace IMATH_INTERNAL_NAMESPACE;
+
+namespace
+{
+
+template <class A>
+bool
+aligned (const A& a)
+{
+    return reinterpret_cast<uintptr_t> (a.x ()) % A::alignment == 0 &&
+           reinterpret_cast<uintptr_t> (a.y ()) % A::alignment == 0;
+}
+
+//
+// Random vectors, including some null vectors and some so short
+// that their lengths are computed by lengthTiny().
+//
+
+template <class T>
+T
+randomComponent (Rand48& random, size_t i)
+{
+    if (i % 17 == 5) return T (0);
+
+    T v = T (random.nextf (-10, 10));
+
+    if (i % 13 == 7) v *= std::numeric_limits<T>::min ();
+
+    return v;
+}
+
+template <class V>
+vector<V>
+randomVecs (Rand48& random, size_t n)
+{
+    vector<V> v (n);
+
+    for (size_t i = 0; i < n; ++i)
+        for (unsigned int c = 0; c < V::dimensions (); ++c)
+            v[i][c] = randomComponent<typename V::BaseType> (random, i);
+
+    return v;
+}
+
+template <class V, class A>
+void
+testStorage (Rand48& random)
+{
+    const size_t n = 203;
+    vector<V>    v = randomVecs<V> (random, n);
+
+    A a (v.data (), n);
+    assert (a.size () == n && !a.empty () && a.capacity () >= n);
+    assert (aligned (a));
+
+    for (size_t i = 0; i < n; ++i)
+        assert (a[i] == v[i]);
+
+    vector<V> w (n);
+    a.copyTo (w.data ());
+    assert (w == v);
+
+    //
+    // Resizing keeps the contents and zeroes new elements.
+    //
+
+    a.resize (1000);
+    assert (a.size () == 1000 && aligned (a));
+
+    for (size_t i = 0; i < n; ++i)
+        assert (a[i] == v[i]);
+
+    for (size_t i = n; i < 1000; ++i)
+        assert (a[i] == V (0));
+
+    a.resize (10);
+    a.resize (20);
+
+    for (size_t i = 10; i < 20; ++i)
+        assert (a[i] == V (0));
+
+    a.set (3, V (1));
+    assert (a[3] == V (1));
+
+    //
+    // Copy, move and swap
+    //
+
+    A b (v.data (), n);
+    A c (b);
+    assert (c.size () == n && aligned (c));
+
+    for (size_t i = 0; i < n; ++i)
+        assert (c[i] == v[i]);
+
+    A d (static_cast<A&&> (c));
+    assert (d.size () == n && c.size () == 0 && c.empty ());
+    assert (d[n - 1] == v[n - 1]);
+
+    c = d;
+    assert (c.size () == n && c[0] == v[0]);
+
+    a.swap (d);
+    assert (a.size () == n && d.size () == 20 && a[1] == v[1]);
+
+    A e (5);
+    assert (e.size () == 5 && e[4] == V (0));
+
+    A f;
+    assert (f.empty () && f.capacity () == 0);
+    f = e;
+    assert (f.size () == 5);
+}
+
+//
+// The batch operations agree with the corresponding operations on
+// single vectors to within rounding; they can differ in the last bit
+// where the compiler contracts a multiply and an add into a fused
+// multiply-add in one and not the other. The components are at most
+// 10 and the matrix entries at most 2, so an absolute tolerance does.
+//
+
+template <class T>
+T
+tolerance ()
+{
+    return 1000 * std::numeric_limits<T>::epsilon ();
+}
+
+template <class V, class A>
+void
+testOps (Rand48& random)
+{
+    typedef typename V::BaseType T;
+
+    const T e = tolerance<T> ();
+
+    const size_t n = 203;
+    vector<V>    va = randomVecs<V> (random, n);
+    vector<V>    vb = randomVecs<V> (random, n);
+
+    A a (va.data (), n);
+    A b (vb.data (), n);
+
+    vector<T> r (n);
+
+    dot (a, b, r.data ());
+
+    for (size_t i = 0; i < n; ++i)
+        assert (equalWithAbsError (r[i], va[i].dot (vb[i]), e));
+
+    length (a, r.data ());
+
+    for (size_t i = 0; i < n; ++i)
+        assert (equalWithAbsError (r[i], va[i].length (), e));
+
+    A c;
+    lerp (a, b, T (0.3), c);
+    assert (c.size () == n);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (c[i].equalWithAbsError (lerp (va[i], vb[i], T (0.3)), e));
+
+    A d (a);
+    lerp (d, b, T (0.3), d);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (d[i] == c[i]);
+
+    normalize (a);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (a[i].equalWithAbsError (va[i].normalized (), e));
+}
+
+template <class T>
+void
+testCross (Rand48& random)
+{
+    const size_t    n = 203;
+    vector<Vec3<T>> va = randomVecs<Vec3<T>> (random, n);
+    vector<Vec3<T>> vb = randomVecs<Vec3<T>> (random, n);
+
+    Vec3Array<T> a (va.data (), n);
+    Vec3Array<T> b (vb.data (), n);
+    Vec3Array<T> c;
+    const T      e = tolerance<T> ();
+
+    cross (a, b, c);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (c[i].equalWithAbsError (va[i].cross (vb[i]), e));
+
+    cross (a, b, b);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (b[i] == c[i]);
+}
+
+template <class T>
+void
+testTransforms (Rand48& random)
+{
+    const size_t n = 203;
+    const T      e = tolerance<T> ();
+
+    Matrix33<T> m33;
+    Matrix44<T> m44;
+
+    for (int i = 0; i < 3; ++i)
+        for (int j = 0; j < 3; ++j)
+            m33[i][j] = T (random.nextf (-2, 2));
+
+    for (int i = 0; i < 4; ++i)
+        for (int j = 0; j < 4; ++j)
+            m44[i][j] = T (random.nextf (-2, 2));
+
+    vector<Vec2<T>> v2 = randomVecs<Vec2<T>> (random, n);
+    vector<Vec3<T>> v3 = randomVecs<Vec3<T>> (random, n);
+    vector<Vec4<T>> v4 = randomVecs<Vec4<T>> (random, n);
+
+    Vec2Array<T> a2 (v2.data (), n), b2, c2 (a2);
+    Vec3Array<T> a3 (v3.data (), n), b3, c3 (a3);
+    Vec4Array<T> a4 (v4.data (), n), b4;
+
+    multVecMatrix (m33, a2, b2);
+    multVecMatrix (m33, c2, c2);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec2<T> p;
+        m33.multVecMatrix (v2[i], p);
+        assert (b2[i].equalWithAbsError (p, e) && c2[i] == b2[i]);
+    }
+
+    multDirMatrix (m33, a2, b2);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec2<T> p;
+        m33.multDirMatrix (v2[i], p);
+        assert (b2[i].equalWithAbsError (p, e));
+    }
+
+    multVecMatrix (m44, a3, b3);
+    multVecMatrix (m44, c3, c3);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec3<T> p;
+        m44.multVecMatrix (v3[i], p);
+        assert (b3[i].equalWithAbsError (p, e) && c3[i] == b3[i]);
+    }
+
+    multDirMatrix (m44, a3, b3);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vec3<T> p;
+        m44.multDirMatrix (v3[i], p);
+        assert (b3[i].equalWithAbsError (p, e));
+    }
+
+    multVecMatrix (m44, a4, b4);
+    multVecMatrix (m44, a4, a4);
+
+    for (size_t i = 0; i < n; ++i)
+        assert (b4[i].equalWithAbsError (v4[i] * m44, e) && a4[i] == b4[i]);
+}
+
+template <class T>
+void
+testVecArrayType (const char* type)
+{
+    cout << "  " << type << endl;
+
+    Rand48 random (5);
+
+    testStorage<Vec2<T>, Vec2Array<T>> (random);
+    testStorage<Vec3<T>, Vec3Array<T>> (random);
+    testStorage<Vec4<T>, Vec4Array<T>> (random);
+
+    testOps<Vec2<T>, Vec2Array<T>> (random);
+    testOps<Vec3<T>, Vec3Array<T>> (random);
+    testOps<Vec4<T>, Vec4Array<T>> (random);
+
+    testCross<T> (random);
+    testTransforms<T> (random);
+}
+
+} // namespace
+
+void
+testVecArray ()
+{
+    cout << "Testing structure-of-arrays vector arrays" << endl;
+
+    testVecArrayType<float> ("float");
+    testVecArrayType<double> ("double");
+
+    cout << "ok\n" << endl;
+}